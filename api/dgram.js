@@ -16,7 +16,7 @@ import { InternalError } from './errors.js'
 import { EventEmitter } from './events.js'
 import diagnostics from './diagnostics.js'
 import { Buffer } from './buffer.js'
-import { isIPv4 } from './ip.js'
+import { isIP } from './ip.js'
 import process from './process.js'
 import console from './console.js'
 import ipc from './ipc.js'
@@ -69,23 +69,84 @@ function createDataListener (socket) {
 
     if (!data || BigInt(data.id) !== socket.id) return
 
-    if (source === 'udp.readStart') {
-      const message = Buffer.from(buffer)
-      const info = {
-        ...data,
-        family: getAddressFamily(data.address)
-      }
+    if (source === 'udp.send' && data.event === 'drain') {
+      socket.state.sendQueueSize = data.queueSize
+      socket.state.sendQueueCount = data.queueCount
+      socket.emit('drain')
+    }
 
-      socket.emit('message', message, info)
-      dc.channel('message').publish({ socket, buffer: message, info })
+    if (source === 'udp.readStart' && buffer) {
+      for (const { message, info } of readDatagramBatch(buffer)) {
+        info.id = data.id
+        socket.emit('message', message, info)
+        dc.channel('message').publish({ socket, buffer: message, info })
+      }
     }
 
     if (data.EOF) {
       globalThis.removeEventListener('data', ondata)
+
+      if (socket.dataListener === ondata) {
+        delete socket.dataListener
+      }
     }
   }
 }
 
+/**
+ * Decodes a batch of datagrams framed by `udp.readStart`. Each datagram is
+ * a big endian `uint16` port, a `uint8` address length, the address, a big
+ * endian `uint32` size and the payload. Messages are views into the batch.
+ * @ignore
+ * @param {ArrayBuffer|Uint8Array} buffer
+ * @return {Array<{ message: Buffer, info: object }>}
+ */
+function readDatagramBatch (buffer) {
+  const bytes = Buffer.from(buffer)
+  const datagrams = []
+  let offset = 0
+
+  while (offset + 7 <= bytes.length) {
+    const port = bytes.readUInt16BE(offset)
+    const addressLength = bytes[offset + 2]
+    offset += 3
+
+    const address = bytes.toString('latin1', offset, offset + addressLength)
+    offset += addressLength
+
+    const size = bytes.readUInt32BE(offset)
+    offset += 4
+
+    const message = bytes.slice(offset, offset + size)
+    offset += size
+
+    datagrams.push({
+      message,
+      info: {
+        address,
+        port,
+        bytes: String(size),
+        family: getAddressFamily(address)
+      }
+    })
+  }
+
+  return datagrams
+}
+
+/**
+ * Subscribes `socket` to the data firehose if it is not already. Sockets
+ * that only send, without `bind()`, subscribe on their first send so they
+ * receive 'drain' events.
+ * @ignore
+ * @param {Socket} socket
+ */
+function ensureDataListener (socket) {
+  if (typeof socket.dataListener !== 'function') {
+    socket.dataListener = createDataListener(socket)
+  }
+}
+
 function destroyDataListener (socket) {
   if (typeof socket?.dataListener === 'function') {
     globalThis.removeEventListener('data', socket.dataListener)
@@ -118,8 +179,19 @@ function getDefaultAddress (socket) {
   return null
 }
 
+function getBindAddress (socket) {
+  if (socket.type === 'udp6') return '::'
+  if (socket.type === 'udp4') return '0.0.0.0'
+
+  return null
+}
+
+function getLookupFamily (socket) {
+  return socket.type === 'udp6' ? 6 : 4
+}
+
 function getAddressFamily (address) {
-  return isIPv4(address) ? 'IPv4' : 'IPv6'
+  return isIP(address) === 6 ? 'IPv6' : 'IPv4'
 }
 
 function getSocketState (socket) {
@@ -145,9 +217,14 @@ async function startReading (socket, callback) {
   }
 
   try {
-    result = await ipc.send('udp.readStart', {
-      id: socket.id
-    })
+    const params = { id: socket.id }
+
+    // coalesced reads are split back into datagrams by the runtime
+    if (socket.state.gro) {
+      params.gro = true
+    }
+
+    result = await ipc.send('udp.readStart', params)
 
     callback(result.err, result.data)
   } catch (err) {
@@ -231,14 +308,14 @@ async function bind (socket, options, callback) {
   }
 
   if (typeof options.address !== 'string') {
-    options.address = getDefaultAddress(socket)
+    options.address = getBindAddress(socket)
   }
 
   socket.state.bindState = BIND_STATE_BINDING
 
-  if (typeof options.address === 'string' && !isIPv4(options.address)) {
+  if (typeof options.address === 'string' && !isIP(options.address)) {
     try {
-      options.address = await dns.lookup(options.address, 4)
+      options.address = await dns.lookup(options.address, getLookupFamily(socket))
     } catch (err) {
       socket.state.bindState = BIND_STATE_UNBOUND
       callback(err)
@@ -314,9 +391,9 @@ async function connect (socket, options, callback) {
 
   socket.state.connectState = CONNECT_STATE_CONNECTING
 
-  if (typeof options.address === 'string' && !isIPv4(options.address)) {
+  if (typeof options.address === 'string' && !isIP(options.address)) {
     try {
-      options.address = await dns.lookup(options.address, 4)
+      options.address = await dns.lookup(options.address, getLookupFamily(socket))
     } catch (err) {
       socket.state.connectState = CONNECT_STATE_DISCONNECTED
       callback(err)
@@ -409,15 +486,14 @@ function disconnect (socket, callback) {
   return result
 }
 
-async function send (socket, options, callback) {
-  let result = null
-
-  if (!isFunction(callback)) {
-    callback = noop
-  }
-
-  options = { ...options }
-
+/**
+ * Waits for a pending bind or connect to finish, binding the socket to a
+ * random port first if it is neither bound nor connected.
+ * @ignore
+ * @param {Socket} socket
+ * @return {Promise<{ err?: Error }>}
+ */
+async function waitForSendReady (socket) {
   if (socket.state.connectState === CONNECT_STATE_DISCONNECTED) {
     // wait for bind to finish
     if (socket.state.bindState === BIND_STATE_BINDING) {
@@ -427,13 +503,11 @@ async function send (socket, options, callback) {
       })
 
       if (err) {
-        callback(err)
         return { err }
       }
     } else if (socket.state.bindState === BIND_STATE_UNBOUND) {
       const { err } = await bind(socket, { port: 0 })
       if (err) {
-        callback(err)
         return { err }
       }
     }
@@ -447,18 +521,36 @@ async function send (socket, options, callback) {
     })
 
     if (err) {
-      callback(err)
       return { err }
     }
   }
 
+  return {}
+}
+
+async function send (socket, options, callback) {
+  let result = null
+
+  if (!isFunction(callback)) {
+    callback = noop
+  }
+
+  options = { ...options }
+
+  const { err } = await waitForSendReady(socket)
+
+  if (err) {
+    callback(err)
+    return { err }
+  }
+
   if (
-    !isIPv4(options.address) &&
+    !isIP(options.address) &&
     typeof options.address === 'string' &&
     socket.state.connectState !== CONNECT_STATE_CONNECTED
   ) {
     try {
-      options.address = await dns.lookup(options.address, 4)
+      options.address = await dns.lookup(options.address, getLookupFamily(socket))
     } catch (err) {
       callback(err)
       return { err }
@@ -501,11 +593,28 @@ async function send (socket, options, callback) {
       address: options.address
     })
 
-    result = await ipc.write('udp.send', {
+    const params = {
       id: socket.id,
       port: options.port,
       address: options.address
-    }, options.buffer)
+    }
+
+    // larger buffers are sent as many datagrams of `segmentSize` bytes
+    if (socket.state.segmentSize > 0) {
+      params.segmentSize = socket.state.segmentSize
+    }
+
+    if (socket.state.sendHighWaterMark > 0) {
+      params.highWaterMark = socket.state.sendHighWaterMark
+    }
+
+    ensureDataListener(socket)
+    result = await ipc.write('udp.send', params, options.buffer)
+
+    if (result.data) {
+      socket.state.sendQueueSize = result.data.queueSize
+      socket.state.sendQueueCount = result.data.queueCount
+    }
 
     callback(result.err, result.data)
   } catch (err) {
@@ -530,6 +639,120 @@ async function send (socket, options, callback) {
   return result
 }
 
+/**
+ * Frames `datagrams` for `udp.sendMany`. Each destination is a big endian
+ * `uint16` port, a `uint8` address length and the address, followed by a
+ * big endian `uint32` size and the payload unless `shared` is given, in
+ * which case `shared` is written once at the start of the frame.
+ * @ignore
+ * @param {Array<{ port: number, address: string, buffer?: Buffer }>} datagrams
+ * @param {Buffer=} [shared]
+ * @return {Buffer}
+ */
+function frameDatagrams (datagrams, shared) {
+  const addresses = datagrams.map((datagram) => Buffer.from(datagram.address))
+  let length = shared ? 4 + shared.length : 0
+
+  for (let i = 0; i < datagrams.length; ++i) {
+    length += 3 + addresses[i].length
+    if (!shared) {
+      length += 4 + datagrams[i].buffer.length
+    }
+  }
+
+  const frame = Buffer.alloc(length)
+  let offset = 0
+
+  if (shared) {
+    offset = frame.writeUInt32BE(shared.length, offset)
+    offset += shared.copy(frame, offset)
+  }
+
+  for (let i = 0; i < datagrams.length; ++i) {
+    offset = frame.writeUInt16BE(datagrams[i].port, offset)
+    offset = frame.writeUInt8(addresses[i].length, offset)
+    offset += addresses[i].copy(frame, offset)
+
+    if (!shared) {
+      const { buffer } = datagrams[i]
+      offset = frame.writeUInt32BE(buffer.length, offset)
+      offset += buffer.copy(frame, offset)
+    }
+  }
+
+  return frame
+}
+
+async function sendMany (socket, options, callback) {
+  let result = null
+
+  if (!isFunction(callback)) {
+    callback = noop
+  }
+
+  const { err } = await waitForSendReady(socket)
+
+  if (err) {
+    callback(err)
+    return { err }
+  }
+
+  const connected = socket.state.connectState === CONNECT_STATE_CONNECTED
+  const datagrams = []
+
+  for (const datagram of options.datagrams) {
+    let { address, port } = datagram
+
+    if (connected) {
+      const remote = socket.remoteAddress()
+      address = remote.address
+      port = remote.port
+    } else if (!address) {
+      address = getDefaultAddress(socket)
+    } else if (!isIP(address)) {
+      try {
+        address = await dns.lookup(address, getLookupFamily(socket))
+      } catch (err) {
+        callback(err)
+        return { err }
+      }
+    }
+
+    datagrams.push({ ...datagram, address, port })
+  }
+
+  try {
+    const params = { id: socket.id }
+
+    if (options.shared) {
+      params.shared = true
+    }
+
+    ensureDataListener(socket)
+    result = await ipc.write(
+      'udp.sendMany',
+      params,
+      frameDatagrams(datagrams, options.shared)
+    )
+
+    callback(result.err, result.data)
+  } catch (err) {
+    callback(err)
+    return { err }
+  }
+
+  for (const datagram of datagrams) {
+    dc.channel('send').publish({
+      socket,
+      port: datagram.port,
+      buffer: options.shared || datagram.buffer,
+      address: datagram.address
+    })
+  }
+
+  return result
+}
+
 async function close (socket, callback) {
   let result = null
 
@@ -604,6 +827,39 @@ function getSockName (socket, callback) {
   return result
 }
 
+function setSocketOptions (socket, options) {
+  const result = ipc.sendSync('udp.setOptions', {
+    ...options,
+    id: socket.id
+  })
+
+  if (result.err) {
+    throw Object.assign(result.err, {
+      syscall: 'setsockopt'
+    })
+  }
+
+  return result.data
+}
+
+function setMembership (socket, membership, multicastAddress, multicastInterface, sourceAddress) {
+  if (typeof multicastAddress !== 'string') {
+    throw new TypeError(`Expecting 'multicastAddress' to be a string. Received: ${typeof multicastAddress}`)
+  }
+
+  const options = { membership, multicastAddress }
+
+  if (multicastInterface) {
+    options.interfaceAddress = multicastInterface
+  }
+
+  if (sourceAddress) {
+    options.sourceAddress = sourceAddress
+  }
+
+  setSocketOptions(socket, options)
+}
+
 /**
  * @typedef {Object} SocketOptions
  */
@@ -613,7 +869,10 @@ function getSockName (socket, callback) {
  * @param {string|Object} options - either a string ('udp4' or 'udp6') or an options object
  * @param {string=} options.type - The family of socket. Must be either 'udp4' or 'udp6'. Required.
  * @param {boolean=} [options.reuseAddr=false] - When true socket.bind() will reuse the address, even if another process has already bound a socket on it. Default: false.
- * @param {boolean=} [options.ipv6Only=false] - Default: false.
+ * @param {boolean=} [options.ipv6Only=false] - Setting ipv6Only to true will disable dual-stack support, i.e., binding to address :: won't make 0.0.0.0 be bound. Default: false.
+ * @param {number=} [options.segmentSize=0] - When greater than 0, buffers larger than this are sent as many datagrams of this size, using UDP segmentation offload (GSO) where supported. Default: 0.
+ * @param {boolean=} [options.gro=false] - When true, coalesced datagrams are received with UDP generic receive offload (GRO) where supported. Default: false.
+ * @param {number=} [options.sendHighWaterMark=0] - When greater than 0, queued send bytes past which sends fail with `ERR_SOCKET_DGRAM_WOULD_BLOCK` until a 'drain' event. Default: 0 (no limit).
  * @param {number=} options.recvBufferSize - Sets the SO_RCVBUF socket value.
  * @param {number=} options.sendBufferSize - Sets the SO_SNDBUF socket value.
  * @param {AbortSignal=} options.signal - An AbortSignal that may be used to close a socket.
@@ -652,7 +911,16 @@ export class Socket extends EventEmitter {
       bindState: BIND_STATE_UNBOUND,
       connectState: CONNECT_STATE_DISCONNECTED,
       reuseAddr: options.reuseAddr === true,
-      ipv6Only: options.ipv6Only === true
+      ipv6Only: options.ipv6Only === true,
+      segmentSize: Number.isInteger(options.segmentSize) && options.segmentSize > 0
+        ? options.segmentSize
+        : 0,
+      gro: options.gro === true,
+      sendHighWaterMark: Number.isInteger(options.sendHighWaterMark) && options.sendHighWaterMark > 0
+        ? options.sendHighWaterMark
+        : 0,
+      sendQueueSize: 0,
+      sendQueueCount: 0
     }
 
     if (isFunction(callback)) {
@@ -738,7 +1006,7 @@ export class Socket extends EventEmitter {
           this.knownIdWasGivenInSocketConstruction &&
           err.code === 'ERR_SOCKET_ALREADY_BOUND'
         ) {
-          this.dataListener = createDataListener(this)
+          ensureDataListener(this)
           cb(null)
           this.emit('listening')
         } else {
@@ -752,7 +1020,7 @@ export class Socket extends EventEmitter {
         if (err) {
           cb(err)
         } else {
-          this.dataListener = createDataListener(this)
+          ensureDataListener(this)
           cb(null)
           this.emit('listening')
         }
@@ -944,6 +1212,75 @@ export class Socket extends EventEmitter {
     return send(this, { id, port, address, buffer }, cb)
   }
 
+  /**
+   * Sends many datagrams in a single request, either one `buffer` to every
+   * destination in `destinations` or a list of `{ buffer, port, address }`
+   * datagrams. On Linux the datagrams are written with one `sendmmsg(2)`
+   * call when possible.
+   *
+   * > The callback is called once for all datagrams with an error, if none
+   * could be sent, or an object with the number of datagrams `sent` and
+   * `failed`.
+   *
+   * @param {Buffer | TypedArray | DataView | string | Array<object>} buffer - Message to be sent or a list of datagrams.
+   * @param {Array<{ port: number, address?: string }>=} [destinations] - Destinations for `buffer`.
+   * @param {Function=} callback - Called when all datagrams have been sent.
+   */
+  sendMany (buffer, destinations, callback) {
+    const datagrams = []
+    let shared = null
+    let cb = defaultCallback(this)
+
+    if (isFunction(destinations)) {
+      callback = destinations
+      destinations = null
+    }
+
+    if (isFunction(callback)) {
+      cb = callback
+    }
+
+    if (Array.isArray(destinations)) {
+      if (typeof buffer === 'string' || isArrayBufferView(buffer)) {
+        shared = Buffer.from(buffer)
+      }
+
+      if (!Buffer.isBuffer(shared)) {
+        throw new TypeError('Invalid buffer')
+      }
+
+      datagrams.push(...destinations.map((destination) => ({ ...destination })))
+    } else if (Array.isArray(buffer)) {
+      for (const datagram of buffer) {
+        const message = datagram?.buffer
+
+        if (typeof message !== 'string' && !isArrayBufferView(message)) {
+          throw new TypeError('Invalid buffer')
+        }
+
+        datagrams.push({ ...datagram, buffer: Buffer.from(message) })
+      }
+    } else {
+      throw new TypeError('Expecting an array of datagrams or destinations')
+    }
+
+    for (const datagram of datagrams) {
+      const port = parseInt(datagram?.port)
+
+      if (this.state.connectState !== CONNECT_STATE_CONNECTED) {
+        if (!Number.isInteger(port) || port <= 0 || port > (64 * 1024)) {
+          throw new ERR_SOCKET_BAD_PORT(
+            `Port should be > 0 and < 65536. Received ${datagram?.port}.`
+          )
+        }
+      }
+
+      datagram.port = port
+    }
+
+    return sendMany(this, { datagrams, shared }, cb)
+  }
+
   /**
    * Close the underlying socket and stop listening for data on it. If a
    * callback is provided, it is added as a listener for the 'close' event.
@@ -1126,51 +1463,178 @@ export class Socket extends EventEmitter {
     return this.state.sendBufferSize
   }
 
-  //
-  // For now we aren't going to implement any of the multicast options,
-  // mainly because 1. we don't need it in hyper and 2. if a user wants
-  // to deploy their app to the app store, they will need to request the
-  // multicast entitlement from apple. If someone really wants this they
-  // can implement it.
-  //
-  setBroadcast () {
-    throw new Error('not implemented')
+  /**
+   * @returns {number} the number of bytes queued for sending, as of the last send or 'drain' event.
+   * @see {@link https://nodejs.org/api/dgram.html#socketgetsendqueuesize}
+   */
+  getSendQueueSize () {
+    return this.state.sendQueueSize
   }
 
-  setTTL () {
-    throw new Error('not implemented')
+  /**
+   * @returns {number} the number of send requests queued, as of the last send or 'drain' event.
+   * @see {@link https://nodejs.org/api/dgram.html#socketgetsendqueuecount}
+   */
+  getSendQueueCount () {
+    return this.state.sendQueueCount
   }
 
-  setMulticastTTL () {
-    throw new Error('not implemented')
+  /**
+   * Sets or clears the SO_BROADCAST socket option. When set to true, UDP
+   * packets may be sent to a local interface's broadcast address.
+   *
+   * @param {boolean} flag
+   * @see {@link https://nodejs.org/api/dgram.html#socketsetbroadcastflag}
+   */
+  setBroadcast (flag) {
+    setSocketOptions(this, { broadcast: Boolean(flag) })
   }
 
-  setMulticastLoopback () {
-    throw new Error('not implemented')
+  /**
+   * Sets the IP_TTL socket option, the number of IP hops a packet is
+   * allowed to travel through.
+   *
+   * @param {number} ttl - A number between 1 and 255
+   * @returns {number}
+   * @see {@link https://nodejs.org/api/dgram.html#socketsetttlttl}
+   */
+  setTTL (ttl) {
+    if (typeof ttl !== 'number') {
+      throw new TypeError(`Expecting 'ttl' to be a number. Received: ${typeof ttl}`)
+    }
+
+    setSocketOptions(this, { ttl })
+    return ttl
   }
 
-  setMulticastMembership () {
-    throw new Error('not implemented')
+  /**
+   * Sets the IP_MULTICAST_TTL socket option, the number of IP hops a
+   * multicast packet is allowed to travel through.
+   *
+   * @param {number} ttl - A number between 0 and 255
+   * @returns {number}
+   * @see {@link https://nodejs.org/api/dgram.html#socketsetmulticastttlttl}
+   */
+  setMulticastTTL (ttl) {
+    if (typeof ttl !== 'number') {
+      throw new TypeError(`Expecting 'ttl' to be a number. Received: ${typeof ttl}`)
+    }
+
+    setSocketOptions(this, { multicastTTL: ttl })
+    return ttl
   }
 
-  setMulticastInterface () {
-    throw new Error('not implemented')
+  /**
+   * Sets or clears the IP_MULTICAST_LOOP socket option. When set to true,
+   * multicast packets will also be received on the local interface.
+   *
+   * @param {boolean} flag
+   * @returns {boolean}
+   * @see {@link https://nodejs.org/api/dgram.html#socketsetmulticastloopbackflag}
+   */
+  setMulticastLoopback (flag) {
+    setSocketOptions(this, { multicastLoopback: Boolean(flag) })
+    return flag
   }
 
-  addMembership () {
-    throw new Error('not implemented')
+  /**
+   * Alias for `socket.addMembership()`.
+   * @ignore
+   */
+  setMulticastMembership (multicastAddress, multicastInterface) {
+    return this.addMembership(multicastAddress, multicastInterface)
   }
 
-  dropMembership () {
-    throw new Error('not implemented')
+  /**
+   * Sets the default outgoing multicast interface of the socket.
+   *
+   * @param {string} multicastInterface
+   * @see {@link https://nodejs.org/api/dgram.html#socketsetmulticastinterfacemulticastinterface}
+   */
+  setMulticastInterface (multicastInterface) {
+    if (typeof multicastInterface !== 'string') {
+      throw new TypeError(`Expecting 'multicastInterface' to be a string. Received: ${typeof multicastInterface}`)
+    }
+
+    setSocketOptions(this, { multicastInterface })
+  }
+
+  /**
+   * Tells the kernel to join a multicast group at the given
+   * `multicastAddress` and `multicastInterface` using the IP_ADD_MEMBERSHIP
+   * socket option. On Apple platforms, apps need the multicast networking
+   * entitlement to join groups.
+   *
+   * @param {string} multicastAddress
+   * @param {string=} [multicastInterface]
+   * @see {@link https://nodejs.org/api/dgram.html#socketaddmembershipmulticastaddress-multicastinterface}
+   */
+  addMembership (multicastAddress, multicastInterface) {
+    setMembership(this, 'add', multicastAddress, multicastInterface)
+  }
+
+  /**
+   * Instructs the kernel to leave a multicast group at `multicastAddress`
+   * using the IP_DROP_MEMBERSHIP socket option.
+   *
+   * @param {string} multicastAddress
+   * @param {string=} [multicastInterface]
+   * @see {@link https://nodejs.org/api/dgram.html#socketdropmembershipmulticastaddress-multicastinterface}
+   */
+  dropMembership (multicastAddress, multicastInterface) {
+    setMembership(this, 'drop', multicastAddress, multicastInterface)
+  }
+
+  /**
+   * Tells the kernel to join a source-specific multicast channel at the
+   * given `sourceAddress` and `groupAddress`, using the `multicastInterface`
+   * with the IP_ADD_SOURCE_MEMBERSHIP socket option.
+   *
+   * @param {string} sourceAddress
+   * @param {string} groupAddress
+   * @param {string=} [multicastInterface]
+   * @see {@link https://nodejs.org/api/dgram.html#socketaddsourcespecificmembershipsourceaddress-groupaddress-multicastinterface}
+   */
+  addSourceSpecificMembership (sourceAddress, groupAddress, multicastInterface) {
+    if (typeof sourceAddress !== 'string') {
+      throw new TypeError(`Expecting 'sourceAddress' to be a string. Received: ${typeof sourceAddress}`)
+    }
+
+    setMembership(this, 'add', groupAddress, multicastInterface, sourceAddress)
   }
 
-  addSourceSpecificMembership () {
-    throw new Error('not implemented')
+  /**
+   * Instructs the kernel to leave a source-specific multicast channel at the
+   * given `sourceAddress` and `groupAddress` using the
+   * IP_DROP_SOURCE_MEMBERSHIP socket option.
+   *
+   * @param {string} sourceAddress
+   * @param {string} groupAddress
+   * @param {string=} [multicastInterface]
+   * @see {@link https://nodejs.org/api/dgram.html#socketdropsourcespecificmembershipsourceaddress-groupaddress-multicastinterface}
+   */
+  dropSourceSpecificMembership (sourceAddress, groupAddress, multicastInterface) {
+    if (typeof sourceAddress !== 'string') {
+      throw new TypeError(`Expecting 'sourceAddress' to be a string. Received: ${typeof sourceAddress}`)
+    }
+
+    setMembership(this, 'drop', groupAddress, multicastInterface, sourceAddress)
   }
 
-  dropSourceSpecificMembership () {
-    throw new Error('not implemented')
+  /**
+   * Marks sent datagrams with a differentiated services code point using the
+   * IP_TOS (or IPV6_TCLASS) socket option. Not supported on Windows.
+   *
+   * @param {number} dscp - A number between 0 and 63
+   * @returns {number}
+   */
+  setDSCP (dscp) {
+    if (typeof dscp !== 'number') {
+      throw new TypeError(`Expecting 'dscp' to be a number. Received: ${typeof dscp}`)
+    }
+
+    setSocketOptions(this, { dscp })
+    return dscp
   }
 
   ref () {
@@ -1,5 +1,6 @@
 import channels from './channels.js'
 import window from './window.js'
+import ipc from '../ipc.js'
 
 import * as exports from './index.js'
 
@@ -13,3 +14,18 @@ export { channels, window }
 export function channel (name) {
   return channels.channel(name)
 }
+
+/**
+ * Queries diagnostics from the runtime, like the number of DNS lookups
+ * served from its cache (`dns.cache.hits`) or resolved (`dns.cache.misses`).
+ * @return {Promise<object>}
+ */
+export async function query () {
+  const result = await ipc.send('diagnostics.query')
+
+  if (result.err) {
+    throw result.err
+  }
+
+  return result.data
+}
@@ -14,6 +14,7 @@
  * ```
  */
 
+import { normalizeLookupOptions } from './options.js'
 import { isFunction } from '../util.js'
 import * as promises from './promises.js'
 import diagnostics from '../diagnostics.js'
@@ -54,6 +55,9 @@ const dc = diagnostics.channels.group('dns', [
  * @param {string} hostname - The host name to resolve.
  * @param {(object|intenumberger)=} [options] - An options object or record family.
  * @param {(number|string)=} [options.family=0] - The record family. Must be 4, 6, or 0. For backward compatibility reasons,'IPv4' and 'IPv6' are interpreted as 4 and 6 respectively. The value 0 indicates that IPv4 and IPv6 addresses are both returned. Default: 0.
+ * @param {number=} [options.hints=0] - One or more `getaddrinfo(3)` flags, combined with bitwise OR.
+ * @param {boolean=} [options.all=false] - When true, the callback returns all resolved addresses in an array. Otherwise, returns a single address. Default: false.
+ * @param {boolean=} [options.verbatim=true] - When true, addresses are returned in the order the resolver returned them. When false, IPv4 addresses are placed before IPv6 addresses. Default: true.
  * @param {function} cb - The function to call after the method is complete.
  * @returns {void}
  */
@@ -82,7 +86,12 @@ export function lookup (hostname, options = {}, cb) {
     options = {}
   }
 
-  dc.channel('lookup.start').publish({ hostname, family: options.family, sync: true })
+  options = normalizeLookupOptions(options)
+
+  // `family` is left out of the request when 0, both families are resolved
+  const family = options.family ?? 0
+
+  dc.channel('lookup.start').publish({ hostname, family, sync: true })
   const { err, data } = ipc.sendSync('dns.lookup', { ...options, id: rand64(), hostname })
 
   if (err) {
@@ -96,8 +105,14 @@ export function lookup (hostname, options = {}, cb) {
     return
   }
 
-  dc.channel('lookup.end').publish({ hostname, family: options.family, sync: true })
-  dc.channel('lookup').publish({ hostname, family: options.family, sync: true })
+  dc.channel('lookup.end').publish({ hostname, family, sync: true })
+  dc.channel('lookup').publish({ hostname, family, sync: true })
+
+  if (options.all) {
+    cb(null, Array.isArray(data) ? data : [])
+    return
+  }
+
   cb(null, data?.address ?? null, data?.family ?? null)
 }
 
@@ -0,0 +1,36 @@
+import * as exports from './options.js'
+
+/**
+ * Normalizes `lookup()` options into `dns.lookup` request parameters,
+ * leaving out defaults so they are not sent as strings.
+ * @ignore
+ * @param {object} options
+ * @return {object}
+ */
+export function normalizeLookupOptions (options) {
+  const params = {}
+
+  if (options.family === 'IPv4') {
+    params.family = 4
+  } else if (options.family === 'IPv6') {
+    params.family = 6
+  } else if (options.family) {
+    params.family = options.family
+  }
+
+  if (Number.isInteger(options.hints) && options.hints > 0) {
+    params.hints = options.hints
+  }
+
+  if (options.all === true) {
+    params.all = true
+  }
+
+  if (options.verbatim === false) {
+    params.verbatim = false
+  }
+
+  return params
+}
+
+export default exports
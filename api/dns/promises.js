@@ -14,6 +14,7 @@
  * ```
  */
 
+import { normalizeLookupOptions } from './options.js'
 import diagnostics from '../diagnostics.js'
 import { rand64 } from '../crypto.js'
 import ipc from '../ipc.js'
@@ -32,6 +33,9 @@ const dc = diagnostics.channels.group('dns', [
  * @param {string} hostname - The host name to resolve.
  * @param {Object=} opts - An options object.
  * @param {(number|string)=} [opts.family=0] - The record family. Must be 4, 6, or 0. For backward compatibility reasons,'IPv4' and 'IPv6' are interpreted as 4 and 6 respectively. The value 0 indicates that IPv4 and IPv6 addresses are both returned. Default: 0.
+ * @param {number=} [opts.hints=0] - One or more `getaddrinfo(3)` flags, combined with bitwise OR.
+ * @param {boolean=} [opts.all=false] - When true, the promise resolves to all addresses in an array. Otherwise, resolves to a single address. Default: false.
+ * @param {boolean=} [opts.verbatim=true] - When true, addresses are returned in the order the resolver returned them. When false, IPv4 addresses are placed before IPv6 addresses. Default: true.
  * @returns {Promise}
  */
 export async function lookup (hostname, opts) {
@@ -49,11 +53,11 @@ export async function lookup (hostname, opts) {
     opts = {}
   }
 
-  if (!opts.family) {
-    opts.family = 4
-  }
+  opts = normalizeLookupOptions(opts)
+  // `family` is left out of the request when 0, both families are resolved
+  const family = opts.family ?? 0
 
-  dc.channel('lookup.start').publish({ hostname, family: opts.family })
+  dc.channel('lookup.start').publish({ hostname, family })
   const { err, data } = await ipc.send('dns.lookup', { ...opts, id: rand64(), hostname })
 
   if (err) {
@@ -66,8 +70,12 @@ export async function lookup (hostname, opts) {
     throw e
   }
 
-  dc.channel('lookup.end').publish({ hostname, family: opts.family })
-  dc.channel('lookup').publish({ hostname, family: opts.family })
+  dc.channel('lookup.end').publish({ hostname, family })
+  dc.channel('lookup').publish({ hostname, family })
+
+  if (opts.all) {
+    return Array.isArray(data) ? data : []
+  }
 
   return data
 }
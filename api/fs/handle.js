@@ -114,6 +114,9 @@ export class FileHandle extends EventEmitter {
    * @param {string=} [flags = 'r']
    * @param {string|number=} [mode = 0o666]
    * @param {object=} [options]
+   * @param {boolean=} [options.writeBehind = false] - Resolve writes once
+   *   buffered and coalesce adjacent ones into a single write. A failed
+   *   buffered write rejects the next write, sync or close.
    * @return {Promise<FileHandle>}
    */
   static async open (path, flags, mode, options) {
@@ -125,7 +128,12 @@ export class FileHandle extends EventEmitter {
       mode = FileHandle.DEFAULT_OPEN_MODE
     }
 
-    const handle = new this({ path, flags, mode })
+    const handle = new this({
+      path,
+      flags,
+      mode,
+      writeBehind: options?.writeBehind
+    })
 
     if (typeof handle.path !== 'string') {
       throw new TypeError('Expecting path to be a string, Buffer, or URL.')
@@ -156,6 +164,8 @@ export class FileHandle extends EventEmitter {
     this.flags = normalizeFlags(options?.flags)
     this.path = options?.path || null
     this.mode = options?.mode || FileHandle.DEFAULT_OPEN_MODE
+    // coalesce adjacent writes in the native layer
+    this.writeBehind = options?.writeBehind === true
 
     // this id will be used to identify the file handle that is a
     // reference stored in the native side
@@ -385,7 +395,7 @@ export class FileHandle extends EventEmitter {
       return await this[kOpening]
     }
 
-    const { flags, mode, path, id } = this
+    const { flags, mode, path, id, writeBehind } = this
 
     if (options?.signal?.aborted) {
       throw new AbortError(options.signal)
@@ -397,7 +407,8 @@ export class FileHandle extends EventEmitter {
       id,
       mode,
       path,
-      flags
+      flags,
+      writeBehind
     }, options)
 
     if (result.err) {
@@ -425,6 +436,9 @@ export class FileHandle extends EventEmitter {
    * @param {number=} [length]
    * @param {number=} [position]
    * @param {object=} [options]
+   * @param {number=} [options.readAhead] - Chunks the native layer reads ahead
+   * of sequential reads, `0` (the default) disables read-ahead, larger windows are clamped
+   * to 16 chunks
    */
   async read (buffer, offset, length, position, options) {
     if (this.closing || this.closed) {
@@ -505,11 +519,17 @@ export class FileHandle extends EventEmitter {
       )
     }
 
-    const result = await ipc.request('fs.read', {
-      id,
-      size: length,
-      offset: position
-    }, { signal, timeout, responseType: 'arraybuffer' })
+    const params = { id, size: length, offset: position }
+
+    if (typeof options?.readAhead === 'number') {
+      params.readAhead = options.readAhead
+    }
+
+    const result = await ipc.request('fs.read', params, {
+      signal,
+      timeout,
+      responseType: 'arraybuffer'
+    })
 
     if (result.err) {
       throw result.err
@@ -593,13 +613,22 @@ export class FileHandle extends EventEmitter {
       throw new Error('FileHandle is not opened')
     }
 
-    const result = await ipc.request('fs.fstat', { ...options, id: this.id })
+    const result = await ipc.request('fs.fstat', {
+      ...options,
+      binary: true,
+      id: this.id
+    }, {
+      responseType: 'arraybuffer'
+    })
 
     if (result.err) {
       throw result.err
     }
 
-    const stats = Stats.from(result.data, Boolean(options?.bigint))
+    // platforms that do not support binary stat records respond with JSON
+    const stats = isBufferLike(result.data)
+      ? Stats.fromRecord(result.data, 0, Boolean(options?.bigint))
+      : Stats.from(result.data, Boolean(options?.bigint))
     stats.handle = this
     return stats
   }
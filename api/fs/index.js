@@ -653,6 +653,14 @@ export function readFile (path, options = {}, callback) {
     throw new TypeError('callback must be a function.')
   }
 
+  // read in a single native request
+  if (typeof path === 'string') {
+    promises.readFile(path, options)
+      .then((buffer) => callback(null, buffer))
+      .catch((err) => callback(err))
+    return
+  }
+
   visit(path, options, async (err, handle) => {
     let buffer = null
 
@@ -791,6 +799,30 @@ export function stat (path, options, callback) {
   })
 }
 
+/**
+ * Computes stats for many paths in a single native request. The callback is
+ * given a `Stats` instance for each path, in order, or `null` for a path
+ * that could not be stated.
+ * @param {Array<string>} paths
+ * @param {object?} options
+ * @param {boolean?} [options.bigint = false]
+ * @param {function(Error?, Array<Stats?>?)} callback
+ */
+export function statMany (paths, options, callback) {
+  if (typeof options === 'function') {
+    callback = options
+    options = {}
+  }
+
+  if (typeof callback !== 'function') {
+    throw new TypeError('callback must be a function.')
+  }
+
+  promises.statMany(paths, options)
+    .then((stats) => callback(null, stats))
+    .catch((err) => callback(err))
+}
+
 /**
  * Creates a symlink of `src` at `dest`.
  * @param {string} src
@@ -882,6 +914,14 @@ export function writeFile (path, data, options, callback) {
     throw new TypeError('callback must be a function.')
   }
 
+  // write in a single native request
+  if (typeof path === 'string') {
+    promises.writeFile(path, data, options)
+      .then(() => callback(null))
+      .catch((err) => callback(err))
+    return
+  }
+
   visit(path, options, async (err, handle) => {
     if (err) {
       callback(err)
@@ -22,15 +22,20 @@
  * import fs from 'socket:fs/promises'
  * ```
  */
+import { isTypedArray } from '../util.js'
+import { AbortError } from '../errors.js'
+import { Buffer } from '../buffer.js'
 import console from '../console.js'
 import ipc from '../ipc.js'
+import os from '../os.js'
 
 import { Dir, Dirent, sortDirectoryEntries } from './dir.js'
 import { DirectoryHandle, FileHandle } from './handle.js'
 import { ReadStream, WriteStream } from './stream.js'
 import * as constants from './constants.js'
 import { Watcher } from './watcher.js'
-import { Stats } from './stats.js'
+import { Stats, STATS_RECORD_SIZE } from './stats.js'
+import { normalizeFlags } from './flags.js'
 import fds from './fds.js'
 
 import * as exports from './promises.js'
@@ -49,8 +54,11 @@ export {
   WriteStream
 }
 
+// file paths on Android may resolve through the content resolver, which
+// only the `FileHandle` code path understands
+const isAndroid = /android/i.test(os.type())
+
 /**
- * @typedef {import('../buffer.js').Buffer} Buffer
  * @typedef {import('.stats.js').Stats} Stats
  * @typedef {Uint8Array|Int8Array} TypedArray
  * @ignore
@@ -313,6 +321,38 @@ export async function readFile (path, options) {
 
   options = { flags: 'r', ...options }
 
+  // read in a single native request when not given a `FileHandle` or fd
+  if (typeof path === 'string' && !isAndroid) {
+    const { signal, timeout } = options
+
+    if (signal?.aborted) {
+      throw new AbortError(signal)
+    }
+
+    const result = await ipc.request('fs.readFile', {
+      path,
+      flags: normalizeFlags(options.flag ?? options.flags)
+    }, {
+      responseType: 'arraybuffer',
+      timeout,
+      signal
+    })
+
+    if (result.err) {
+      throw result.err
+    }
+
+    const buffer = isTypedArray(result.data) || result.data instanceof ArrayBuffer
+      ? Buffer.from(result.data)
+      : Buffer.alloc(0)
+
+    if (typeof options.encoding === 'string') {
+      return buffer.toString(options.encoding)
+    }
+
+    return buffer
+  }
+
   return await visit(path, options, async (handle) => {
     return await handle.readFile(options)
   })
@@ -408,6 +448,43 @@ export async function stat (path, options) {
   })
 }
 
+/**
+ * Computes stats for many paths in a single native request. The result
+ * contains a `Stats` instance for each path, in order, or `null` for a
+ * path that could not be stated.
+ * @param {Array<string>} paths
+ * @param {object?} [options]
+ * @param {boolean?} [options.bigint = false]
+ * @return {Promise<Array<Stats?>>}
+ */
+export async function statMany (paths, options) {
+  if (!Array.isArray(paths)) {
+    throw new TypeError('paths must be an array.')
+  }
+
+  if (paths.length === 0) {
+    return []
+  }
+
+  const buffer = Buffer.from(paths.map(String).join('\0'))
+  const result = await ipc.write('fs.statMany', {}, buffer, {
+    responseType: 'arraybuffer'
+  })
+
+  if (result.err) {
+    throw result.err
+  }
+
+  const stats = []
+
+  for (let i = 0; i < paths.length; ++i) {
+    const offset = i * STATS_RECORD_SIZE
+    stats.push(Stats.fromRecord(result.data, offset, Boolean(options?.bigint)))
+  }
+
+  return stats
+}
+
 /**
  * Creates a symlink of `src` at `dest`.
  * @param {string} src
@@ -469,6 +546,8 @@ export async function unlink (path) {
  * @param {string|null} [options.encoding = 'utf8']
  * @param {number} [options.mode = 0o666]
  * @param {string} [options.flag = 'w']
+ * @param {boolean} [options.atomic = false] - Write to a temporary file and
+ * rename it to `path` so readers never observe a partial file
  * @param {AbortSignal?} [options.signal]
  * @return {Promise<void>}
  */
@@ -479,6 +558,33 @@ export async function writeFile (path, data, options) {
 
   options = { flag: 'w', mode: 0o666, ...options }
 
+  // write in a single native request when not given a `FileHandle` or fd
+  if (typeof path === 'string' && !isAndroid) {
+    const { signal, timeout } = options
+
+    if (signal?.aborted) {
+      throw new AbortError(signal)
+    }
+
+    const buffer = Buffer.from(data, options.encoding ?? 'utf8')
+
+    const result = await ipc.write('fs.writeFile', {
+      path,
+      mode: options.mode,
+      flags: normalizeFlags(options.flag ?? options.flags),
+      atomic: options.atomic === true
+    }, buffer, {
+      timeout,
+      signal
+    })
+
+    if (result.err) {
+      throw result.err
+    }
+
+    return
+  }
+
   return await visit(path, options, async (handle) => {
     return await handle.writeFile(data, options)
   })
@@ -30,10 +30,55 @@ function checkMode (mode, property) {
   return (mode & constants.S_IFMT) === property
 }
 
+/**
+ * The size in bytes of a packed binary stat record.
+ * @ignore
+ */
+export const STATS_RECORD_SIZE = 21 * 8
+
 /**
  * A container for various stats about a file or directory.
  */
 export class Stats {
+  /**
+   * Creates a `Stats` instance from a packed binary stat record, optionally
+   * with `BigInt` data types. A record is 21 big endian 64-bit fields where
+   * the first field is `0` or a negative error code. `null` is returned for
+   * records with an error status.
+   * @param {ArrayBuffer|Uint8Array} buffer
+   * @param {number=} [offset = 0]
+   * @param {fromBigInt=} [fromBigInt = false]
+   * @return {Stats?}
+   */
+  static fromRecord (buffer, offset = 0, fromBigInt = false) {
+    const view = ArrayBuffer.isView(buffer)
+      ? new DataView(buffer.buffer, buffer.byteOffset, buffer.byteLength)
+      : new DataView(buffer)
+
+    const field = (index) => view.getBigInt64(offset + index * 8)
+
+    if (field(0) < 0n) {
+      return null
+    }
+
+    return this.from({
+      st_dev: field(1),
+      st_mode: field(2),
+      st_nlink: field(3),
+      st_uid: field(4),
+      st_gid: field(5),
+      st_rdev: field(6),
+      st_ino: field(7),
+      st_size: field(8),
+      st_blksize: field(9),
+      st_blocks: field(10),
+      st_atim: { tv_sec: field(13), tv_nsec: field(14) },
+      st_mtim: { tv_sec: field(15), tv_nsec: field(16) },
+      st_ctim: { tv_sec: field(17), tv_nsec: field(18) },
+      st_birthtim: { tv_sec: field(19), tv_nsec: field(20) }
+    }, fromBigInt)
+  }
+
   /**
    * Creates a `Stats` instance from input, optionally with `BigInt` data types
    * @param {object|Stats} [stat]
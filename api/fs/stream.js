@@ -37,6 +37,7 @@ export class ReadStream extends Readable {
     this.buffer = new ArrayBuffer(this.highWaterMark)
     this.signal = options?.signal
     this.timeout = options?.timeout || undefined
+    this.readAhead = options?.readAhead
     this.bytesRead = 0
     this.shouldEmitClose = options?.emitClose !== false
 
@@ -122,7 +123,7 @@ export class ReadStream extends Readable {
   }
 
   async _read (callback) {
-    const { signal, handle, timeout, buffer } = this
+    const { signal, handle, timeout, readAhead, buffer } = this
 
     if (!handle || !handle.opened) {
       return callback(new Error('File handle not opened'))
@@ -141,6 +142,7 @@ export class ReadStream extends Readable {
 
     try {
       result = await handle.read(buffer, 0, length, position, {
+        readAhead,
         timeout,
         signal
       })
@@ -1636,6 +1636,12 @@ declare module "socket:diagnostics/index" {
      * @return {import('./channels.js').Channel}
      */
     export function channel(name: string): import("socket:diagnostics/channels").Channel;
+    /**
+     * Queries diagnostics from the runtime, like the number of DNS lookups
+     * served from its cache (`dns.cache.hits`) or resolved (`dns.cache.misses`).
+     * @return {Promise<object>}
+     */
+    export function query(): Promise<object>;
     export default exports;
     import * as exports from "socket:diagnostics/index";
     import channels from "socket:diagnostics/channels";
@@ -1892,6 +1898,7 @@ declare module "socket:fs/stream" {
         buffer: ArrayBuffer;
         signal: any;
         timeout: any;
+        readAhead: any;
         bytesRead: number;
         shouldEmitClose: boolean;
         /**
@@ -2045,6 +2052,17 @@ declare module "socket:fs/stats" {
      * A container for various stats about a file or directory.
      */
     export class Stats {
+        /**
+         * Creates a `Stats` instance from a packed binary stat record, optionally
+         * with `BigInt` data types. A record is 21 big endian 64-bit fields where
+         * the first field is `0` or a negative error code. `null` is returned for
+         * records with an error status.
+         * @param {ArrayBuffer|Uint8Array} buffer
+         * @param {number=} [offset = 0]
+         * @param {fromBigInt=} [fromBigInt = false]
+         * @return {Stats?}
+         */
+        static fromRecord(buffer: ArrayBuffer | Uint8Array, offset?: number | undefined, fromBigInt?: any): Stats | null;
         /**
          * Creates a `Stats` instance from input, optionally with `BigInt` data types
          * @param {object|Stats} [stat]
@@ -2170,6 +2188,9 @@ declare module "socket:fs/handle" {
          * @param {string=} [flags = 'r']
          * @param {string|number=} [mode = 0o666]
          * @param {object=} [options]
+         * @param {boolean=} [options.writeBehind = false] - Resolve writes once
+         *   buffered and coalesce adjacent ones into a single write. A failed
+         *   buffered write rejects the next write, sync or close.
          * @return {Promise<FileHandle>}
          */
         static open(path: string | Buffer | URL, flags?: string | undefined, mode?: (string | number) | undefined, options?: object | undefined): Promise<FileHandle>;
@@ -2182,6 +2203,7 @@ declare module "socket:fs/handle" {
         flags: any;
         path: any;
         mode: any;
+        writeBehind: boolean;
         id: string;
         fd: any;
         /**
@@ -2257,6 +2279,9 @@ declare module "socket:fs/handle" {
          * @param {number=} [length]
          * @param {number=} [position]
          * @param {object=} [options]
+         * @param {number=} [options.readAhead] - Chunks the native layer reads ahead
+         * of sequential reads, `0` (the default) disables read-ahead, larger windows are clamped
+         * to 16 chunks
          */
         read(buffer: Buffer | object, offset?: number | undefined, length?: number | undefined, position?: number | undefined, options?: object | undefined): Promise<{
             bytesRead: number;
@@ -3036,6 +3061,16 @@ declare module "socket:fs/promises" {
      * @return {Promise<Stats>}
      */
     export function stat(path: string | Buffer | URL, options?: object | null): Promise<Stats>;
+    /**
+     * Computes stats for many paths in a single native request. The result
+     * contains a `Stats` instance for each path, in order, or `null` for a
+     * path that could not be stated.
+     * @param {Array<string>} paths
+     * @param {object?} [options]
+     * @param {boolean?} [options.bigint = false]
+     * @return {Promise<Array<Stats?>>}
+     */
+    export function statMany(paths: Array<string>, options?: object | null): Promise<Array<Stats | null>>;
     /**
      * Creates a symlink of `src` at `dest`.
      * @param {string} src
@@ -3057,6 +3092,8 @@ declare module "socket:fs/promises" {
      * @param {string|null} [options.encoding = 'utf8']
      * @param {number} [options.mode = 0o666]
      * @param {string} [options.flag = 'w']
+     * @param {boolean} [options.atomic = false] - Write to a temporary file and
+     * rename it to `path` so readers never observe a partial file
      * @param {AbortSignal?} [options.signal]
      * @return {Promise<void>}
      */
@@ -3281,6 +3318,16 @@ declare module "socket:fs/index" {
      * @param {function(Error?, Stats?)} callback
      */
     export function stat(path: string | Buffer | URL | number, options: object | null, callback: (arg0: Error | null, arg1: Stats | null) => any): void;
+    /**
+     * Computes stats for many paths in a single native request. The callback is
+     * given a `Stats` instance for each path, in order, or `null` for a path
+     * that could not be stated.
+     * @param {Array<string>} paths
+     * @param {object?} options
+     * @param {boolean?} [options.bigint = false]
+     * @param {function(Error?, Array<Stats?>?)} callback
+     */
+    export function statMany(paths: Array<string>, options: object | null, callback: (arg0: Error | null, arg1: Array<Stats | null> | null) => any): void;
     /**
      * Creates a symlink of `src` at `dest`.
      * @param {string} src
@@ -4874,12 +4921,202 @@ declare module "socket:ip" {
      * @return {boolean}
      */
     export function isIPv4(input: string | object | string[] | Uint8Array): boolean;
+    /**
+     * Determines if an input `string` is in IP address version 6 format,
+     * including compressed (`::`) forms, embedded IPv4 addresses and zone
+     * indices (`fe80::1%eth0`).
+     * @param {string} input
+     * @return {boolean}
+     */
+    export function isIPv6(input: string): boolean;
+    /**
+     * Determines if an input `string` is an IPv4 or IPv6 address and returns
+     * its version, or `0` if it is neither.
+     * @param {string} input
+     * @return {number}
+     */
+    export function isIP(input: string): number;
     namespace _default {
         export { normalizeIPv4 };
         export { isIPv4 };
+        export { isIPv6 };
+        export { isIP };
     }
     export default _default;
 }
+declare module "socket:net" {
+    /**
+     * Creates a new TCP server.
+     * @param {object|function=} [options]
+     * @param {function=} [connectionListener]
+     * @return {Server}
+     */
+    export function createServer(options?: (object | Function) | undefined, connectionListener?: Function | undefined): Server;
+    /**
+     * Creates a new TCP socket and connects it.
+     * @param {number|object} port - A port or an object of `port` and `host`
+     * @param {string=} [host]
+     * @param {function=} [callback] - Attached as a listener for 'connect' events.
+     * @return {Socket}
+     */
+    export function connect(port: number | object, host?: string | undefined, callback?: Function | undefined): Socket;
+    export const createConnection: typeof connect;
+    /**
+     * A TCP stream socket.
+     * @see {@link https://nodejs.org/api/net.html#class-netsocket}
+     */
+    export class Socket extends Duplex {
+        /**
+         * `Socket` class constructor.
+         * @param {object=} [options]
+         * @param {boolean=} [options.allowHalfOpen=false] - If `false`, the socket ends the writable side when the readable side ends.
+         * @param {boolean=} [options.noDelay=false] - If `true`, disables Nagle's algorithm once connected.
+         * @param {boolean=} [options.keepAlive=false] - If `true`, enables keep-alive probes once connected.
+         * @param {number=} [options.keepAliveInitialDelay=0] - Idle milliseconds before the first keep-alive probe.
+         */
+        constructor(options?: object | undefined);
+        id: bigint;
+        allowHalfOpen: boolean;
+        connecting: boolean;
+        pending: boolean;
+        bytesRead: number;
+        bytesWritten: number;
+        remoteAddress: string;
+        remotePort: number;
+        remoteFamily: string;
+        localAddress: string;
+        localPort: number;
+        timeout: number;
+        /**
+         * The state of the socket, like `net.Socket#readyState`.
+         * @type {string}
+         */
+        get readyState(): string;
+        /**
+         * Connects the socket to `port` on `host` (default: `'127.0.0.1'`).
+         * @param {number|object} port - A port or an object of `port` and `host`
+         * @param {string=} [host]
+         * @param {function=} [callback] - Attached as a listener for 'connect' events.
+         * @return {Socket}
+         */
+        connect(port: number | object, host?: string | undefined, callback?: Function | undefined): Socket;
+        /**
+         * Returns the bound address of the socket.
+         * @return {{ address: string, port: number, family: string }}
+         */
+        address(): {
+            address: string;
+            port: number;
+            family: string;
+        };
+        /**
+         * Half-closes the socket, like `net.Socket#end()`.
+         * @param {(string|Buffer)=} [data]
+         * @param {function=} [callback]
+         * @return {Socket}
+         */
+        end(data?: (string | Buffer) | undefined, callback?: Function | undefined): Socket;
+        /**
+         * Enables or disables Nagle's algorithm (`TCP_NODELAY`), like
+         * `net.Socket#setNoDelay()`. Applied once connected.
+         * @param {boolean=} [noDelay=true]
+         * @return {Socket}
+         */
+        setNoDelay(noDelay?: boolean | undefined): Socket;
+        /**
+         * Enables or disables keep-alive probes (`SO_KEEPALIVE`), like
+         * `net.Socket#setKeepAlive()`. Applied once connected.
+         * @param {boolean=} [enable=false]
+         * @param {number=} [initialDelay=0] - Idle milliseconds before the first
+         * probe, `0` for the default of 60 seconds
+         * @return {Socket}
+         */
+        setKeepAlive(enable?: boolean | undefined, initialDelay?: number | undefined): Socket;
+        /**
+         * Emits 'timeout' after `timeout` milliseconds without reads or writes,
+         * like `net.Socket#setTimeout()`. The socket is not closed. A `timeout`
+         * of `0` disables the idle timer.
+         * @param {number} timeout
+         * @param {function=} [callback] - Attached as a listener for 'timeout' events.
+         * @return {Socket}
+         */
+        setTimeout(timeout: number, callback?: Function | undefined): Socket;
+        /**
+         * The runtime does not exit while sockets are open, so there is no event
+         * loop reference to keep or release. Kept for `net.Socket` compatibility.
+         * @return {Socket}
+         */
+        ref(): Socket;
+        /**
+         * @see {Socket#ref}
+         * @return {Socket}
+         */
+        unref(): Socket;
+    }
+    /**
+     * A TCP server.
+     * @see {@link https://nodejs.org/api/net.html#class-netserver}
+     */
+    export class Server extends EventEmitter {
+        /**
+         * `Server` class constructor.
+         * @param {object|function=} [options]
+         * @param {function=} [connectionListener] - Attached as a listener for 'connection' events.
+         */
+        constructor(options?: (object | Function) | undefined, connectionListener?: Function | undefined);
+        id: bigint;
+        options: any;
+        listening: boolean;
+        connections: Set<Socket>;
+        /**
+         * Starts listening for connections.
+         * @param {number|object} port - A port or an object of `port`, `host`, `backlog` and `ipv6Only`
+         * @param {string=} [host]
+         * @param {number=} [backlog]
+         * @param {function=} [callback] - Attached as a listener for 'listening' events.
+         * @return {Server}
+         */
+        listen(port: number | object, host?: string | undefined, backlog?: number | undefined, callback?: Function | undefined): Server;
+        /**
+         * Returns the bound address of the server.
+         * @return {{ address: string, port: number, family: string }|null}
+         */
+        address(): {
+            address: string;
+            port: number;
+            family: string;
+        } | null;
+        /**
+         * Stops the server from accepting new connections.
+         * @param {function=} [callback] - Called when the server is closed.
+         * @return {Server}
+         */
+        close(callback?: Function | undefined): Server;
+        /**
+         * Calls `callback` with the number of open connections.
+         * @param {function} callback
+         */
+        getConnections(callback: Function): void;
+        ref(): this;
+        unref(): this;
+    }
+    export class ERR_SOCKET_NOT_CONNECTED extends InternalError {
+        constructor();
+    }
+    export class ERR_SERVER_NOT_RUNNING extends InternalError {
+        constructor();
+    }
+    export default exports;
+    import { Duplex } from "socket:stream";
+    import { EventEmitter } from "socket:events";
+    import { InternalError } from "socket:errors";
+    import { Buffer } from "socket:buffer";
+    import { isIP } from "socket:ip";
+    import { isIPv4 } from "socket:ip";
+    import { isIPv6 } from "socket:ip";
+    import * as exports from "socket:net";
+    export { isIP, isIPv4, isIPv6 };
+}
 declare module "socket:dns/promises" {
     /**
      * @async
@@ -4887,6 +5124,9 @@ declare module "socket:dns/promises" {
      * @param {string} hostname - The host name to resolve.
      * @param {Object=} opts - An options object.
      * @param {(number|string)=} [opts.family=0] - The record family. Must be 4, 6, or 0. For backward compatibility reasons,'IPv4' and 'IPv6' are interpreted as 4 and 6 respectively. The value 0 indicates that IPv4 and IPv6 addresses are both returned. Default: 0.
+     * @param {number=} [opts.hints=0] - One or more `getaddrinfo(3)` flags, combined with bitwise OR.
+     * @param {boolean=} [opts.all=false] - When true, the promise resolves to all addresses in an array. Otherwise, resolves to a single address. Default: false.
+     * @param {boolean=} [opts.verbatim=true] - When true, addresses are returned in the order the resolver returned them. When false, IPv4 addresses are placed before IPv6 addresses. Default: true.
      * @returns {Promise}
      */
     export function lookup(hostname: string, opts?: any | undefined): Promise<any>;
@@ -4921,6 +5161,9 @@ declare module "socket:dns/index" {
      * @param {string} hostname - The host name to resolve.
      * @param {(object|intenumberger)=} [options] - An options object or record family.
      * @param {(number|string)=} [options.family=0] - The record family. Must be 4, 6, or 0. For backward compatibility reasons,'IPv4' and 'IPv6' are interpreted as 4 and 6 respectively. The value 0 indicates that IPv4 and IPv6 addresses are both returned. Default: 0.
+     * @param {number=} [options.hints=0] - One or more `getaddrinfo(3)` flags, combined with bitwise OR.
+     * @param {boolean=} [options.all=false] - When true, the callback returns all resolved addresses in an array. Otherwise, returns a single address. Default: false.
+     * @param {boolean=} [options.verbatim=true] - When true, addresses are returned in the order the resolver returned them. When false, IPv4 addresses are placed before IPv6 addresses. Default: true.
      * @param {function} cb - The function to call after the method is complete.
      * @returns {void}
      */
@@ -4955,6 +5198,11 @@ declare module "socket:dgram" {
             connectState: number;
             reuseAddr: boolean;
             ipv6Only: boolean;
+            segmentSize: number;
+            gro: boolean;
+            sendHighWaterMark: number;
+            sendQueueSize: number;
+            sendQueueCount: number;
         };
         /**
          * Listen for datagram messages on a named port and optional address
@@ -5046,6 +5294,24 @@ declare module "socket:dgram" {
          * @see {@link https://nodejs.org/api/dgram.html#socketsendmsg-offset-length-port-address-callback}
          */
         send(buffer: any, ...args: any[]): Promise<any>;
+        /**
+         * Sends many datagrams in a single request, either one `buffer` to every
+         * destination in `destinations` or a list of `{ buffer, port, address }`
+         * datagrams. On Linux the datagrams are written with one `sendmmsg(2)`
+         * call when possible.
+         *
+         * > The callback is called once for all datagrams with an error, if none
+         * could be sent, or an object with the number of datagrams `sent` and
+         * `failed`.
+         *
+         * @param {Buffer | TypedArray | DataView | string | Array<object>} buffer - Message to be sent or a list of datagrams.
+         * @param {Array<{ port: number, address?: string }>=} [destinations] - Destinations for `buffer`.
+         * @param {Function=} callback - Called when all datagrams have been sent.
+         */
+        sendMany(buffer: Buffer | TypedArray | DataView | string | Array<object>, destinations?: Array<{
+            port: number;
+            address?: string;
+        }> | undefined, callback?: Function | undefined): Promise<any>;
         /**
          * Close the underlying socket and stop listening for data on it. If a
          * callback is provided, it is added as a listener for the 'close' event.
@@ -5106,16 +5372,113 @@ declare module "socket:dgram" {
          * @see {@link https://nodejs.org/api/dgram.html#socketgetsendbuffersize}
          */
         getSendBufferSize(): number;
-        setBroadcast(): void;
-        setTTL(): void;
-        setMulticastTTL(): void;
-        setMulticastLoopback(): void;
-        setMulticastMembership(): void;
-        setMulticastInterface(): void;
-        addMembership(): void;
-        dropMembership(): void;
-        addSourceSpecificMembership(): void;
-        dropSourceSpecificMembership(): void;
+        /**
+         * @returns {number} the number of bytes queued for sending, as of the last send or 'drain' event.
+         * @see {@link https://nodejs.org/api/dgram.html#socketgetsendqueuesize}
+         */
+        getSendQueueSize(): number;
+        /**
+         * @returns {number} the number of send requests queued, as of the last send or 'drain' event.
+         * @see {@link https://nodejs.org/api/dgram.html#socketgetsendqueuecount}
+         */
+        getSendQueueCount(): number;
+        /**
+         * Sets or clears the SO_BROADCAST socket option. When set to true, UDP
+         * packets may be sent to a local interface's broadcast address.
+         *
+         * @param {boolean} flag
+         * @see {@link https://nodejs.org/api/dgram.html#socketsetbroadcastflag}
+         */
+        setBroadcast(flag: boolean): void;
+        /**
+         * Sets the IP_TTL socket option, the number of IP hops a packet is
+         * allowed to travel through.
+         *
+         * @param {number} ttl - A number between 1 and 255
+         * @returns {number}
+         * @see {@link https://nodejs.org/api/dgram.html#socketsetttlttl}
+         */
+        setTTL(ttl: number): number;
+        /**
+         * Sets the IP_MULTICAST_TTL socket option, the number of IP hops a
+         * multicast packet is allowed to travel through.
+         *
+         * @param {number} ttl - A number between 0 and 255
+         * @returns {number}
+         * @see {@link https://nodejs.org/api/dgram.html#socketsetmulticastttlttl}
+         */
+        setMulticastTTL(ttl: number): number;
+        /**
+         * Sets or clears the IP_MULTICAST_LOOP socket option. When set to true,
+         * multicast packets will also be received on the local interface.
+         *
+         * @param {boolean} flag
+         * @returns {boolean}
+         * @see {@link https://nodejs.org/api/dgram.html#socketsetmulticastloopbackflag}
+         */
+        setMulticastLoopback(flag: boolean): boolean;
+        /**
+         * Alias for `socket.addMembership()`.
+         * @ignore
+         */
+        setMulticastMembership(multicastAddress: any, multicastInterface: any): void;
+        /**
+         * Sets the default outgoing multicast interface of the socket.
+         *
+         * @param {string} multicastInterface
+         * @see {@link https://nodejs.org/api/dgram.html#socketsetmulticastinterfacemulticastinterface}
+         */
+        setMulticastInterface(multicastInterface: string): void;
+        /**
+         * Tells the kernel to join a multicast group at the given
+         * `multicastAddress` and `multicastInterface` using the IP_ADD_MEMBERSHIP
+         * socket option. On Apple platforms, apps need the multicast networking
+         * entitlement to join groups.
+         *
+         * @param {string} multicastAddress
+         * @param {string=} [multicastInterface]
+         * @see {@link https://nodejs.org/api/dgram.html#socketaddmembershipmulticastaddress-multicastinterface}
+         */
+        addMembership(multicastAddress: string, multicastInterface?: string | undefined): void;
+        /**
+         * Instructs the kernel to leave a multicast group at `multicastAddress`
+         * using the IP_DROP_MEMBERSHIP socket option.
+         *
+         * @param {string} multicastAddress
+         * @param {string=} [multicastInterface]
+         * @see {@link https://nodejs.org/api/dgram.html#socketdropmembershipmulticastaddress-multicastinterface}
+         */
+        dropMembership(multicastAddress: string, multicastInterface?: string | undefined): void;
+        /**
+         * Tells the kernel to join a source-specific multicast channel at the
+         * given `sourceAddress` and `groupAddress`, using the `multicastInterface`
+         * with the IP_ADD_SOURCE_MEMBERSHIP socket option.
+         *
+         * @param {string} sourceAddress
+         * @param {string} groupAddress
+         * @param {string=} [multicastInterface]
+         * @see {@link https://nodejs.org/api/dgram.html#socketaddsourcespecificmembershipsourceaddress-groupaddress-multicastinterface}
+         */
+        addSourceSpecificMembership(sourceAddress: string, groupAddress: string, multicastInterface?: string | undefined): void;
+        /**
+         * Instructs the kernel to leave a source-specific multicast channel at the
+         * given `sourceAddress` and `groupAddress` using the
+         * IP_DROP_SOURCE_MEMBERSHIP socket option.
+         *
+         * @param {string} sourceAddress
+         * @param {string} groupAddress
+         * @param {string=} [multicastInterface]
+         * @see {@link https://nodejs.org/api/dgram.html#socketdropsourcespecificmembershipsourceaddress-groupaddress-multicastinterface}
+         */
+        dropSourceSpecificMembership(sourceAddress: string, groupAddress: string, multicastInterface?: string | undefined): void;
+        /**
+         * Marks sent datagrams with a differentiated services code point using the
+         * IP_TOS (or IPV6_TCLASS) socket option. Not supported on Windows.
+         *
+         * @param {number} dscp - A number between 0 and 63
+         * @returns {number}
+         */
+        setDSCP(dscp: number): number;
         ref(): this;
         unref(): this;
     }
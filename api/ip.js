@@ -22,12 +22,27 @@
  * console.log(ip.isIPv4([0, 1, 2, 3, 4]))) // false
  * console.log(ip.isIPv4([-1])) // false
  * console.log(ip.isIPv4(Uint8Array.from([127, 0, 0, 01])) false
+ *
+ * console.log(ip.isIPv6('::1')) // true
+ * console.log(ip.isIPv6('::ffff:127.0.0.1')) // true
+ * console.log(ip.isIPv6('fe80::1%eth0')) // true
+ * console.log(ip.isIPv6('1:::2')) // false
  * ```
  */
 
 const ipv4SegmentPattern = '(?:[0-9]|[1-9][0-9]|1[0-9][0-9]|2[0-4][0-9]|25[0-5])'
 const ipv4StringPattern = `(${ipv4SegmentPattern}[.]){3}${ipv4SegmentPattern}`
 const iPv4Regex = new RegExp(`^${ipv4StringPattern}$`)
+const iPv6GroupRegex = /^[0-9a-fA-F]{1,4}$/
+
+/**
+ * @ignore
+ * @param {string} group
+ * @return {boolean}
+ */
+function isIPv6Group (group) {
+  return iPv6GroupRegex.test(group)
+}
 
 /**
  * Normalizes an IPv4 address string.
@@ -81,7 +96,73 @@ export function isIPv4 (input) {
   return iPv4Regex.test(normalizeIPv4(input))
 }
 
+/**
+ * Determines if an input `string` is in IP address version 6 format,
+ * including compressed (`::`) forms, embedded IPv4 addresses and zone
+ * indices (`fe80::1%eth0`).
+ * @param {string} input
+ * @return {boolean}
+ */
+export function isIPv6 (input) {
+  if (typeof input !== 'string' || !input.includes(':')) {
+    return false
+  }
+
+  let address = input
+  const zone = address.indexOf('%')
+
+  if (zone > -1) {
+    if (zone === address.length - 1) {
+      return false
+    }
+
+    address = address.slice(0, zone)
+  }
+
+  // an embedded IPv4 address takes the place of the last two groups
+  const lastColon = address.lastIndexOf(':')
+  const tail = address.slice(lastColon + 1)
+  if (tail.includes('.')) {
+    if (!iPv4Regex.test(tail)) {
+      return false
+    }
+
+    address = address.slice(0, lastColon + 1) + '0:0'
+  }
+
+  const parts = address.split('::')
+  const groups = (part) => part === '' ? [] : part.split(':')
+
+  if (parts.length > 2) {
+    return false
+  }
+
+  if (parts.length === 1) {
+    const all = groups(parts[0])
+    return all.length === 8 && all.every(isIPv6Group)
+  }
+
+  const head = groups(parts[0])
+  const rest = groups(parts[1])
+  return head.length + rest.length <= 7 && head.concat(rest).every(isIPv6Group)
+}
+
+/**
+ * Determines if an input `string` is an IPv4 or IPv6 address and returns
+ * its version, or `0` if it is neither.
+ * @param {string} input
+ * @return {number}
+ */
+export function isIP (input) {
+  // checked first as `isIPv4()` normalizes inputs like `1::` to `0.0.0.1`
+  if (isIPv6(input)) return 6
+  if (isIPv4(input)) return 4
+  return 0
+}
+
 export default {
   normalizeIPv4,
-  isIPv4
+  isIPv4,
+  isIPv6,
+  isIP
 }
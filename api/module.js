@@ -24,6 +24,7 @@ import extension from './extension.js'
 import fs from './fs.js'
 import gc from './gc.js'
 import ipc from './ipc.js'
+import net from './net.js'
 import os from './os.js'
 import { posix as path } from './path.js'
 import process from './process.js'
@@ -170,6 +171,7 @@ export const builtins = {
   gc,
   ipc,
   module: exports,
+  net,
   os,
   path,
   process,
@@ -0,0 +1,692 @@
+/**
+ * @module Net
+ *
+ * This module provides an implementation of TCP stream sockets and servers
+ * compatible with the `net.Socket` and `net.Server` interfaces of Node.js.
+ *
+ * Example usage:
+ * ```js
+ * import { createServer, connect } from 'socket:net'
+ * ```
+ */
+
+import { isArrayBufferView, isFunction } from './util.js'
+import { lookup } from './dns/promises.js'
+import { InternalError } from './errors.js'
+import { EventEmitter } from './events.js'
+import { isIP, isIPv4, isIPv6 } from './ip.js'
+import { Duplex } from './stream.js'
+import diagnostics from './diagnostics.js'
+import { rand64 } from './crypto.js'
+import { Buffer } from './buffer.js'
+import ipc from './ipc.js'
+
+import * as exports from './net.js'
+
+const dc = diagnostics.channels.group('net', [
+  'connect',
+  'connection',
+  'listening',
+  'close'
+])
+
+/**
+ * Resolves `host` to an IP address unless it already is one.
+ * @ignore
+ * @param {string} host
+ * @param {number=} [family]
+ * @return {Promise<string>}
+ */
+async function resolveAddress (host, family) {
+  if (isIP(host)) {
+    return host
+  }
+
+  const result = await lookup(host, family || 4)
+  return result?.address ?? result
+}
+
+function createDataListener (socket) {
+  // subscribe this socket to the firehose
+  globalThis.addEventListener('data', ondata)
+  return ondata
+
+  function ondata ({ detail }) {
+    const { err, data, source } = detail.params
+
+    if (source !== 'tcp.readStart') return
+
+    if (err?.id && BigInt(err.id) === socket.id) {
+      return socket.destroy(makeSocketError(err))
+    }
+
+    if (!data?.id || BigInt(data.id) !== socket.id) return
+
+    if (data.EOF) {
+      socket.push(null)
+    } else if (detail.data) {
+      const buffer = Buffer.from(detail.data)
+      socket.bytesRead += buffer.length
+      socket._resetTimeout()
+
+      // pause reading natively until the readable buffer drains
+      if (!socket.push(buffer)) {
+        socket._pauseReading()
+      }
+    }
+  }
+}
+
+function destroyDataListener (target) {
+  if (typeof target?.dataListener === 'function') {
+    globalThis.removeEventListener('data', target.dataListener)
+    delete target.dataListener
+  }
+}
+
+function makeSocketError (err) {
+  if (err instanceof Error) {
+    return err
+  }
+
+  const error = new Error(err?.message || 'Socket error')
+  error.code = err?.code
+  return error
+}
+
+/**
+ * A TCP stream socket.
+ * @see {@link https://nodejs.org/api/net.html#class-netsocket}
+ */
+export class Socket extends Duplex {
+  /**
+   * `Socket` class constructor.
+   * @param {object=} [options]
+   * @param {boolean=} [options.allowHalfOpen=false] - If `false`, the socket ends the writable side when the readable side ends.
+   * @param {boolean=} [options.noDelay=false] - If `true`, disables Nagle's algorithm once connected.
+   * @param {boolean=} [options.keepAlive=false] - If `true`, enables keep-alive probes once connected.
+   * @param {number=} [options.keepAliveInitialDelay=0] - Idle milliseconds before the first keep-alive probe.
+   */
+  constructor (options = {}) {
+    super({ highWaterMark: options.highWaterMark })
+
+    this.id = options.id ? BigInt(options.id) : rand64()
+    this.allowHalfOpen = options.allowHalfOpen === true
+    this.connecting = false
+    this.pending = !options.id
+    this.bytesRead = 0
+    this.bytesWritten = 0
+    this.remoteAddress = options.remoteAddress
+    this.remotePort = options.remotePort
+    this.remoteFamily = options.remoteFamily
+    this.localAddress = undefined
+    this.localPort = undefined
+
+    this.timeout = 0
+
+    this._connected = Boolean(options.id)
+    this._connection = null
+    this._reading = false
+    this._paused = false
+    this._timer = null
+    // `tcp.setOptions` parameters waiting for a connection
+    this._socketOptions = {}
+
+    this.dataListener = createDataListener(this)
+
+    if (options.noDelay) {
+      this.setNoDelay(true)
+    }
+
+    if (options.keepAlive) {
+      this.setKeepAlive(true, options.keepAliveInitialDelay)
+    }
+
+    this.once('end', () => {
+      if (!this.allowHalfOpen) {
+        this.end()
+      }
+    })
+  }
+
+  /**
+   * The state of the socket, like `net.Socket#readyState`.
+   * @type {string}
+   */
+  get readyState () {
+    if (this.connecting) return 'opening'
+    if (this.destroyed) return 'closed'
+    if (!this._connected) return 'closed'
+    return 'open'
+  }
+
+  /**
+   * Connects the socket to `port` on `host` (default: `'127.0.0.1'`).
+   * @param {number|object} port - A port or an object of `port` and `host`
+   * @param {string=} [host]
+   * @param {function=} [callback] - Attached as a listener for 'connect' events.
+   * @return {Socket}
+   */
+  connect (port, host, callback) {
+    let options = port
+
+    if (typeof options !== 'object' || options === null) {
+      options = { port, host }
+    } else {
+      callback = host
+    }
+
+    if (isFunction(options.host)) {
+      callback = options.host
+      options.host = undefined
+    }
+
+    if (isFunction(callback)) {
+      this.once('connect', callback)
+    }
+
+    const portNumber = parseInt(options.port)
+    if (!Number.isInteger(portNumber) || portNumber < 0 || portNumber >= 64 * 1024) {
+      throw new RangeError(`Port should be >= 0 and < 65536. Received ${options.port}.`)
+    }
+
+    this.connecting = true
+    this._connection = this._connect(portNumber, options.host || '127.0.0.1', options.family)
+    return this
+  }
+
+  async _connect (port, host, family) {
+    try {
+      const address = await resolveAddress(host, family)
+      const result = await ipc.request('tcp.connect', {
+        id: this.id,
+        port,
+        address
+      })
+
+      if (result.err) {
+        throw makeSocketError(result.err)
+      }
+
+      this.connecting = false
+      this.pending = false
+      this._connected = true
+      this.remoteAddress = result.data.address
+      this.remotePort = result.data.port
+      this.remoteFamily = result.data.family
+      this.localAddress = result.data.localAddress
+      this.localPort = result.data.localPort
+
+      this._applySocketOptions()
+      this._resetTimeout()
+      this.emit('connect')
+      this.emit('ready')
+      dc.channel('connect').publish({ socket: this, port, address })
+    } catch (err) {
+      this.connecting = false
+      this.destroy(err)
+    }
+  }
+
+  _open (cb) {
+    if (this._connected) {
+      return cb(null)
+    }
+
+    if (!this._connection) {
+      return cb(new ERR_SOCKET_NOT_CONNECTED())
+    }
+
+    this._connection.then(() => {
+      cb(this._connected ? null : new ERR_SOCKET_NOT_CONNECTED())
+    })
+  }
+
+  _read (cb) {
+    if (this._paused || !this._reading) {
+      this._paused = false
+      this._reading = true
+      ipc.request('tcp.readStart', { id: this.id }).then((result) => {
+        cb(result.err ? makeSocketError(result.err) : null)
+      }, cb)
+    } else {
+      cb(null)
+    }
+  }
+
+  _pauseReading () {
+    if (this._reading && !this._paused) {
+      this._paused = true
+      ipc.request('tcp.readStop', { id: this.id })
+    }
+  }
+
+  _writev (batch, cb) {
+    const buffers = batch.map((chunk) => {
+      if (typeof chunk === 'string') return Buffer.from(chunk)
+      if (isArrayBufferView(chunk)) {
+        return Buffer.from(chunk.buffer, chunk.byteOffset, chunk.byteLength)
+      }
+
+      return Buffer.from(chunk)
+    })
+
+    // queued chunks are coalesced into a single native write
+    const buffer = buffers.length === 1 ? buffers[0] : Buffer.concat(buffers)
+
+    ipc.write('tcp.write', { id: this.id }, buffer).then((result) => {
+      if (result.err) {
+        return cb(makeSocketError(result.err))
+      }
+
+      this.bytesWritten += buffer.length
+      this._resetTimeout()
+      cb(null)
+    }, cb)
+  }
+
+  _final (cb) {
+    ipc.request('tcp.shutdown', { id: this.id }).then((result) => {
+      // the peer may already be gone, which is not an error when ending
+      if (result.err && result.err.code !== 'ENOTCONN') {
+        return cb(makeSocketError(result.err))
+      }
+
+      cb(null)
+    }, cb)
+  }
+
+  _destroy (cb) {
+    destroyDataListener(this)
+    clearTimeout(this._timer)
+    this._timer = null
+
+    if (!this._connected && !this.connecting) {
+      return cb(null)
+    }
+
+    this._connected = false
+    ipc.request('tcp.close', { id: this.id }).then(() => {
+      dc.channel('close').publish({ socket: this })
+      cb(null)
+    }, () => cb(null))
+  }
+
+  /**
+   * Returns the bound address of the socket.
+   * @return {{ address: string, port: number, family: string }}
+   */
+  address () {
+    return {
+      address: this.localAddress,
+      port: this.localPort,
+      family: isIPv6(this.localAddress) ? 'IPv6' : 'IPv4'
+    }
+  }
+
+  /**
+   * Half-closes the socket, like `net.Socket#end()`.
+   * @param {(string|Buffer)=} [data]
+   * @param {function=} [callback]
+   * @return {Socket}
+   */
+  end (data, callback) {
+    if (isFunction(data)) {
+      callback = data
+      data = undefined
+    }
+
+    if (isFunction(callback)) {
+      this.once('finish', callback)
+    }
+
+    return super.end(data)
+  }
+
+  /**
+   * Enables or disables Nagle's algorithm (`TCP_NODELAY`), like
+   * `net.Socket#setNoDelay()`. Applied once connected.
+   * @param {boolean=} [noDelay=true]
+   * @return {Socket}
+   */
+  setNoDelay (noDelay = true) {
+    this._socketOptions.noDelay = noDelay !== false
+
+    if (this._connected) {
+      this._applySocketOptions()
+    }
+
+    return this
+  }
+
+  /**
+   * Enables or disables keep-alive probes (`SO_KEEPALIVE`), like
+   * `net.Socket#setKeepAlive()`. Applied once connected.
+   * @param {boolean=} [enable=false]
+   * @param {number=} [initialDelay=0] - Idle milliseconds before the first
+   * probe, `0` for the default of 60 seconds
+   * @return {Socket}
+   */
+  setKeepAlive (enable = false, initialDelay = 0) {
+    this._socketOptions.keepAlive = Boolean(enable)
+
+    if (Number.isFinite(initialDelay) && initialDelay >= 1000) {
+      this._socketOptions.keepAliveDelay = Math.floor(initialDelay / 1000)
+    }
+
+    if (this._connected) {
+      this._applySocketOptions()
+    }
+
+    return this
+  }
+
+  /**
+   * Emits 'timeout' after `timeout` milliseconds without reads or writes,
+   * like `net.Socket#setTimeout()`. The socket is not closed. A `timeout`
+   * of `0` disables the idle timer.
+   * @param {number} timeout
+   * @param {function=} [callback] - Attached as a listener for 'timeout' events.
+   * @return {Socket}
+   */
+  setTimeout (timeout, callback) {
+    if (!Number.isFinite(timeout) || timeout < 0) {
+      throw new RangeError(`The "timeout" argument must be a number >= 0. Received ${timeout}`)
+    }
+
+    this.timeout = timeout
+
+    if (isFunction(callback)) {
+      if (timeout === 0) {
+        this.removeListener('timeout', callback)
+      } else {
+        this.once('timeout', callback)
+      }
+    }
+
+    this._resetTimeout()
+    return this
+  }
+
+  /**
+   * The runtime does not exit while sockets are open, so there is no event
+   * loop reference to keep or release. Kept for `net.Socket` compatibility.
+   * @return {Socket}
+   */
+  ref () {
+    return this
+  }
+
+  /**
+   * @see {Socket#ref}
+   * @return {Socket}
+   */
+  unref () {
+    return this
+  }
+
+  _applySocketOptions () {
+    const params = { id: this.id, ...this._socketOptions }
+    this._socketOptions = {}
+
+    if (Object.keys(params).length === 1) {
+      return
+    }
+
+    // like node, failing to set an option does not fail the socket
+    ipc.request('tcp.setOptions', params).catch(() => {})
+  }
+
+  _resetTimeout () {
+    clearTimeout(this._timer)
+    this._timer = null
+
+    if (this.timeout > 0 && !this.destroyed) {
+      this._timer = setTimeout(() => {
+        this._timer = null
+        this.emit('timeout')
+      }, this.timeout)
+    }
+  }
+}
+
+/**
+ * A TCP server.
+ * @see {@link https://nodejs.org/api/net.html#class-netserver}
+ */
+export class Server extends EventEmitter {
+  /**
+   * `Server` class constructor.
+   * @param {object|function=} [options]
+   * @param {function=} [connectionListener] - Attached as a listener for 'connection' events.
+   */
+  constructor (options, connectionListener) {
+    super()
+
+    if (isFunction(options)) {
+      connectionListener = options
+      options = {}
+    }
+
+    this.id = rand64()
+    this.options = { ...options }
+    this.listening = false
+    this.connections = new Set()
+    this.dataListener = null
+    this._address = null
+
+    if (isFunction(connectionListener)) {
+      this.on('connection', connectionListener)
+    }
+  }
+
+  /**
+   * Starts listening for connections.
+   * @param {number|object} port - A port or an object of `port`, `host`, `backlog` and `ipv6Only`
+   * @param {string=} [host]
+   * @param {number=} [backlog]
+   * @param {function=} [callback] - Attached as a listener for 'listening' events.
+   * @return {Server}
+   */
+  listen (port, host, backlog, callback) {
+    let options = port
+
+    if (typeof options !== 'object' || options === null) {
+      options = { port, host, backlog }
+    } else {
+      callback = host
+    }
+
+    for (const arg of [options.host, options.backlog]) {
+      if (isFunction(arg)) callback = arg
+    }
+
+    if (isFunction(options.host)) options.host = undefined
+    if (isFunction(options.backlog)) options.backlog = undefined
+
+    if (isFunction(callback)) {
+      this.once('listening', callback)
+    }
+
+    this._listen(options).catch((err) => this.emit('error', err))
+    return this
+  }
+
+  async _listen (options) {
+    const address = options.host
+      ? await resolveAddress(options.host)
+      : (options.ipv6Only ? '::' : '0.0.0.0')
+
+    this.dataListener = this._createDataListener()
+
+    const params = {
+      id: this.id,
+      port: options.port || 0,
+      address
+    }
+
+    if (Number.isInteger(options.backlog)) {
+      params.backlog = options.backlog
+    }
+
+    if (options.ipv6Only) {
+      params.ipv6Only = true
+    }
+
+    const result = await ipc.request('tcp.listen', params)
+
+    if (result.err) {
+      destroyDataListener(this)
+      throw makeSocketError(result.err)
+    }
+
+    this.listening = true
+    this._address = {
+      address: result.data.address,
+      family: result.data.family,
+      port: result.data.port
+    }
+
+    this.emit('listening')
+    dc.channel('listening').publish({ server: this, ...this._address })
+  }
+
+  _createDataListener () {
+    const ondata = ({ detail }) => {
+      const { err, data, source } = detail.params
+
+      if (source !== 'tcp.listen') return
+
+      if (err?.id && BigInt(err.id) === this.id) {
+        return this.emit('error', makeSocketError(err))
+      }
+
+      if (!data?.id || BigInt(data.id) !== this.id) return
+
+      if (data.event === 'connection') {
+        const socket = new Socket({
+          ...this.options,
+          id: data.connection,
+          remoteAddress: data.address,
+          remotePort: data.port,
+          remoteFamily: data.family
+        })
+
+        socket.localAddress = this._address?.address
+        socket.localPort = this._address?.port
+
+        this.connections.add(socket)
+        socket.once('close', () => this.connections.delete(socket))
+
+        this.emit('connection', socket)
+        dc.channel('connection').publish({ server: this, socket })
+      }
+    }
+
+    globalThis.addEventListener('data', ondata)
+    return ondata
+  }
+
+  /**
+   * Returns the bound address of the server.
+   * @return {{ address: string, port: number, family: string }|null}
+   */
+  address () {
+    return this._address
+  }
+
+  /**
+   * Stops the server from accepting new connections.
+   * @param {function=} [callback] - Called when the server is closed.
+   * @return {Server}
+   */
+  close (callback) {
+    if (!this.listening) {
+      const err = new ERR_SERVER_NOT_RUNNING()
+      if (isFunction(callback)) {
+        queueMicrotask(() => callback(err))
+      }
+
+      return this
+    }
+
+    this.listening = false
+    destroyDataListener(this)
+
+    ipc.request('tcp.close', { id: this.id }).then((result) => {
+      const err = result.err ? makeSocketError(result.err) : null
+      if (isFunction(callback)) callback(err)
+      this.emit('close')
+      dc.channel('close').publish({ server: this })
+    })
+
+    return this
+  }
+
+  /**
+   * Calls `callback` with the number of open connections.
+   * @param {function} callback
+   */
+  getConnections (callback) {
+    queueMicrotask(() => callback(null, this.connections.size))
+  }
+
+  /**
+   * @see {Socket#ref}
+   * @return {Server}
+   */
+  ref () {
+    return this
+  }
+
+  /**
+   * @see {Socket#ref}
+   * @return {Server}
+   */
+  unref () {
+    return this
+  }
+}
+
+/**
+ * Creates a new TCP server.
+ * @param {object|function=} [options]
+ * @param {function=} [connectionListener]
+ * @return {Server}
+ */
+export function createServer (options, connectionListener) {
+  return new Server(options, connectionListener)
+}
+
+/**
+ * Creates a new TCP socket and connects it.
+ * @param {number|object} port - A port or an object of `port` and `host`
+ * @param {string=} [host]
+ * @param {function=} [callback] - Attached as a listener for 'connect' events.
+ * @return {Socket}
+ */
+export function connect (port, host, callback) {
+  const options = typeof port === 'object' && port !== null ? port : {}
+  const socket = new Socket(options)
+  return socket.connect(port, host, callback)
+}
+
+export const createConnection = connect
+
+export { isIP, isIPv4, isIPv6 }
+
+export class ERR_SOCKET_NOT_CONNECTED extends InternalError {
+  constructor () {
+    super('Socket is not connected')
+    this.code = 'ERR_SOCKET_NOT_CONNECTED'
+  }
+}
+
+export class ERR_SERVER_NOT_RUNNING extends InternalError {
+  constructor () {
+    super('Server is not running')
+    this.code = 'ERR_SERVER_NOT_RUNNING'
+  }
+}
+
+export default exports
@@ -29,6 +29,7 @@ const SOCKET_NODE_DIR = 'npm/packages/@socketsupply/socket-node'
     'fs/promises.js',
     'ipc.js',
     // 'location.js',
+    'net.js',
     'network.js',
     'os.js',
     'path/path.js',
@@ -651,6 +651,19 @@ SOCKET_RUNTIME_EXTENSION_EXTERN_BEGIN
     const char* source
   );
 
+  /**
+   * Parses a JSON source string.
+   * @param context - A context associated with the extension
+   * @param source  - The JSON source string
+   * @return The parsed JSON value or `NULL` if `source` is not valid JSON,
+   * in which case the error is set on `context`
+   */
+  SOCKET_RUNTIME_EXTENSION_EXPORT
+  sapi_json_any_t* sapi_json_parse (
+    sapi_context_t* context,
+    const char* source
+  );
+
   /**
    * Set JSON `value` for JSON `object` at `key`.
    * @param object - The object to set a value on
@@ -665,7 +678,10 @@ SOCKET_RUNTIME_EXTENSION_EXTERN_BEGIN
   );
 
   /**
-   * Get JSON `value` for JSON `object` at `key`.
+   * Get JSON `value` for JSON `object` at `key`. The value is a copy owned
+   * by the context of `object` and is not changed by later changes to `object`.
+   * Nested objects and arrays are copied with it, so get a nested value once
+   * instead of on every access.
    * @param object - The object to set a value on
    * @param key    - The key of the value to set
    * @return The JSON value to set
@@ -690,7 +706,10 @@ SOCKET_RUNTIME_EXTENSION_EXTERN_BEGIN
   );
 
   /**
-   * Get JSON `value` for JSON `array` at `index`.
+   * Get JSON `value` for JSON `array` at `index`. The value is a copy owned
+   * by the context of `array` and is not changed by later changes to `array`.
+   * Nested objects and arrays are copied with it, so get a nested value once
+   * instead of on every access.
    * @param array - The array to set a value on
    * @param index - The index of the value to set
    * @return The JSON value to set
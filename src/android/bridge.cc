@@ -99,7 +99,7 @@ extern "C" {
       env->GetByteArrayRegion(byteArray, 0, size, (jbyte*) input);
     }
 
-    auto routed = bridge->route(uri.str(), input, size, [=](auto result) mutable {
+    auto routed = bridge->route(uri.str(), input, size, [=](const auto& result) mutable {
       if (result.seq == "-1") {
         bridge->router.send(result.seq, result.str(), result.post);
         return;
@@ -121,7 +121,7 @@ extern "C" {
         auto seq = env->NewStringUTF(result.seq.c_str());
         auto source = env->NewStringUTF(result.source.c_str());
         auto value = env->NewStringUTF(result.str().c_str());
-        auto headers = env->NewStringUTF(result.post.headers.c_str());
+        auto headers = env->NewStringUTF(result.post.headers.str().c_str());
 
         CallVoidClassMethodFromEnvironment(
           env,
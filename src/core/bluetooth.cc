@@ -371,7 +371,7 @@ using namespace SSC;
   post.id = rand64();
   post.body = bytes;
   post.length = length;
-  post.headers = headers.str();
+  post.headers = std::move(headers);
 
   auto json = JSON::Object::Entries {
     {"data", JSON::Object::Entries {
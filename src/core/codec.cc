@@ -1,6 +1,15 @@
 #include "codec.hh"
 #include "string.hh"
-#include <math.h>
+#include <string.h>
+
+// 16 byte vectors for scanning runs of bytes that are copied as they are
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CODEC_USE_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define CODEC_USE_NEON 1
+#endif
 
 #define UNSIGNED_IN_RANGE(value, min, max) (                                   \
   (unsigned char) (value) >= (unsigned char) (min) &&                          \
@@ -37,6 +46,32 @@ static const signed char HEX2DEC[256] = {
   /* F */ -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1
 };
 
+static const char BASE64[64 + 1] =
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static const signed char BASE642DEC[256] = {
+  /*       0  1  2  3   4  5  6  7   8  9  A  B   C  D  E  F */
+  /* 0 */ -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1,
+  /* 1 */ -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1,
+  /* 2 */ -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,62, -1,-1,-1,63,
+  /* 3 */ 52,53,54,55, 56,57,58,59, 60,61,-1,-1, -1,-1,-1,-1,
+
+  /* 4 */ -1, 0, 1, 2,  3, 4, 5, 6,  7, 8, 9,10, 11,12,13,14,
+  /* 5 */ 15,16,17,18, 19,20,21,22, 23,24,25,-1, -1,-1,-1,-1,
+  /* 6 */ -1,26,27,28, 29,30,31,32, 33,34,35,36, 37,38,39,40,
+  /* 7 */ 41,42,43,44, 45,46,47,48, 49,50,51,-1, -1,-1,-1,-1,
+
+  /* 8 */ -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1,
+  /* 9 */ -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1,
+  /* A */ -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1,
+  /* B */ -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1,
+
+  /* C */ -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1,
+  /* D */ -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1,
+  /* E */ -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1,
+  /* F */ -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1
+};
+
 static const char SAFE[256] = {
   /*      0 1 2 3  4 5 6 7  8 9 A B  C D E F */
   /* 0 */ 0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0,
@@ -75,107 +110,479 @@ namespace SSC {
     return bytes;
   }
 
+  // the number of leading bytes in `input` that `encodeURIComponent()`
+  // keeps as they are, which are ASCII letters and digits
+  static size_t countSafeBytes (const unsigned char* input, size_t length) {
+    size_t i = 0;
+
+  #if defined(CODEC_USE_SSE2)
+    // `b - lower <= range` as unsigned bytes is `min(b - lower, range) == b - lower`
+    const auto zero = _mm_set1_epi8('0');
+    const auto digits = _mm_set1_epi8(9);
+    const auto a = _mm_set1_epi8('a');
+    const auto letters = _mm_set1_epi8(25);
+    const auto lowercase = _mm_set1_epi8(0x20);
+
+    for (; i + 16 <= length; i += 16) {
+      const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+      const auto digit = _mm_sub_epi8(bytes, zero);
+      const auto letter = _mm_sub_epi8(_mm_or_si128(bytes, lowercase), a);
+      const auto safe = _mm_or_si128(
+        _mm_cmpeq_epi8(_mm_min_epu8(digit, digits), digit),
+        _mm_cmpeq_epi8(_mm_min_epu8(letter, letters), letter)
+      );
+
+      if (_mm_movemask_epi8(safe) != 0xFFFF) {
+        break;
+      }
+    }
+  #elif defined(CODEC_USE_NEON)
+    const auto zero = vdupq_n_u8('0');
+    const auto digits = vdupq_n_u8(9);
+    const auto a = vdupq_n_u8('a');
+    const auto letters = vdupq_n_u8(25);
+    const auto lowercase = vdupq_n_u8(0x20);
+
+    for (; i + 16 <= length; i += 16) {
+      const auto bytes = vld1q_u8(input + i);
+      const auto safe = vorrq_u8(
+        vcleq_u8(vsubq_u8(bytes, zero), digits),
+        vcleq_u8(vsubq_u8(vorrq_u8(bytes, lowercase), a), letters)
+      );
+
+      if (vminvq_u8(safe) != 0xFF) {
+        break;
+      }
+    }
+  #endif
+
+    while (i < length && SAFE[input[i]]) {
+      i++;
+    }
+
+    return i;
+  }
+
+  // the number of leading bytes in `input` that `decodeURIComponent()`
+  // keeps as they are, which are all but '%' and '+'
+  static size_t countPlainBytes (const unsigned char* input, size_t length) {
+    size_t i = 0;
+
+  #if defined(CODEC_USE_SSE2)
+    const auto percent = _mm_set1_epi8('%');
+    const auto plus = _mm_set1_epi8('+');
+
+    for (; i + 16 <= length; i += 16) {
+      const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+      const auto special = _mm_or_si128(
+        _mm_cmpeq_epi8(bytes, percent),
+        _mm_cmpeq_epi8(bytes, plus)
+      );
+
+      if (_mm_movemask_epi8(special) != 0) {
+        break;
+      }
+    }
+  #elif defined(CODEC_USE_NEON)
+    const auto percent = vdupq_n_u8('%');
+    const auto plus = vdupq_n_u8('+');
+
+    for (; i + 16 <= length; i += 16) {
+      const auto bytes = vld1q_u8(input + i);
+      const auto special = vorrq_u8(vceqq_u8(bytes, percent), vceqq_u8(bytes, plus));
+
+      if (vmaxvq_u8(special) != 0) {
+        break;
+      }
+    }
+  #endif
+
+    while (i < length && input[i] != '%' && input[i] != '+') {
+      i++;
+    }
+
+    return i;
+  }
+
   String encodeURIComponent (const String& input) {
-    auto pointer = (unsigned char*) input.c_str();
-    const auto length = (int) input.length();
-    auto const start = new unsigned char[length* 3];
-    auto end = start;
-    const unsigned char* const maxLength = pointer + length;
-
-    for (; pointer < maxLength; ++pointer) {
-      if (SAFE[*pointer]) {
-        *end++ = *pointer;
-      } else {
-        // escape this char
+    const auto bytes = reinterpret_cast<const unsigned char*>(input.data());
+    const auto length = input.size();
+    auto i = countSafeBytes(bytes, length);
+
+    if (i == length) {
+      return input;
+    }
+
+    // room for every byte after the first unsafe one to be escaped
+    String output(i + (length - i) * 3, '\0');
+    auto end = output.data() + i;
+    memcpy(output.data(), bytes, i);
+
+    while (i < length) {
+      while (i < length && !SAFE[bytes[i]]) {
         *end++ = '%';
-        *end++ = DEC2HEX[*pointer >> 4];
-        *end++ = DEC2HEX[*pointer & 0x0F];
+        *end++ = DEC2HEX[bytes[i] >> 4];
+        *end++ = DEC2HEX[bytes[i] & 0x0F];
+        i++;
       }
+
+      const auto run = countSafeBytes(bytes + i, length - i);
+      memcpy(end, bytes + i, run);
+      end += run;
+      i += run;
     }
 
-    String result((char*) start, (char*) end);
-    delete [] start;
-    return result;
+    output.resize(end - output.data());
+    return output;
   }
 
-  String decodeURIComponent (const String& input) {
+  size_t decodeURIComponent (char *output, const char *input, size_t length) {
     // Note from RFC1630:  "Sequences which start with a percent sign
     // but are not followed by two hexadecimal characters (0-9, A-F) are reserved
     // for future extension"
+    const auto bytes = reinterpret_cast<const unsigned char*>(input);
+    size_t size = 0;
+    size_t i = 0;
+
+    while (i < length) {
+      const auto run = countPlainBytes(bytes + i, length - i);
 
-    const auto string = replace(input, "\\+", " ");
-    auto pointer = (const unsigned char *) string.c_str();
-    const auto length = (int) string.length();
-    const auto maxLength = pointer + length;
+      // decoding in place does not move bytes until the first escape
+      if (run > 0 && output + size != input + i) {
+        memmove(output + size, input + i, run);
+      }
+
+      size += run;
+      i += run;
+
+      if (i == length) {
+        break;
+      }
 
-    char* const start = new char[length];
-    char* end = start;
+      if (bytes[i] == '+') {
+        output[size++] = ' ';
+        i++;
+        continue;
+      }
 
-    while (pointer < maxLength - 2) {
-      if (*pointer == '%') {
-        char dec1, dec2;
-        if (-1 != (dec1 = HEX2DEC[*(pointer + 1)])
-            && -1 != (dec2 = HEX2DEC[*(pointer + 2)])) {
+      if (i + 2 < length) {
+        const auto hi = HEX2DEC[bytes[i + 1]];
+        const auto lo = HEX2DEC[bytes[i + 2]];
 
-            *end++ = (dec1 << 4) + dec2;
-            pointer += 3;
-            continue;
+        if (hi != -1 && lo != -1) {
+          output[size++] = (hi << 4) + lo;
+          i += 3;
+          continue;
         }
       }
 
-      *end++ = *pointer++;
+      output[size++] = bytes[i++];
     }
 
-    // the last 2- chars
-    while (pointer < maxLength) {
-      *end++ = *pointer++;
-    }
+    return size;
+  }
 
-    String result(start, end);
-    delete [] start;
-    return result;
+  String decodeURIComponent (const String& input) {
+    auto output = input;
+    output.resize(decodeURIComponent(output.data(), output.data(), output.size()));
+    return output;
   }
 
   String encodeHexString (const String& input) {
-    String output;
-    auto length = 2 * input.length();
-
-    output.reserve(length);
+    const auto bytes = reinterpret_cast<const unsigned char*>(input.data());
+    const auto length = input.size();
+    String output(2 * length, '\0');
+    auto end = output.data();
+    size_t i = 0;
+
+  #if defined(CODEC_USE_SSE2)
+    // nibbles above 9 are letters, which start 7 characters after '9'
+    const auto mask = _mm_set1_epi8(0x0F);
+    const auto nine = _mm_set1_epi8(9);
+    const auto zero = _mm_set1_epi8('0');
+    const auto letters = _mm_set1_epi8('A' - '9' - 1);
+
+    for (; i + 16 <= length; i += 16) {
+      const auto bytes16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+      const auto hi = _mm_and_si128(_mm_srli_epi16(bytes16, 4), mask);
+      const auto lo = _mm_and_si128(bytes16, mask);
+      const auto hiChars = _mm_add_epi8(
+        _mm_add_epi8(hi, zero),
+        _mm_and_si128(_mm_cmpgt_epi8(hi, nine), letters)
+      );
+
+      const auto loChars = _mm_add_epi8(
+        _mm_add_epi8(lo, zero),
+        _mm_and_si128(_mm_cmpgt_epi8(lo, nine), letters)
+      );
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(end), _mm_unpacklo_epi8(hiChars, loChars));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(end + 16), _mm_unpackhi_epi8(hiChars, loChars));
+      end += 32;
+    }
+  #elif defined(CODEC_USE_NEON)
+    const auto table = vld1q_u8(reinterpret_cast<const uint8_t*>(DEC2HEX));
+    const auto mask = vdupq_n_u8(0x0F);
+
+    for (; i + 16 <= length; i += 16) {
+      const auto bytes16 = vld1q_u8(bytes + i);
+      const uint8x16x2_t chars = {{
+        vqtbl1q_u8(table, vshrq_n_u8(bytes16, 4)),
+        vqtbl1q_u8(table, vandq_u8(bytes16, mask))
+      }};
+
+      // stores the high and low nibble characters interleaved
+      vst2q_u8(reinterpret_cast<uint8_t*>(end), chars);
+      end += 32;
+    }
+  #endif
 
-    for (unsigned char character : input) {
-      output.push_back(DEC2HEX[character >> 4]);
-      output.push_back(DEC2HEX[character & 15]);
+    for (; i < length; ++i) {
+      *end++ = DEC2HEX[bytes[i] >> 4];
+      *end++ = DEC2HEX[bytes[i] & 0x0F];
     }
 
     return output;
   }
 
+#if defined(CODEC_USE_SSE2)
+  // converts 16 hex characters to their values, or returns `false` if
+  // any of them is not a hex character
+  static bool decodeHexNibbles (const __m128i chars, __m128i& nibbles) {
+    const auto digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const auto letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const auto isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    const auto isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+
+    if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xFFFF) {
+      return false;
+    }
+
+    nibbles = _mm_or_si128(
+      _mm_and_si128(isDigit, digit),
+      _mm_and_si128(isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10)))
+    );
+
+    return true;
+  }
+#elif defined(CODEC_USE_NEON)
+  static bool decodeHexNibbles (const uint8x16_t chars, uint8x16_t& nibbles) {
+    const auto digit = vsubq_u8(chars, vdupq_n_u8('0'));
+    const auto letter = vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    const auto isDigit = vcleq_u8(digit, vdupq_n_u8(9));
+    const auto isLetter = vcleq_u8(letter, vdupq_n_u8(5));
+
+    if (vminvq_u8(vorrq_u8(isDigit, isLetter)) != 0xFF) {
+      return false;
+    }
+
+    nibbles = vbslq_u8(isDigit, digit, vaddq_u8(letter, vdupq_n_u8(10)));
+    return true;
+  }
+#endif
+
   String decodeHexString (const String& input) {
-    const auto length = input.length() / 2;
-    String output;
+    const auto chars = reinterpret_cast<const unsigned char*>(input.data());
+    // a trailing odd character has no pair and is ignored
+    const auto length = input.size() / 2;
+    String output(length, '\0');
+    auto bytes = reinterpret_cast<unsigned char*>(output.data());
+    size_t i = 0;
+
+  #if defined(CODEC_USE_SSE2)
+    const auto low = _mm_set1_epi16(0x00FF);
+
+    for (; i + 16 <= length; i += 16) {
+      __m128i a;
+      __m128i b;
+
+      if (
+        !decodeHexNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + 2 * i)), a) ||
+        !decodeHexNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + 2 * i + 16)), b)
+      ) {
+        break;
+      }
 
-    output.reserve(length);
+      // each 16 bit lane holds a high nibble in its low byte and a low nibble in its high byte
+      a = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(a, low), 4), _mm_srli_epi16(a, 8));
+      b = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(b, low), 4), _mm_srli_epi16(b, 8));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes + i), _mm_packus_epi16(a, b));
+    }
+  #elif defined(CODEC_USE_NEON)
+    for (; i + 16 <= length; i += 16) {
+      // loads high nibble characters into `val[0]` and low ones into `val[1]`
+      const auto pairs = vld2q_u8(chars + 2 * i);
+      uint8x16_t hi;
+      uint8x16_t lo;
+
+      if (!decodeHexNibbles(pairs.val[0], hi) || !decodeHexNibbles(pairs.val[1], lo)) {
+        break;
+      }
+
+      vst1q_u8(bytes + i, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+    }
+  #endif
 
-    for (auto character = input.begin(); character != input.end();) {
-      const int hi = HEX2DEC[(unsigned char) *character++];
-      const int lo = HEX2DEC[(unsigned char) *character++];
-      output.push_back(hi << 4 | lo);
+    for (; i < length; ++i) {
+      const int hi = HEX2DEC[chars[2 * i]];
+      const int lo = HEX2DEC[chars[2 * i + 1]];
+      bytes[i] = hi << 4 | lo;
     }
 
     return output;
   }
 
+  String encodeBase64 (const String& input) {
+    const auto bytes = reinterpret_cast<const unsigned char*>(input.data());
+    const auto length = input.size();
+    String output(4 * ((length + 2) / 3), '\0');
+    auto end = output.data();
+    size_t i = 0;
+
+    for (; i + 3 <= length; i += 3) {
+      const uint32_t value = bytes[i] << 16 | bytes[i + 1] << 8 | bytes[i + 2];
+      end[0] = BASE64[value >> 18];
+      end[1] = BASE64[(value >> 12) & 0x3F];
+      end[2] = BASE64[(value >> 6) & 0x3F];
+      end[3] = BASE64[value & 0x3F];
+      end += 4;
+    }
+
+    if (i < length) {
+      const uint32_t value = bytes[i] << 16 | (i + 1 < length ? bytes[i + 1] << 8 : 0);
+      end[0] = BASE64[value >> 18];
+      end[1] = BASE64[(value >> 12) & 0x3F];
+      end[2] = i + 1 < length ? BASE64[(value >> 6) & 0x3F] : '=';
+      end[3] = '=';
+    }
+
+    return output;
+  }
+
+  size_t decodeBase64 (char *output, const char *input, size_t length) {
+    const auto chars = reinterpret_cast<const unsigned char*>(input);
+    auto bytes = reinterpret_cast<unsigned char*>(output);
+    size_t size = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= length; i += 4) {
+      const int32_t value = (
+        BASE642DEC[chars[i]] << 18 |
+        BASE642DEC[chars[i + 1]] << 12 |
+        BASE642DEC[chars[i + 2]] << 6 |
+        BASE642DEC[chars[i + 3]]
+      );
+
+      // any character outside of the alphabet sets the sign bit
+      if (value < 0) {
+        break;
+      }
+
+      bytes[size++] = value >> 16;
+      bytes[size++] = value >> 8;
+      bytes[size++] = value;
+    }
+
+    // a final group with padding, or the characters before an invalid one
+    uint32_t value = 0;
+    int count = 0;
+
+    for (; i < length && count < 4; ++i) {
+      const auto sextet = BASE642DEC[chars[i]];
+
+      if (sextet < 0) {
+        break;
+      }
+
+      value = value << 6 | sextet;
+      count++;
+    }
+
+    if (count >= 2) {
+      value <<= 6 * (4 - count);
+      bytes[size++] = value >> 16;
+
+      if (count >= 3) {
+        bytes[size++] = value >> 8;
+      }
+    }
+
+    return size;
+  }
+
+  String decodeBase64 (const String& input) {
+    String output(3 * (input.size() / 4) + 2, '\0');
+    output.resize(decodeBase64(output.data(), input.data(), input.size()));
+    return output;
+  }
+
+  // the number of leading bytes in `input` below 0x80, which
+  // `decodeUTF8()` copies as they are
+  static size_t countASCIIBytes (const unsigned char* input, size_t length) {
+    size_t i = 0;
+
+  #if defined(CODEC_USE_SSE2)
+    for (; i + 32 <= length; i += 32) {
+      const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+      const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i + 16));
+
+      if (_mm_movemask_epi8(_mm_or_si128(a, b)) != 0) {
+        break;
+      }
+    }
+  #elif defined(CODEC_USE_NEON)
+    for (; i + 32 <= length; i += 32) {
+      const auto bytes = vorrq_u8(vld1q_u8(input + i), vld1q_u8(input + i + 16));
+
+      if (vmaxvq_u8(bytes) >= 0x80) {
+        break;
+      }
+    }
+  #endif
+
+    for (; i + 8 <= length; i += 8) {
+      uint64_t word;
+      memcpy(&word, input + i, sizeof(word));
+
+      if (word & 0x8080808080808080ULL) {
+        break;
+      }
+    }
+
+    while (i < length && input[i] < 0x80) {
+      i++;
+    }
+
+    return i;
+  }
+
   size_t decodeUTF8 (char *output, const char *input, size_t length) {
-    unsigned char cp = 0; // code point
+    const auto bytes = reinterpret_cast<const unsigned char*>(input);
+    unsigned int cp = 0; // code point
     unsigned char lower = 0x80;
     unsigned char upper = 0xBF;
 
     int x = 0; // cp needed
     int y = 0; // cp  seen
-    int size = 0; // output size
+    size_t size = 0; // output size
+
+    for (size_t i = 0; i < length; ++i) {
+      if (x == 0) {
+        // 1 byte, in runs
+        const auto run = countASCIIBytes(bytes + i, length - i);
 
-    for (int i = 0; i < length; ++i) {
-      auto b = (unsigned char) input[i];
+        if (run > 0) {
+          memcpy(output + size, input + i, run);
+          size += run;
+          i += run;
+
+          if (i == length) {
+            break;
+          }
+        }
+      }
+
+      const auto b = bytes[i];
 
       if (b == 0) {
         output[size++] = 0;
@@ -183,12 +590,6 @@ namespace SSC {
       }
 
       if (x == 0) {
-        // 1 byte
-        if (UNSIGNED_IN_RANGE(b, 0x00, 0x7F)) {
-          output[size++] = b;
-          continue;
-        }
-
         if (!UNSIGNED_IN_RANGE(b, 0xC2, 0xF4)) {
           break;
         }
@@ -223,7 +624,7 @@ namespace SSC {
           cp = b - 0xF0;
         }
 
-        cp = cp * pow(64, x);
+        cp <<= 6 * x;
         continue;
       }
 
@@ -242,13 +643,14 @@ namespace SSC {
       lower = 0x80;
       upper = 0xBF;
       y++;
-      cp += (b - 0x80) * pow(64, x - y);
+      cp += (b - 0x80) << (6 * (x - y));
 
       if (y != x) {
         continue;
       }
 
-      output[size++] = cp;
+      // only the low byte of the code point is written
+      output[size++] = (unsigned char) cp;
       // continue to next
       cp = 0;
       x = 0;
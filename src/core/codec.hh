@@ -20,6 +20,17 @@ namespace SSC {
    */
   String decodeURIComponent (const String& input);
 
+  /**
+   * Decodes `length` bytes of `input` encoded with `encodeURIComponent` to
+   * `output` returning `size_t` bytes written to `output`, which is never
+   * more than `length`. `output` may be `input` to decode in place.
+   * @param output Pointer owned by caller to write decoded output to
+   * @param input Pointer owned by caller to decode `length` bytes
+   * @param length Size of `input` in bytes
+   * @return The number of bytes written to `output`
+   */
+  size_t decodeURIComponent (char *output, const char *input, size_t length);
+
   /**
    * Encodes input as a string of hex characters.
    * @param input The input string to encode
@@ -34,6 +45,32 @@ namespace SSC {
    */
   String decodeHexString (const String& input);
 
+  /**
+   * Encodes input as a padded base64 string (RFC 4648).
+   * @param input The input string to encode
+   * @return An encoded string value
+   */
+  String encodeBase64 (const String& input);
+
+  /**
+   * Decodes base64 string of variable `length` size in `input` to
+   * `output` returning `size_t` bytes written to `output`, which is never
+   * more than `length`. Decoding stops at padding or at the first character
+   * that is not in the base64 alphabet.
+   * @param output Pointer owned by caller to write decoded output to
+   * @param input Pointer owned by caller to decode `length` bytes
+   * @param length Size of `input` in bytes
+   * @return The number of bytes written to `output`
+   */
+  size_t decodeBase64 (char *output, const char *input, size_t length);
+
+  /**
+   * Decodes a base64 string to a normal string.
+   * @param input The input string to decode
+   * @return A decoded string value
+   */
+  String decodeBase64 (const String& input);
+
   /**
    * Decodes UTF8 byte string of variable `length` size in `input` to
    * `output` returning `size_t` bytes written to `output`.
@@ -8,6 +8,22 @@ namespace SSC {
   static constexpr char NAMESPACE_SEPARATOR = '.';
   static const String NAMESPACE_SEPARATOR_STRING = String(1, NAMESPACE_SEPARATOR);
 
+  // the namespace of `key`, which is everything before its last part
+  static StringView getKeyPrefix (StringView key) {
+    // a single trailing separator does not start an empty last part
+    if (key.ends_with(NAMESPACE_SEPARATOR)) {
+      key.remove_suffix(1);
+    }
+
+    const auto index = key.rfind(NAMESPACE_SEPARATOR);
+
+    if (index == StringView::npos) {
+      return key.substr(0, 0);
+    }
+
+    return trimView(key.substr(0, index));
+  }
+
   Config::Config (const String& source) {
     this->map = INI::parse(source, NAMESPACE_SEPARATOR_STRING);
   }
@@ -112,7 +128,7 @@ namespace SSC {
       bool compare = false;
     };
 
-    String query = trim(input);
+    String query(trimView(input));
     State state;
     Map results;
 
@@ -194,12 +210,8 @@ namespace SSC {
 
     const auto& path = join(state.paths, NAMESPACE_SEPARATOR_STRING);
     for (const auto& tuple : this->map) {
-      const auto parts = split(tuple.first, NAMESPACE_SEPARATOR_STRING);
       const auto& target = tuple.first;
-      const auto prefix = join(
-        Vector<String>(parts.begin(), parts.begin() + parts.size() - 1),
-        NAMESPACE_SEPARATOR_STRING
-      );
+      const auto prefix = getKeyPrefix(target);
 
       bool match = false;
       if (path.starts_with(NAMESPACE_SEPARATOR_STRING)) {
@@ -219,7 +231,7 @@ namespace SSC {
           state.targets.push_back(target);
           state.compare = false;
         } else if (state.compare || state.property.size() > 0) {
-          state.targets.push_back(prefix);
+          state.targets.emplace_back(prefix);
         } else {
           state.targets.push_back(target);
         }
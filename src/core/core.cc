@@ -1,55 +1,168 @@
 #include "core.hh"
 
-#define IMAX_BITS(m) ((m)/((m) % 255+1) / 255 % 255 * 8 + 7-86 / ((m) % 255+12))
-#define RAND_MAX_WIDTH IMAX_BITS(RAND_MAX)
+#include <random>
 
 namespace SSC {
-  uint64_t rand64 () {
-    uint64_t r = 0;
-    static bool init = false;
+  static uint64_t splitmix64 (uint64_t& state) {
+    auto z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  static inline uint64_t rotl (const uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  // xoshiro256** state for each thread, seeded from the OS
+  struct Rand64State {
+    uint64_t s[4];
+
+    Rand64State () {
+      uint64_t seed = std::hash<std::thread::id>{}(std::this_thread::get_id());
+      seed ^= std::chrono::high_resolution_clock::now().time_since_epoch().count();
+
+      try {
+        std::random_device device;
+        seed ^= (uint64_t) device() << 32 | device();
+      } catch (...) {
+        // the thread and time still give each thread its own sequence
+      }
 
-    if (!init) {
-      init = true;
-      srand(time(0));
+      for (auto& word : this->s) {
+        word = splitmix64(seed);
+      }
     }
+  };
 
-    for (int i = 0; i < 64; i += RAND_MAX_WIDTH) {
-      r <<= RAND_MAX_WIDTH;
-      r ^= (unsigned) rand();
+  uint64_t rand64 () {
+    static thread_local Rand64State state;
+    auto& s = state.s;
+    uint64_t result = 0;
+
+    // `0` means "no id" for posts and results
+    while (result == 0) {
+      result = rotl(s[1] * 5, 7) * 9;
+      const auto t = s[1] << 17;
+
+      s[2] ^= s[0];
+      s[3] ^= s[1];
+      s[1] ^= s[2];
+      s[0] ^= s[3];
+      s[2] ^= t;
+      s[3] = rotl(s[3], 45);
     }
-    return r;
-  }
 
+    return result;
+  }
 
   void msleep (uint64_t ms) {
     std::this_thread::yield();
     std::this_thread::sleep_for(std::chrono::milliseconds(ms));
   }
 
-  Headers::Header::Header (const Header& header) {
-    this->key = header.key;
-    this->value = header.value;
+  // common header names, matched by their index instead of their text
+  static constexpr StringView INTERNED_HEADER_NAMES[] = {
+    "", // not interned
+    "cache-control",
+    "connection",
+    "content-length",
+    "content-location",
+    "content-type",
+    "location",
+    "transfer-encoding"
+  };
+
+  static bool equalsIgnoreCase (const StringView left, const StringView right) {
+    if (left.size() != right.size()) {
+      return false;
+    }
+
+    for (size_t i = 0; i < left.size(); ++i) {
+      if (std::tolower((unsigned char) left[i]) != std::tolower((unsigned char) right[i])) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  static uint8_t getInternedHeaderId (const StringView name) {
+    for (uint8_t id = 1; id < std::size(INTERNED_HEADER_NAMES); ++id) {
+      if (equalsIgnoreCase(INTERNED_HEADER_NAMES[id], name)) {
+        return id;
+      }
+    }
+
+    return 0;
   }
 
-  Headers::Header::Header (const String& key, const Value& value) {
-    this->key = trim(key);
-    this->value = trim(value.str());
+  static bool isHeaderNamed (const Headers::Header& header, const StringView name, uint8_t id) {
+    if (id > 0 || header.id > 0) {
+      return header.id == id;
+    }
+
+    return equalsIgnoreCase(header.key, name);
   }
 
-  Headers::Headers (const String& source) {
-    for (const auto& entry : split(source, '\n')) {
-      const auto tuple = split(entry, ':');
-      if (tuple.size() == 2) {
-        set(trim(tuple.front()), trim(tuple.back()));
+  // the index of the header called `name` in `entries`, or `entries.size()`
+  static size_t findHeader (const Headers::Entries& entries, const StringView name, uint8_t id) {
+    for (size_t i = 0; i < entries.size(); ++i) {
+      if (isHeaderNamed(entries[i], name, id)) {
+        return i;
       }
     }
+
+    return entries.size();
   }
 
-  Headers::Headers (const Headers& headers) {
-    this->entries = headers.entries;
+  Headers::Header::Header (const String& key, const Value& value)
+    : key(trimView(key)),
+      value(value)
+  {
+    auto string = std::get_if<String>(&this->value.data);
+
+    if (string != nullptr) {
+      const auto trimmed = trimView(*string);
+
+      if (trimmed.size() != string->size()) {
+        *string = String(trimmed);
+      }
+    }
+
+    this->id = getInternedHeaderId(this->key);
+  }
+
+  bool Headers::Header::is (const String& name) const {
+    return isHeaderNamed(*this, name, getInternedHeaderId(name));
+  }
+
+  Headers::Headers (const String& source) {
+    auto lines = Tokenizer(source, '\n');
+    StringView entry;
+
+    while (lines.next(entry)) {
+      // only entries with exactly one non-empty key and value are kept
+      auto tuple = Tokenizer(entry, ':');
+      StringView key;
+      StringView value;
+      StringView rest;
+
+      if (tuple.next(key) && tuple.next(value) && !tuple.next(rest)) {
+        set(String(trimView(key)), String(trimView(value)));
+      }
+    }
   }
 
   Headers::Headers (const Vector<std::map<String, Value>>& entries) {
+    size_t size = 0;
+
+    for (const auto& entry : entries) {
+      size += entry.size();
+    }
+
+    this->entries.reserve(size);
+
     for (const auto& entry : entries) {
       for (const auto& pair : entry) {
         this->entries.push_back(Header { pair.first, pair.second });
@@ -57,44 +170,34 @@ namespace SSC {
     }
   }
 
-  Headers::Headers (const Entries& entries) {
-    for (const auto& entry : entries) {
-      this->entries.push_back(entry);
-    }
-  }
+  Headers::Headers (const Entries& entries)
+    : entries(entries)
+  {}
 
-  void Headers::set (const String& key, const String& value) {
-    set(Header{ key, value });
+  void Headers::set (const String& key, const Value& value) {
+    set(Header { key, value });
   }
 
   void Headers::set (const Header& header) {
-    for (auto& entry : entries) {
-      if (header.key == entry.key) {
-        entry.value = header.value;
-        return;
-      }
-    }
+    const auto index = findHeader(this->entries, header.key, header.id);
 
-    entries.push_back(header);
+    if (index < this->entries.size()) {
+      this->entries[index].value = header.value;
+    } else {
+      this->entries.push_back(header);
+    }
   }
 
   bool Headers::has (const String& name) const {
-    for (const auto& header : entries) {
-      if (header.key == name) {
-        return true;
-      }
-    }
-
-    return false;
+    return findHeader(this->entries, name, getInternedHeaderId(name)) < this->entries.size();
   }
 
   const Headers::Header& Headers::get (const String& name) const {
     static const auto empty = Header();
+    const auto index = findHeader(this->entries, name, getInternedHeaderId(name));
 
-    for (const auto& header : entries) {
-      if (header.key == name) {
-        return header;
-      }
+    if (index < this->entries.size()) {
+      return this->entries[index];
     }
 
     return empty;
@@ -105,61 +208,97 @@ namespace SSC {
   }
 
   String Headers::str () const {
-    StringStream headers;
-    auto count = this->size();
+    String headers;
+
     for (const auto& entry : this->entries) {
-      headers << entry.key << ": " << entry.value.str();;
-      if (--count > 0) {
-        headers << "\n";
+      if (headers.size() > 0) {
+        headers += "\n";
       }
+
+      headers += entry.key;
+      headers += ": ";
+      headers += entry.value.str();
     }
-    return headers.str();
-  }
 
-  Headers::Value::Value (const String& value) {
-    this->string = trim(value);
+    return headers;
   }
 
-  Headers::Value::Value (const char* value) {
-    this->string = value;
-  }
+  Headers::Value::Value (const String& value)
+    : data(value)
+  {}
 
-  Headers::Value::Value (const Value& value) {
-    this->string = value.string;
-  }
+  Headers::Value::Value (String&& value)
+    : data(std::move(value))
+  {}
 
-  Headers::Value::Value (bool value) {
-    this->string = value ? "true" : "false";
-  }
+  Headers::Value::Value (const char* value)
+    : data(String(value))
+  {}
 
-  Headers::Value::Value (int value) {
-    this->string = std::to_string(value);
-  }
+  Headers::Value::Value (bool value)
+    : data(value)
+  {}
 
-  Headers::Value::Value (float value) {
-    this->string = std::to_string(value);
-  }
+  Headers::Value::Value (int value)
+    : data((int64_t) value)
+  {}
 
-  Headers::Value::Value (int64_t value) {
-    this->string = std::to_string(value);
-  }
+  Headers::Value::Value (float value)
+    : data((double) value)
+  {}
 
-  Headers::Value::Value (uint64_t value) {
-    this->string = std::to_string(value);
-  }
+  Headers::Value::Value (int64_t value)
+    : data(value)
+  {}
 
-  Headers::Value::Value (double_t value) {
-    this->string = std::to_string(value);
-  }
+  Headers::Value::Value (uint64_t value)
+    : data(value)
+  {}
+
+  Headers::Value::Value (double_t value)
+    : data((double) value)
+  {}
 
 #if defined(__APPLE__)
-  Headers::Value::Value (ssize_t value) {
-    this->string = std::to_string(value);
-  }
+  Headers::Value::Value (ssize_t value)
+    : data((int64_t) value)
+  {}
 #endif
 
+  bool Headers::Value::isNumber () const {
+    return (
+      std::holds_alternative<int64_t>(this->data) ||
+      std::holds_alternative<uint64_t>(this->data) ||
+      std::holds_alternative<double>(this->data)
+    );
+  }
+
+  double Headers::Value::number () const {
+    if (auto value = std::get_if<int64_t>(&this->data)) return (double) *value;
+    if (auto value = std::get_if<uint64_t>(&this->data)) return (double) *value;
+    if (auto value = std::get_if<double>(&this->data)) return *value;
+    if (auto value = std::get_if<bool>(&this->data)) return *value ? 1 : 0;
+    return std::strtod(std::get<String>(this->data).c_str(), nullptr);
+  }
+
   const String& Headers::Value::str () const {
-    return this->string;
+    if (auto value = std::get_if<String>(&this->data)) {
+      return *value;
+    }
+
+    if (this->rendered.size() == 0) {
+      if (auto value = std::get_if<bool>(&this->data)) {
+        this->rendered = *value ? "true" : "false";
+      } else if (auto value = std::get_if<int64_t>(&this->data)) {
+        this->rendered = std::to_string(*value);
+      } else if (auto value = std::get_if<uint64_t>(&this->data)) {
+        this->rendered = std::to_string(*value);
+      } else if (auto value = std::get_if<double>(&this->data)) {
+        this->rendered = std::to_string(*value);
+      }
+    }
+
+    return this->rendered;
   }
 
   const char * Headers::Value::c_str() const {
@@ -244,7 +383,7 @@ namespace SSC {
       "const id = `" + sid + "`;                                             \n"
       "const seq = `" + seq + "`;                                            \n"
       "const workerId = `" + post.workerId + "`.trim() || null;              \n"
-      "const headers = `" + trim(post.headers) + "`                          \n"
+      "const headers = `" + post.headers.str() + "`                          \n"
       "  .trim()                                                             \n"
       "  .split(/[\\r\\n]+/)                                                 \n"
       "  .filter(Boolean)                                                    \n"
@@ -611,14 +750,7 @@ namespace SSC {
       if (event == "domcontentloaded") {
         Lock lock(this->core->fs.mutex);
 
-        for (auto const &tuple : this->core->fs.descriptors) {
-          auto desc = tuple.second;
-          if (desc != nullptr) {
-            desc->stale = true;
-          } else {
-            this->core->fs.descriptors.erase(tuple.first);
-          }
-        }
+        this->core->fs.descriptors.markAllStale();
 
         #if !defined(__ANDROID__)
         for (auto const &tuple : this->core->fs.watchers) {
@@ -851,99 +983,6 @@ namespace SSC {
 #endif
   }
 
-  void Core::DNS::lookup (
-    const String seq,
-    LookupOptions options,
-    Core::Module::Callback cb
-  ) {
-    this->core->dispatchEventLoop([=, this]() {
-      auto ctx = new Core::Module::RequestContext(seq, cb);
-      auto loop = this->core->getEventLoop();
-
-      struct addrinfo hints = {0};
-
-      if (options.family == 6) {
-        hints.ai_family = AF_INET6;
-      } else if (options.family == 4) {
-        hints.ai_family = AF_INET;
-      } else {
-        hints.ai_family = AF_UNSPEC;
-      }
-
-      hints.ai_socktype = 0; // `0` for any
-      hints.ai_protocol = 0; // `0` for any
-
-      auto resolver = new uv_getaddrinfo_t;
-      resolver->data = ctx;
-
-      auto err = uv_getaddrinfo(loop, resolver, [](uv_getaddrinfo_t *resolver, int status, struct addrinfo *res) {
-        auto ctx = (Core::DNS::RequestContext*) resolver->data;
-
-        if (status < 0) {
-          auto result = JSON::Object::Entries {
-            {"source", "dns.lookup"},
-            {"err", JSON::Object::Entries {
-              {"code", std::to_string(status)},
-              {"message", String(uv_strerror(status))}
-            }}
-          };
-
-          ctx->cb(ctx->seq, result, Post{});
-          uv_freeaddrinfo(res);
-          delete resolver;
-          delete ctx;
-          return;
-        }
-
-        String address = "";
-
-        if (res->ai_family == AF_INET) {
-          char addr[17] = {'\0'};
-          uv_ip4_name((struct sockaddr_in*)(res->ai_addr), addr, 16);
-          address = String(addr, 17);
-        } else if (res->ai_family == AF_INET6) {
-          char addr[40] = {'\0'};
-          uv_ip6_name((struct sockaddr_in6*)(res->ai_addr), addr, 39);
-          address = String(addr, 40);
-        }
-
-        address = address.erase(address.find('\0'));
-
-        auto family = res->ai_family == AF_INET
-          ? 4
-          : res->ai_family == AF_INET6
-            ? 6
-            : 0;
-
-        auto result = JSON::Object::Entries {
-          {"source", "dns.lookup"},
-          {"data", JSON::Object::Entries {
-            {"address", address},
-            {"family", family}
-          }}
-        };
-
-        ctx->cb(ctx->seq, result, Post{});
-        uv_freeaddrinfo(res);
-        delete resolver;
-        delete ctx;
-      }, options.hostname.c_str(), nullptr, &hints);
-
-      if (err < 0) {
-        auto result = JSON::Object::Entries {
-          {"source", "dns.lookup"},
-          {"err", JSON::Object::Entries {
-            {"code", std::to_string(err)},
-            {"message", String(uv_strerror(err))}
-          }}
-        };
-
-        ctx->cb(seq, result, Post{});
-        delete ctx;
-      }
-    });
-  }
-
 #if defined(__linux__) && !defined(__ANDROID__)
   struct UVSource {
     GSource base; // should ALWAYS be first member
@@ -1125,22 +1164,20 @@ namespace SSC {
     .timeout = 256, // in milliseconds
     .invoke = [](uv_timer_t *handle) {
       auto core = reinterpret_cast<Core *>(handle->data);
-      Vector<uint64_t> ids;
-      String msg = "";
+      Vector<Core::FS::DescriptorTable::Handle> handles;
 
       {
+        // only stale and unretained descriptors are candidates
         Lock lock(core->fs.mutex);
-        for (auto const &tuple : core->fs.descriptors) {
-          ids.push_back(tuple.first);
-        }
+        handles = core->fs.descriptors.getWeakHandles();
       }
 
-      for (auto const id : ids) {
+      for (auto const& handle : handles) {
         Lock lock(core->fs.mutex);
-        auto desc = core->fs.descriptors.at(id);
+        auto desc = core->fs.descriptors.get(handle);
 
+        // slot was freed (or reused) since it was scanned
         if (desc == nullptr) {
-          core->fs.descriptors.erase(id);
           continue;
         }
 
@@ -1148,13 +1185,15 @@ namespace SSC {
           continue;
         }
 
+        auto id = desc->id;
+
         if (desc->isDirectory()) {
           core->fs.closedir("", id, [](auto seq, auto msg, auto post) {});
         } else if (desc->isFile()) {
           core->fs.close("", id, [](auto seq, auto msg, auto post) {});
         } else {
           // free
-          core->fs.descriptors.erase(id);
+          core->fs.descriptors.remove(id);
           delete desc;
         }
       }
@@ -40,6 +40,9 @@
 namespace SSC {
   constexpr int EVENT_LOOP_POLL_TIMEOUT = 32; // in milliseconds
 
+  // a random id that is never `0`, from a generator local to each thread.
+  // xoshiro256** is not cryptographically secure, so ids can be predicted
+  // from earlier ones, use `uv_random()` for secrets
   uint64_t rand64 ();
   void msleep (uint64_t ms);
 
@@ -51,15 +54,25 @@ namespace SSC {
   // forward
   class Core;
 
+  /**
+   * A small flat list of headers. Names are matched case-insensitively,
+   * with common names interned, and numbers are kept as numbers until
+   * the headers are serialized.
+   */
   class Headers {
     public:
       class Value {
+        // rendered from a number on first use
+        mutable String rendered;
+
         public:
-          String string;
+          std::variant<String, bool, int64_t, uint64_t, double> data;
           Value () = default;
           Value (const String& value);
+          Value (String&& value);
           Value (const char* value);
-          Value (const Value& value);
+          Value (const Value& value) = default;
+          Value (Value&& value) = default;
           Value (bool value);
           Value (int value);
           Value (float value);
@@ -69,12 +82,15 @@ namespace SSC {
         #if defined(__APPLE__)
           Value (ssize_t value);
         #endif
+          Value& operator = (const Value& value) = default;
+          Value& operator = (Value&& value) = default;
+          bool isNumber () const;
+          double number () const;
           const String& str () const;
           const char * c_str() const;
 
           template <typename T> void set (T value) {
-            auto v = Value(value);
-            this->string = v.string;
+            *this = Value(value);
           }
       };
 
@@ -82,22 +98,31 @@ namespace SSC {
         public:
           String key;
           Value value;
+          // index of an interned name, or 0
+          uint8_t id = 0;
           Header () = default;
-          Header (const Header& header);
+          Header (const Header& header) = default;
+          Header (Header&& header) = default;
           Header (const String& key, const Value& value);
+          Header& operator = (const Header& header) = default;
+          Header& operator = (Header&& header) = default;
+          bool is (const String& name) const;
       };
 
       using Entries = Vector<Header>;
       Entries entries;
       Headers () = default;
-      Headers (const Headers& headers);
+      Headers (const Headers& headers) = default;
+      Headers (Headers&& headers) = default;
       Headers (const String& source);
       Headers (const Vector<std::map<String, Value>>& entries);
       Headers (const Entries& entries);
+      Headers& operator = (const Headers& headers) = default;
+      Headers& operator = (Headers&& headers) = default;
       size_t size () const;
       String str () const;
 
-      void set (const String& key, const String& value);
+      void set (const String& key, const Value& value);
       void set (const Header& header);
       bool has (const String& name) const;
       const Header& get (const String& name) const;
@@ -108,7 +133,7 @@ namespace SSC {
     uint64_t ttl = 0;
     char* body = nullptr;
     size_t length = 0;
-    String headers = "";
+    Headers headers;
     String workerId = "";
     std::shared_ptr<std::function<bool(const char*, const char*, bool)>> event_stream;
     std::shared_ptr<std::function<bool(const char*, size_t, bool)>> chunk_stream;
@@ -135,7 +160,9 @@ namespace SSC {
 
   typedef enum {
     PEER_FLAG_NONE = 0,
-    PEER_FLAG_EPHEMERAL = 1 << 1
+    PEER_FLAG_EPHEMERAL = 1 << 1,
+    // set once the socket rejects UDP segmentation offload (GSO)
+    PEER_FLAG_UDP_GSO_UNSUPPORTED = 1 << 2
   } peer_flag_t;
 
   typedef enum {
@@ -147,10 +174,14 @@ namespace SSC {
     PEER_STATE_UDP_CONNECTED = 1 << 11,
     PEER_STATE_UDP_RECV_STARTED = 1 << 12,
     PEER_STATE_UDP_PAUSED = 1 << 13,
+    PEER_STATE_UDP_SEND_BLOCKED = 1 << 14,
     // tcp states (20)
     PEER_STATE_TCP_BOUND = 1 << 20,
     PEER_STATE_TCP_CONNECTED = 1 << 21,
     PEER_STATE_TCP_PAUSED = 1 << 13,
+    PEER_STATE_TCP_LISTENING = 1 << 22,
+    PEER_STATE_TCP_READING = 1 << 23,
+    PEER_STATE_TCP_SHUTDOWN = 1 << 24,
     PEER_STATE_MAX = 1 << 0xF
   } peer_state_t;
 
@@ -194,25 +225,102 @@ namespace SSC {
         RequestContext (Callback cb) { this->cb = cb; }
       };
 
+      /**
+       * A datagram received into the receive slab. `bytes` is only valid
+       * for the duration of the `UDPReceiveCallback` it is given to.
+       */
+      struct UDPDatagram {
+        const char *bytes = nullptr;
+        size_t size = 0;
+        struct sockaddr_storage addr;
+      };
+
+      // `status` is the number of datagrams in the batch or a negative error
       using UDPReceiveCallback = std::function<void(
-        ssize_t,
-        const uv_buf_t*,
-        const struct sockaddr*
+        ssize_t status,
+        const Vector<UDPDatagram>& datagrams
+      )>;
+
+      /**
+       * A datagram to send with `sendMany()`. `bytes` must remain valid
+       * until the `UDPSendManyCallback` is called.
+       */
+      struct UDPSendDatagram {
+        const char *bytes = nullptr;
+        size_t size = 0;
+        String address = "";
+        int port = 0;
+      };
+
+      /**
+       * A pooled `uv_udp_send()` request, only used when
+       * `uv_udp_try_send()` reports that a send would block.
+       */
+      struct UDPSendRequest {
+        uv_udp_send_t req;
+        RequestContext::Callback cb;
+        Peer *peer = nullptr;
+      };
+
+      // called once for all datagrams given to `sendMany()`
+      using UDPSendManyCallback = std::function<void(
+        int err,
+        size_t sent,
+        size_t failed
       )>;
 
+      // `bytes` is owned by the callback when `nread > 0`, otherwise
+      // `nread` is `UV_EOF` or a negative error and `bytes` is `nullptr`
+      using TCPReadCallback = std::function<void(ssize_t nread, char *bytes)>;
+      // `client` is a new connected peer, or `nullptr` if `status < 0`
+      using TCPConnectionCallback = std::function<void(int status, Peer *client)>;
+      using TCPCallback = std::function<void(int status)>;
+
+      // writes reply right away until this many bytes are queued
+      static constexpr size_t TCP_WRITE_HIGH_WATER_MARK = 1024 * 1024;
+
+      // largest possible datagram payload, one slice of the receive slab
+      static constexpr size_t UDP_RECV_DATAGRAM_SIZE = 64 * 1024;
+      // datagrams read per `recvmmsg(2)` call, if supported by the platform
+      static constexpr size_t UDP_RECV_BATCH_SIZE = 16;
+      // idle send requests kept for reuse by `send()`
+      static constexpr size_t UDP_SEND_REQUEST_POOL_SIZE = 64;
+      // parsed destinations kept before the cache is reset
+      static constexpr size_t UDP_DESTINATION_CACHE_SIZE = 256;
+      // most segments and bytes given to one `sendmsg(2)` with `UDP_SEGMENT`
+      static constexpr size_t UDP_GSO_MAX_SEGMENTS = 64;
+      static constexpr size_t UDP_GSO_MAX_SIZE = 65507;
+
       // uv handles
       union {
         uv_udp_t udp;
-        uv_tcp_t tcp; // XXX: FIXME
+        uv_tcp_t tcp;
       } handle;
 
       // sockaddr
-      struct sockaddr_in addr;
+      struct sockaddr_storage addr;
 
       // callbacks
       UDPReceiveCallback receiveCallback;
+      TCPReadCallback readCallback;
+      TCPConnectionCallback connectionCallback;
       std::vector<std::function<void()>> onclose;
 
+      // receive slab reused across reads and the pending datagram batch
+      struct {
+        char *bytes = nullptr;
+        size_t size = 0;
+      } slab;
+
+      Vector<UDPDatagram> datagrams;
+
+      // idle send requests and parsed destinations keyed by "address:port"
+      Vector<UDPSendRequest*> sendRequests;
+      std::unordered_map<String, struct sockaddr_storage> destinations;
+
+      // polls a duplicate of the socket while receiving with UDP GRO
+      uv_poll_t *groPoll = nullptr;
+
       // instance state
       uint64_t id = 0;
       std::recursive_mutex mutex;
@@ -221,8 +329,17 @@ namespace SSC {
       struct {
         struct {
           bool reuseAddr = false;
-          bool ipv6Only = false; // @TODO
+          bool ipv6Only = false;
+          // receive coalesced datagrams with UDP GRO, if supported
+          bool gro = false;
+          // queued send bytes past which `udp.send` reports it would block,
+          // `0` queues sends without a limit
+          size_t sendHighWaterMark = 0;
         } udp;
+
+        struct {
+          bool ipv6Only = false;
+        } tcp;
       } options;
 
       // peer state
@@ -258,19 +375,75 @@ namespace SSC {
       int bind ();
       int bind (String address, int port);
       int bind (String address, int port, bool reuseAddr);
+      int bind (String address, int port, bool reuseAddr, bool ipv6Only);
       int rebind ();
       int connect (String address, int port);
       int disconnect ();
+      int getDestinationAddress (
+        const String& address,
+        int port,
+        struct sockaddr_storage *addr
+      );
+      void send (
+        char *buf,
+        size_t size,
+        int port,
+        const String address,
+        Peer::RequestContext::Callback cb
+      );
       void send (
         char *buf,
         size_t size,
         int port,
         const String address,
+        size_t segmentSize,
+        Peer::RequestContext::Callback cb
+      );
+      void sendSegments (
+        char *buf,
+        size_t size,
+        int port,
+        const String address,
+        size_t segmentSize,
         Peer::RequestContext::Callback cb
       );
+      void sendMany (
+        const Vector<UDPSendDatagram>& datagrams,
+        UDPSendManyCallback cb
+      );
       int recvstart ();
       int recvstart (UDPReceiveCallback onrecv);
       int recvstop ();
+      int setBroadcast (bool enabled);
+      int setTTL (int ttl);
+      int setMulticastTTL (int ttl);
+      int setMulticastLoopback (bool enabled);
+      int setMulticastInterface (const String& interfaceAddress);
+      int setMembership (
+        const String& multicastAddress,
+        const String& interfaceAddress,
+        bool join
+      );
+      int setSourceMembership (
+        const String& multicastAddress,
+        const String& interfaceAddress,
+        const String& sourceAddress,
+        bool join
+      );
+      int setDSCP (int dscp);
+      int listen (
+        String address,
+        int port,
+        int backlog,
+        bool ipv6Only,
+        TCPConnectionCallback onconnection
+      );
+      void connect (String address, int port, TCPCallback cb);
+      void write (const char *bytes, size_t size, TCPCallback cb);
+      int readstart ();
+      int readstart (TCPReadCallback onread);
+      int readstop ();
+      void shutdown (TCPCallback cb);
       int resume ();
       int pause ();
       void close ();
@@ -289,10 +462,43 @@ namespace SSC {
     return String(buf);
   }
 
+  /**
+   * Writes the address of `name` into `address`, which must have room
+   * for at least `INET6_ADDRSTRLEN` bytes, and its port into `port`.
+   */
   static inline void parseAddress (struct sockaddr *name, int* port, char* address) {
-    struct sockaddr_in *name_in = (struct sockaddr_in *) name;
-    *port = ntohs(name_in->sin_port);
-    uv_ip4_name(name_in, address, 17);
+    if (name->sa_family == AF_INET6) {
+      struct sockaddr_in6 *name_in6 = (struct sockaddr_in6 *) name;
+      *port = ntohs(name_in6->sin6_port);
+      uv_ip6_name(name_in6, address, INET6_ADDRSTRLEN);
+    } else {
+      struct sockaddr_in *name_in = (struct sockaddr_in *) name;
+      *port = ntohs(name_in->sin_port);
+      uv_ip4_name(name_in, address, INET_ADDRSTRLEN);
+    }
+  }
+
+  /**
+   * Parses an IPv4 or IPv6 `address` and `port` into `addr`.
+   */
+  static inline int parseSocketAddress (
+    const String& address,
+    int port,
+    struct sockaddr_storage* addr
+  ) {
+    memset(addr, 0, sizeof(struct sockaddr_storage));
+
+    if (address.find(':') != String::npos) {
+      return uv_ip6_addr(address.c_str(), port, (struct sockaddr_in6 *) addr);
+    }
+
+    return uv_ip4_addr(address.c_str(), port, (struct sockaddr_in *) addr);
+  }
+
+  static inline int getSocketAddressLength (const struct sockaddr_storage* addr) {
+    return addr->ss_family == AF_INET6
+      ? sizeof(struct sockaddr_in6)
+      : sizeof(struct sockaddr_in);
   }
 
   class Bluetooth {
@@ -360,38 +566,187 @@ namespace SSC {
       class Diagnostics : public Module {
         public:
           Diagnostics (auto core) : Module(core) {}
+          void query (const String seq, Module::Callback cb);
       };
 
       class DNS : public Module {
         public:
           DNS (auto core) : Module(core) {}
+
+          // `getaddrinfo(3)` reports no record TTL, so results are kept
+          // for a fixed time, failures for "not found" only briefly
+          static constexpr uint64_t CACHE_TTL = 30 * 1000;
+          static constexpr uint64_t CACHE_NEGATIVE_TTL = 5 * 1000;
+          static constexpr size_t CACHE_MAX_ENTRIES = 256;
+
           struct LookupOptions {
             String hostname;
-            int family;
-            // TODO: support these options
-            // - hints
-            // - all
-            // -verbatim
+            int family = 0;
+            // `ai_flags` given to `getaddrinfo(3)`, like `AI_ADDRCONFIG`
+            int hints = 0;
+            // reply with every address instead of the first one
+            bool all = false;
+            // keep the resolver's order instead of putting IPv4 first
+            bool verbatim = true;
+          };
+
+          struct Address {
+            String address;
+            int family = 0;
+          };
+
+          using LookupCallback = std::function<void(
+            int status,
+            const Vector<Address>& addresses
+          )>;
+
+          // a finished lookup, keyed by hostname, family and hints
+          struct CacheEntry {
+            int status = 0;
+            Vector<Address> addresses;
+            uint64_t expires = 0;
+            uint64_t lastUsed = 0; // the least recently used entry is evicted
+          };
+
+          struct CacheStats {
+            Atomic<uint64_t> hits = 0;
+            Atomic<uint64_t> misses = 0;
+            // lookups that joined an identical lookup already in flight
+            Atomic<uint64_t> coalesced = 0;
+            Atomic<uint64_t> size = 0;
           };
+
+          // only used on the event loop thread
+          std::map<String, CacheEntry> cache;
+          std::map<String, Vector<LookupCallback>> pending;
+          CacheStats stats;
+
           void lookup (
             const String seq,
             LookupOptions options,
             Module::Callback cb
           );
+          void resolve (LookupOptions options, LookupCallback cb);
       };
 
       class FS : public Module {
         public:
           FS (auto core) : Module(core) {}
 
+          // chunks kept in flight ahead of a sequential reader by default,
+          // read-ahead is opt-in with `ReadOptions::readAhead`
+          static constexpr size_t DEFAULT_READ_AHEAD_WINDOW = 0;
+          // larger windows given in `ReadOptions` are clamped to this
+          static constexpr size_t MAX_READ_AHEAD_WINDOW = 16;
+          // bytes held in chunks ahead of a reader, whatever the window
+          static constexpr size_t MAX_READ_AHEAD_BYTES = 16 * 1024 * 1024;
+          // consecutive sequential reads needed before reading ahead
+          static constexpr size_t READ_AHEAD_SEQUENTIAL_THRESHOLD = 2;
+          // largest single read or write in `readFile()` and `writeFile()`,
+          // `uv_buf_t` lengths and `uv_fs_*()` results are 32 bit
+          static constexpr size_t MAX_IO_CHUNK_SIZE = 1024 * 1024 * 1024;
+          // milliseconds buffered writes wait for more writes to coalesce with
+          static constexpr uint64_t WRITE_BEHIND_WINDOW = 2;
+          // buffered bytes that are flushed without waiting for the window
+          static constexpr size_t WRITE_BEHIND_MAX_BYTES = 1024 * 1024;
+
+          struct ReadAhead;
+
+          struct ReadAheadChunk {
+            ReadAhead *owner = nullptr; // `nullptr` once detached from `owner`
+            uint64_t id = 0; // descriptor id
+            uv_fs_t req;
+            uv_buf_t buf;
+            size_t offset = 0;
+            int64_t result = 0;
+            bool done = false;
+            // a read waiting on this chunk while it is still in flight
+            String seq;
+            Module::Callback cb = nullptr;
+            size_t size = 0;
+          };
+
+          struct ReadAhead {
+            size_t window = DEFAULT_READ_AHEAD_WINDOW;
+            size_t expectedOffset = 0; // where the next sequential read starts
+            size_t scheduledOffset = 0; // end of the last scheduled chunk
+            size_t streak = 0; // consecutive sequential reads
+            bool advised = false;
+            bool eof = false;
+            Vector<ReadAheadChunk*> chunks; // ordered by offset
+
+            ~ReadAhead ();
+            // frees completed chunks and detaches chunks still in flight
+            void reset ();
+          };
+
+          struct WriteBehind {
+            struct Write {
+              String bytes; // copied, the caller is answered once queued
+              size_t start = 0; // bytes of `bytes` already written
+              int64_t offset = 0;
+              uint64_t number = 0; // 1-based, in queue order
+            };
+
+            struct Drained {
+              uint64_t committed = 0; // writes that must be committed first
+              std::function<void()> callback;
+            };
+
+            bool enabled = false;
+            bool writing = false; // a coalesced write is in flight
+            uv_timer_t *timer = nullptr; // flushes after `WRITE_BEHIND_WINDOW`
+            Vector<Write> queue;
+            size_t bytes = 0; // queued bytes not yet in flight
+            uint64_t queued = 0; // writes queued so far
+            uint64_t committed = 0; // writes that have reached the file
+            // first failed write, reported by the next write, fsync or close
+            int err = 0;
+            // called once the writes queued before them are committed
+            Vector<Drained> drained;
+          };
+
+          struct GroupCommit {
+            bool syncing = false; // an fsync is in flight
+            Vector<Module::RequestContext> waiters; // waiting on the next fsync
+          };
+
+          struct OpenOptions {
+            // answer writes once buffered and coalesce adjacent writes made
+            // within `WRITE_BEHIND_WINDOW` into a single vectored write
+            bool writeBehind = false;
+          };
+
+          struct ReadFileOptions {
+            int flags = UV_FS_O_RDONLY;
+          };
+
+          struct WriteFileOptions {
+            int flags = UV_FS_O_WRONLY | UV_FS_O_CREAT | UV_FS_O_TRUNC;
+            int mode = 0666;
+            // write to a temporary file next to `path` and rename it over
+            // `path` once synced, so readers never observe a partial file
+            bool atomic = false;
+          };
+
+          struct ReadOptions {
+            // chunks to read ahead once sequential access is detected,
+            // `0` disables read-ahead for the descriptor, at most
+            // `MAX_READ_AHEAD_WINDOW`
+            size_t readAhead = DEFAULT_READ_AHEAD_WINDOW;
+          };
+
           struct Descriptor {
             uint64_t id;
-            std::atomic<bool> retained = false;
-            std::atomic<bool> stale = false;
+            uint32_t slot = 0; // index into `DescriptorTable::slots`
+            String path; // as given to `open()`, empty for directories
             Mutex mutex;
             uv_dir_t *dir = nullptr;
             uv_file fd = 0;
             Core *core;
+            ReadAhead readAhead;
+            WriteBehind writeBehind;
+            GroupCommit groupCommit;
 
             Descriptor (Core *core, uint64_t id);
             bool isDirectory ();
@@ -400,6 +755,70 @@ namespace SSC {
             bool isStale ();
           };
 
+          /**
+           * A generational slot map of open descriptors. Descriptors live in
+           * a dense slot array and a slot's generation is bumped when it is
+           * freed so a `Handle` to a reused slot never resolves. Stale and
+           * retained states are bitsets indexed by slot so the weak
+           * descriptor reaper only visits candidate slots. Callers must hold
+           * `FS::mutex`.
+           */
+          class DescriptorTable {
+            public:
+              struct Handle {
+                uint32_t slot = 0;
+                uint32_t generation = 0;
+              };
+
+              struct Slot {
+                Descriptor *desc = nullptr;
+                uint32_t generation = 0;
+              };
+
+              Vector<Slot> slots;
+              Vector<uint32_t> freeSlots;
+              std::unordered_map<uint64_t, uint32_t> ids;
+              Vector<uint64_t> stale;
+              Vector<uint64_t> retained;
+
+              Descriptor * get (uint64_t id) const;
+              Descriptor * get (const Handle& handle) const;
+              bool has (uint64_t id) const;
+              void insert (Descriptor *desc);
+              Descriptor * remove (uint64_t id);
+              size_t size () const;
+
+              void setStale (const Descriptor *desc, bool value);
+              void setRetained (const Descriptor *desc, bool value);
+              bool isStale (const Descriptor *desc) const;
+              bool isRetained (const Descriptor *desc) const;
+              void markAllStale ();
+              // handles to descriptors that are stale and not retained
+              Vector<Handle> getWeakHandles () const;
+
+              template <typename Fn> void forEach (const Fn& fn) const {
+                for (const auto& slot : this->slots) {
+                  if (slot.desc != nullptr) {
+                    fn(slot.desc);
+                  }
+                }
+              }
+          };
+
+          struct StatOptions {
+            // deliver a packed `STATS_RECORD_SIZE` byte record as a binary
+            // result instead of the `st_*` JSON object
+            bool binary = false;
+          };
+
+          // A stat record is 21 big endian (network order) 64-bit fields:
+          // status, dev, mode, nlink, uid, gid, rdev, ino, size, blksize,
+          // blocks, flags, gen, atim (sec, nsec), mtim (sec, nsec),
+          // ctim (sec, nsec), birthtim (sec, nsec). `status` is `0` or a
+          // negative `UV_*` error code, in which case all other fields are `0`
+          static constexpr size_t STATS_RECORD_FIELDS = 21;
+          static constexpr size_t STATS_RECORD_SIZE = STATS_RECORD_FIELDS * 8;
+
           struct RequestContext : Module::RequestContext {
             uint64_t id;
             Descriptor *desc = nullptr;
@@ -410,6 +829,7 @@ namespace SSC {
             int offset = 0;
             int result = 0;
             bool recursive;  // A place to stash recursive options when needed
+            bool binary = false; // A place to stash binary result options
 
             RequestContext () = default;
             RequestContext (Descriptor *desc)
@@ -439,12 +859,14 @@ namespace SSC {
           std::map<uint64_t, FileSystemWatcher*> watchers;
         #endif
 
-          std::map<uint64_t, Descriptor*> descriptors;
+          DescriptorTable descriptors;
           Mutex mutex;
 
           Descriptor * getDescriptor (uint64_t id);
           void removeDescriptor (uint64_t id);
           bool hasDescriptor (uint64_t id);
+          // drops data read ahead by every descriptor open at `path`
+          void resetReadAhead (const String& path);
 
           void constants (const String seq, Module::Callback cb);
           void access (
@@ -494,6 +916,12 @@ namespace SSC {
             Module::Callback cb
           );
           void fstat (const String seq, uint64_t id, Module::Callback cb);
+          void fstat (
+            const String seq,
+            uint64_t id,
+            StatOptions options,
+            Module::Callback cb
+          );
           void fsync (const String seq, uint64_t id, Module::Callback cb);
           void ftruncate (
             const String seq,
@@ -503,6 +931,12 @@ namespace SSC {
           );
           void getOpenDescriptors (const String seq, Module::Callback cb);
           void lstat (const String seq, const String path, Module::Callback cb);
+          void lstat (
+            const String seq,
+            const String path,
+            StatOptions options,
+            Module::Callback cb
+          );
 					void link (
             const String seq,
             const String src,
@@ -541,6 +975,15 @@ namespace SSC {
             int mode,
             Module::Callback cb
           );
+          void open (
+            const String seq,
+            uint64_t id,
+            const String path,
+            int flags,
+            int mode,
+            OpenOptions options,
+            Module::Callback cb
+          );
           void opendir (
             const String seq,
             uint64_t id,
@@ -554,6 +997,20 @@ namespace SSC {
             size_t offset,
             Module::Callback cb
           );
+          void read (
+            const String seq,
+            uint64_t id,
+            size_t len,
+            size_t offset,
+            ReadOptions options,
+            Module::Callback cb
+          );
+          void readFile (
+            const String seq,
+            const String path,
+            ReadFileOptions options,
+            Module::Callback cb
+          );
           void readdir (
             const String seq,
             uint64_t id,
@@ -581,6 +1038,17 @@ namespace SSC {
             const String path,
             Module::Callback cb
           );
+          void stat (
+            const String seq,
+            const String path,
+            StatOptions options,
+            Module::Callback cb
+          );
+          void statMany (
+            const String seq,
+            const Vector<String> paths,
+            Module::Callback cb
+          );
           void stopWatch (
             const String seq,
             uint64_t id,
@@ -605,6 +1073,14 @@ namespace SSC {
             size_t offset,
             Module::Callback cb
           );
+          void writeFile (
+            const String seq,
+            const String path,
+            char *bytes,
+            size_t size,
+            WriteFileOptions options,
+            Module::Callback cb
+          );
       };
 
       class OS : public Module {
@@ -677,6 +1153,7 @@ namespace SSC {
             String address;
             int port;
             bool reuseAddr = false;
+            bool ipv6Only = false;
           };
 
           struct ConnectOptions {
@@ -689,9 +1166,46 @@ namespace SSC {
             int port = 0;
             char *bytes = nullptr;
             size_t size = 0;
+            // sends `bytes` as datagrams of this size, with GSO if supported
+            size_t segmentSize = 0;
+            // replaces the peer's send queue high-water mark, if not 0
+            size_t highWaterMark = 0;
+            bool ephemeral = false;
+          };
+
+          struct SendManyOptions {
+            Vector<Peer::UDPSendDatagram> datagrams;
             bool ephemeral = false;
           };
 
+          struct ReadStartOptions {
+            // receive coalesced datagrams with GRO, if supported
+            bool gro = false;
+          };
+
+          struct MembershipOptions {
+            String multicastAddress = "";
+            String interfaceAddress = "";
+            // joins or leaves a source-specific group, if set
+            String sourceAddress = "";
+            bool join = true;
+          };
+
+          struct SocketOptions {
+            // numeric options less than 0 and empty strings are left unchanged
+            int broadcast = -1;
+            int ttl = -1;
+            int multicastTTL = -1;
+            int multicastLoopback = -1;
+            String multicastInterface = "";
+            // differentiated services code point (0-63) of sent datagrams
+            int dscp = -1;
+            int sendBufferSize = 0;
+            int recvBufferSize = 0;
+            // joins or leaves a group, if `multicastAddress` is set
+            MembershipOptions membership;
+          };
+
           void bind (
             const String seq,
             uint64_t id,
@@ -710,6 +1224,12 @@ namespace SSC {
           void getSockName (const String seq, uint64_t id, Module::Callback cb);
           void getState (const String seq, uint64_t id,  Module::Callback cb);
           void readStart (const String seq, uint64_t id, Module::Callback cb);
+          void readStart (
+            const String seq,
+            uint64_t id,
+            ReadStartOptions options,
+            Module::Callback cb
+          );
           void readStop (const String seq, uint64_t id, Module::Callback cb);
           void send (
             const String seq,
@@ -717,6 +1237,81 @@ namespace SSC {
             SendOptions options,
             Module::Callback cb
           );
+          void sendMany (
+            const String seq,
+            uint64_t id,
+            SendManyOptions options,
+            Module::Callback cb
+          );
+          void setOptions (
+            const String seq,
+            uint64_t id,
+            SocketOptions options,
+            Module::Callback cb
+          );
+      };
+
+      class TCP : public Module {
+        public:
+          TCP (auto core) : Module(core) {}
+
+          struct ListenOptions {
+            String address;
+            int port;
+            int backlog = 511;
+            bool ipv6Only = false;
+          };
+
+          struct ConnectOptions {
+            String address;
+            int port;
+          };
+
+          struct WriteOptions {
+            char *bytes = nullptr;
+            size_t size = 0;
+          };
+
+          struct SocketOptions {
+            // options less than 0 are left unchanged
+            int noDelay = -1;
+            int keepAlive = -1;
+            // idle seconds before keep-alive probes are sent, `0` for
+            // `TCP_KEEPALIVE_DELAY`
+            unsigned int keepAliveDelay = 0;
+          };
+
+          // idle seconds before keep-alive probes when no delay is given
+          static constexpr unsigned int TCP_KEEPALIVE_DELAY = 60;
+
+          void close (const String seq, uint64_t id, Module::Callback cb);
+          void connect (
+            const String seq,
+            uint64_t id,
+            ConnectOptions options,
+            Module::Callback cb
+          );
+          void listen (
+            const String seq,
+            uint64_t id,
+            ListenOptions options,
+            Module::Callback cb
+          );
+          void readStart (const String seq, uint64_t id, Module::Callback cb);
+          void readStop (const String seq, uint64_t id, Module::Callback cb);
+          void setOptions (
+            const String seq,
+            uint64_t id,
+            SocketOptions options,
+            Module::Callback cb
+          );
+          void shutdown (const String seq, uint64_t id, Module::Callback cb);
+          void write (
+            const String seq,
+            uint64_t id,
+            WriteOptions options,
+            Module::Callback cb
+          );
       };
 
       Diagnostics diagnostics;
@@ -724,6 +1319,7 @@ namespace SSC {
       FS fs;
       OS os;
       Platform platform;
+      TCP tcp;
       UDP udp;
 
       std::shared_ptr<Posts> posts;
@@ -765,6 +1361,7 @@ namespace SSC {
         fs(this),
         os(this),
         platform(this),
+        tcp(this),
         udp(this)
       {
         this->posts = std::shared_ptr<Posts>(new Posts());
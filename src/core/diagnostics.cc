@@ -0,0 +1,24 @@
+#include "core.hh"
+
+namespace SSC {
+  void Core::Diagnostics::query (const String seq, Module::Callback cb) {
+    this->core->dispatchEventLoop([=, this]() {
+      const auto& stats = this->core->dns.stats;
+      auto json = JSON::Object::Entries {
+        {"source", "diagnostics.query"},
+        {"data", JSON::Object::Entries {
+          {"dns", JSON::Object::Entries {
+            {"cache", JSON::Object::Entries {
+              {"size", stats.size.load()},
+              {"hits", stats.hits.load()},
+              {"misses", stats.misses.load()},
+              {"coalesced", stats.coalesced.load()}
+            }}
+          }}
+        }}
+      };
+
+      cb(seq, json, Post{});
+    });
+  }
+}
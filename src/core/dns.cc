@@ -0,0 +1,238 @@
+#include <algorithm>
+
+#include "core.hh"
+
+namespace SSC {
+  struct DNSLookupContext {
+    Core::DNS *dns = nullptr;
+    String key;
+  };
+
+  static String getCacheKey (const Core::DNS::LookupOptions& options) {
+    return (
+      options.hostname + "|" +
+      std::to_string(options.family) + "|" +
+      std::to_string(options.hints)
+    );
+  }
+
+  static Vector<Core::DNS::Address> getAddresses (struct addrinfo *res) {
+    Vector<Core::DNS::Address> addresses;
+
+    for (auto info = res; info != nullptr; info = info->ai_next) {
+      char name[INET6_ADDRSTRLEN] = {'\0'};
+      Core::DNS::Address address;
+
+      if (info->ai_family == AF_INET) {
+        uv_ip4_name((struct sockaddr_in *) info->ai_addr, name, sizeof(name));
+        address.family = 4;
+      } else if (info->ai_family == AF_INET6) {
+        uv_ip6_name((struct sockaddr_in6 *) info->ai_addr, name, sizeof(name));
+        address.family = 6;
+      } else {
+        continue;
+      }
+
+      address.address = String(name);
+
+      auto exists = std::any_of(addresses.begin(), addresses.end(), [&](const auto& entry) {
+        return entry.address == address.address;
+      });
+
+      if (!exists) {
+        addresses.push_back(address);
+      }
+    }
+
+    return addresses;
+  }
+
+  /**
+   * Caches a finished lookup and calls every callback waiting for it.
+   * Failures other than "not found" may be transient and are not cached.
+   */
+  static void finishLookup (
+    Core::DNS *dns,
+    const String& key,
+    int status,
+    const Vector<Core::DNS::Address>& addresses
+  ) {
+    auto now = uv_now(dns->core->getEventLoop());
+    uint64_t ttl = 0;
+
+    if (status == 0 && addresses.size() > 0) {
+      ttl = Core::DNS::CACHE_TTL;
+    } else if (status == UV_EAI_NONAME || status == UV_EAI_NODATA) {
+      ttl = Core::DNS::CACHE_NEGATIVE_TTL;
+    }
+
+    if (ttl > 0) {
+      if (dns->cache.size() >= Core::DNS::CACHE_MAX_ENTRIES) {
+        for (auto it = dns->cache.begin(); it != dns->cache.end();) {
+          if (it->second.expires <= now) {
+            it = dns->cache.erase(it);
+          } else {
+            ++it;
+          }
+        }
+      }
+
+      if (dns->cache.size() >= Core::DNS::CACHE_MAX_ENTRIES) {
+        auto leastRecentlyUsed = dns->cache.begin();
+
+        for (auto it = dns->cache.begin(); it != dns->cache.end(); ++it) {
+          if (it->second.lastUsed < leastRecentlyUsed->second.lastUsed) {
+            leastRecentlyUsed = it;
+          }
+        }
+
+        dns->cache.erase(leastRecentlyUsed);
+      }
+
+      dns->cache[key] = Core::DNS::CacheEntry {
+        status,
+        addresses,
+        now + ttl,
+        now
+      };
+      dns->stats.size = dns->cache.size();
+    }
+
+    auto callbacks = std::move(dns->pending[key]);
+    dns->pending.erase(key);
+
+    for (const auto& cb : callbacks) {
+      cb(status, addresses);
+    }
+  }
+
+  void Core::DNS::resolve (LookupOptions options, LookupCallback cb) {
+    auto loop = this->core->getEventLoop();
+    auto key = getCacheKey(options);
+    auto cached = this->cache.find(key);
+
+    if (cached != this->cache.end()) {
+      if (cached->second.expires > uv_now(loop)) {
+        cached->second.lastUsed = uv_now(loop);
+        this->stats.hits++;
+        return cb(cached->second.status, cached->second.addresses);
+      }
+
+      this->cache.erase(cached);
+      this->stats.size = this->cache.size();
+    }
+
+    this->stats.misses++;
+
+    // identical lookups share the request that is already in flight
+    auto inflight = this->pending.find(key);
+    if (inflight != this->pending.end()) {
+      this->stats.coalesced++;
+      inflight->second.push_back(cb);
+      return;
+    }
+
+    this->pending[key].push_back(cb);
+
+    struct addrinfo hints = {0};
+
+    if (options.family == 6) {
+      hints.ai_family = AF_INET6;
+    } else if (options.family == 4) {
+      hints.ai_family = AF_INET;
+    } else {
+      hints.ai_family = AF_UNSPEC;
+    }
+
+    hints.ai_socktype = SOCK_STREAM; // one result for each address
+    hints.ai_protocol = 0; // `0` for any
+    hints.ai_flags = options.hints;
+
+    auto ctx = new DNSLookupContext { this, key };
+    auto resolver = new uv_getaddrinfo_t;
+    resolver->data = ctx;
+
+    auto err = uv_getaddrinfo(loop, resolver, [](uv_getaddrinfo_t *resolver, int status, struct addrinfo *res) {
+      auto ctx = (DNSLookupContext *) resolver->data;
+      Vector<Address> addresses;
+
+      if (status == 0) {
+        addresses = getAddresses(res);
+      }
+
+      uv_freeaddrinfo(res);
+      finishLookup(ctx->dns, ctx->key, status, addresses);
+
+      delete resolver;
+      delete ctx;
+    }, options.hostname.c_str(), nullptr, &hints);
+
+    if (err < 0) {
+      delete resolver;
+      delete ctx;
+      finishLookup(this, key, err, Vector<Address>{});
+    }
+  }
+
+  void Core::DNS::lookup (
+    const String seq,
+    LookupOptions options,
+    Core::Module::Callback cb
+  ) {
+    this->core->dispatchEventLoop([=, this]() {
+      this->resolve(options, [=](auto status, const auto& results) {
+        if (status == 0 && results.size() == 0) {
+          status = UV_EAI_NODATA;
+        }
+
+        if (status < 0) {
+          auto json = JSON::Object::Entries {
+            {"source", "dns.lookup"},
+            {"err", JSON::Object::Entries {
+              {"code", std::to_string(status)},
+              {"message", String(uv_strerror(status))}
+            }}
+          };
+
+          return cb(seq, json, Post{});
+        }
+
+        auto addresses = results;
+
+        if (!options.verbatim) {
+          std::stable_partition(addresses.begin(), addresses.end(), [](const auto& entry) {
+            return entry.family == 4;
+          });
+        }
+
+        if (options.all) {
+          JSON::Array::Entries entries;
+
+          for (const auto& entry : addresses) {
+            entries.push_back(JSON::Object::Entries {
+              {"address", entry.address},
+              {"family", entry.family}
+            });
+          }
+
+          auto json = JSON::Object::Entries {
+            {"source", "dns.lookup"},
+            {"data", entries}
+          };
+
+          return cb(seq, json, Post{});
+        }
+
+        auto json = JSON::Object::Entries {
+          {"source", "dns.lookup"},
+          {"data", JSON::Object::Entries {
+            {"address", addresses[0].address},
+            {"family", addresses[0].family}
+          }}
+        };
+
+        cb(seq, json, Post{});
+      });
+    });
+  }
+}
@@ -1,3 +1,9 @@
+#include <bit>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#endif
+
 #include "core.hh"
 namespace SSC {
 
@@ -205,6 +211,74 @@ namespace SSC {
     };
   }
 
+  void writeStatsRecord (char* bytes, int64_t status, uv_stat_t* stats) {
+    uint64_t fields[Core::FS::STATS_RECORD_FIELDS] = { (uint64_t) status };
+
+    if (stats != nullptr) {
+      auto field = &fields[1];
+      *field++ = stats->st_dev;
+      *field++ = stats->st_mode;
+      *field++ = stats->st_nlink;
+      *field++ = stats->st_uid;
+      *field++ = stats->st_gid;
+      *field++ = stats->st_rdev;
+      *field++ = stats->st_ino;
+      *field++ = stats->st_size;
+      *field++ = stats->st_blksize;
+      *field++ = stats->st_blocks;
+      *field++ = stats->st_flags;
+      *field++ = stats->st_gen;
+      *field++ = stats->st_atim.tv_sec;
+      *field++ = stats->st_atim.tv_nsec;
+      *field++ = stats->st_mtim.tv_sec;
+      *field++ = stats->st_mtim.tv_nsec;
+      *field++ = stats->st_ctim.tv_sec;
+      *field++ = stats->st_ctim.tv_nsec;
+      *field++ = stats->st_birthtim.tv_sec;
+      *field++ = stats->st_birthtim.tv_nsec;
+    }
+
+    for (size_t i = 0; i < Core::FS::STATS_RECORD_FIELDS; ++i) {
+      auto field = toBytes(fields[i]);
+      memcpy(bytes + i * field.size(), field.data(), field.size());
+    }
+  }
+
+  Post getStatsPost (char* body, size_t size) {
+    auto post = Post {};
+    auto headers = Headers {{
+      {"content-type" ,"application/octet-stream"},
+      {"content-length", size}
+    }};
+
+    post.id = SSC::rand64();
+    post.body = body;
+    post.length = (int) size;
+    post.headers = std::move(headers);
+    return post;
+  }
+
+  // Shared state for a `statMany()` batch. Each path gets a slim `uv_fs_t`
+  // (not a full `RequestContext`) and writes its record at its own index.
+  struct StatManyContext {
+    String seq;
+    Core::Module::Callback cb;
+    Vector<uv_fs_t> reqs;
+    char *body = nullptr;
+    size_t size = 0;
+    size_t pending = 0;
+  };
+
+  void finishStatMany (StatManyContext* batch) {
+    if (--batch->pending > 0) {
+      return;
+    }
+
+    auto post = getStatsPost(batch->body, batch->size);
+    batch->cb(batch->seq, JSON::Object {}, post);
+    delete batch;
+  }
+
 	void Core::FS::RequestContext::setBuffer(char* base, uint32_t len) {
 		this->buf.base = base;
 		this->buf.len = len;
@@ -240,31 +314,196 @@ namespace SSC {
   }
 
   bool Core::FS::Descriptor::isRetained () {
-    return this->retained;
+    Lock lock(this->core->fs.mutex);
+    return this->core->fs.descriptors.isRetained(this);
   }
 
   bool Core::FS::Descriptor::isStale () {
-    return this->stale;
+    Lock lock(this->core->fs.mutex);
+    return this->core->fs.descriptors.isStale(this);
+  }
+
+  static inline bool getBit (const Vector<uint64_t>& bits, uint32_t index) {
+    auto word = index / 64;
+    return word < bits.size() && (bits[word] & (1ULL << (index % 64))) != 0;
+  }
+
+  static inline void setBit (Vector<uint64_t>& bits, uint32_t index, bool value) {
+    auto word = index / 64;
+
+    if (word >= bits.size()) {
+      if (!value) {
+        return;
+      }
+
+      bits.resize(word + 1, 0);
+    }
+
+    if (value) {
+      bits[word] |= (1ULL << (index % 64));
+    } else {
+      bits[word] &= ~(1ULL << (index % 64));
+    }
+  }
+
+  Core::FS::Descriptor * Core::FS::DescriptorTable::get (uint64_t id) const {
+    auto it = this->ids.find(id);
+    if (it == this->ids.end()) {
+      return nullptr;
+    }
+
+    return this->slots[it->second].desc;
+  }
+
+  Core::FS::Descriptor * Core::FS::DescriptorTable::get (
+    const Handle& handle
+  ) const {
+    if (handle.slot >= this->slots.size()) {
+      return nullptr;
+    }
+
+    const auto& slot = this->slots[handle.slot];
+
+    if (slot.generation != handle.generation) {
+      return nullptr;
+    }
+
+    return slot.desc;
+  }
+
+  bool Core::FS::DescriptorTable::has (uint64_t id) const {
+    return this->ids.find(id) != this->ids.end();
+  }
+
+  void Core::FS::DescriptorTable::insert (Descriptor *desc) {
+    // replacing a descriptor with the same id reuses its slot
+    auto it = this->ids.find(desc->id);
+    if (it != this->ids.end()) {
+      desc->slot = it->second;
+      this->slots[desc->slot].desc = desc;
+    } else if (this->freeSlots.size() > 0) {
+      desc->slot = this->freeSlots.back();
+      this->freeSlots.pop_back();
+      this->slots[desc->slot].desc = desc;
+    } else {
+      desc->slot = (uint32_t) this->slots.size();
+      this->slots.push_back(Slot { desc, 0 });
+    }
+
+    this->ids.insert_or_assign(desc->id, desc->slot);
+    setBit(this->stale, desc->slot, false);
+    setBit(this->retained, desc->slot, false);
+  }
+
+  Core::FS::Descriptor * Core::FS::DescriptorTable::remove (uint64_t id) {
+    auto it = this->ids.find(id);
+    if (it == this->ids.end()) {
+      return nullptr;
+    }
+
+    auto index = it->second;
+    auto& slot = this->slots[index];
+    auto desc = slot.desc;
+
+    slot.desc = nullptr;
+    slot.generation++;
+    setBit(this->stale, index, false);
+    setBit(this->retained, index, false);
+    this->freeSlots.push_back(index);
+    this->ids.erase(it);
+    return desc;
+  }
+
+  size_t Core::FS::DescriptorTable::size () const {
+    return this->ids.size();
+  }
+
+  void Core::FS::DescriptorTable::setStale (const Descriptor *desc, bool value) {
+    if (this->get(desc->id) == desc) {
+      setBit(this->stale, desc->slot, value);
+    }
+  }
+
+  void Core::FS::DescriptorTable::setRetained (
+    const Descriptor *desc,
+    bool value
+  ) {
+    if (this->get(desc->id) == desc) {
+      setBit(this->retained, desc->slot, value);
+    }
+  }
+
+  bool Core::FS::DescriptorTable::isStale (const Descriptor *desc) const {
+    return this->get(desc->id) == desc && getBit(this->stale, desc->slot);
+  }
+
+  bool Core::FS::DescriptorTable::isRetained (const Descriptor *desc) const {
+    return this->get(desc->id) == desc && getBit(this->retained, desc->slot);
+  }
+
+  void Core::FS::DescriptorTable::markAllStale () {
+    this->stale.assign((this->slots.size() + 63) / 64, 0);
+
+    for (uint32_t i = 0; i < this->slots.size(); ++i) {
+      if (this->slots[i].desc != nullptr) {
+        setBit(this->stale, i, true);
+      }
+    }
+  }
+
+  Vector<Core::FS::DescriptorTable::Handle>
+  Core::FS::DescriptorTable::getWeakHandles () const {
+    auto handles = Vector<Handle> {};
+
+    for (size_t word = 0; word < this->stale.size(); ++word) {
+      auto bits = this->stale[word];
+
+      if (word < this->retained.size()) {
+        bits &= ~this->retained[word];
+      }
+
+      while (bits != 0) {
+        auto index = (uint32_t) (word * 64 + std::countr_zero(bits));
+        handles.push_back(Handle { index, this->slots[index].generation });
+        bits &= bits - 1;
+      }
+    }
+
+    return handles;
   }
 
   Core::FS::Descriptor * Core::FS::getDescriptor (uint64_t id) {
     Lock lock(this->mutex);
-    if (descriptors.find(id) != descriptors.end()) {
-      return descriptors.at(id);
-    }
-    return nullptr;
+    return descriptors.get(id);
   }
 
   void Core::FS::removeDescriptor (uint64_t id) {
     Lock lock(this->mutex);
-    if (descriptors.find(id) != descriptors.end()) {
-      descriptors.erase(id);
-    }
+    descriptors.remove(id);
   }
 
   bool Core::FS::hasDescriptor (uint64_t id) {
     Lock lock(this->mutex);
-    return descriptors.find(id) != descriptors.end();
+    return descriptors.has(id);
+  }
+
+  void Core::FS::resetReadAhead (const String& path) {
+    if (path.size() == 0) {
+      return;
+    }
+
+    auto normalized = std::filesystem::path(path).lexically_normal();
+    Lock lock(this->mutex);
+
+    for (const auto& slot : descriptors.slots) {
+      if (
+        slot.desc != nullptr &&
+        slot.desc->path.size() > 0 &&
+        std::filesystem::path(slot.desc->path).lexically_normal() == normalized
+      ) {
+        slot.desc->readAhead.reset();
+      }
+    }
   }
 
   void Core::FS::retainOpenDescriptor (
@@ -288,7 +527,11 @@ namespace SSC {
       return cb(seq, json, Post{});
     }
 
-    desc->retained = true;
+    {
+      Lock lock(this->mutex);
+      descriptors.setRetained(desc, true);
+    }
+
     auto json = JSON::Object::Entries {
       {"source", "fs.retainOpenDescriptor"},
       {"data", JSON::Object::Entries {
@@ -503,43 +746,347 @@ namespace SSC {
     });
   }
 
-  void Core::FS::close (
-    const String seq,
+  struct WriteBehindContext {
+    Core::FS::Descriptor *desc = nullptr;
+    uv_fs_t req;
+    Vector<uv_buf_t> bufs;
+    Vector<Core::FS::WriteBehind::Write> writes;
+  };
+
+  struct GroupCommitContext {
+    Core::FS::Descriptor *desc = nullptr;
+    uv_fs_t req;
+    Vector<Core::Module::RequestContext> waiters;
+  };
+
+  static void notifyDescriptorDrained (Core::FS::Descriptor* desc) {
+    auto writeBehind = &desc->writeBehind;
+    auto drained = Vector<Core::FS::WriteBehind::Drained> {};
+    auto pending = Vector<Core::FS::WriteBehind::Drained> {};
+
+    for (auto& waiter : writeBehind->drained) {
+      if (waiter.committed <= writeBehind->committed) {
+        drained.push_back(std::move(waiter));
+      } else {
+        pending.push_back(std::move(waiter));
+      }
+    }
+
+    writeBehind->drained = std::move(pending);
+
+    for (const auto& waiter : drained) {
+      waiter.callback();
+    }
+  }
+
+  static void flushWriteBehind (Core::FS::Descriptor* desc);
+
+  // Calls `callback` once the buffered writes queued so far are committed,
+  // writes queued after this call do not postpone it.
+  static void whenWriteBehindDrained (
+    Core::FS::Descriptor* desc,
+    std::function<void()> callback
+  ) {
+    auto writeBehind = &desc->writeBehind;
+
+    if (writeBehind->committed >= writeBehind->queued) {
+      return callback();
+    }
+
+    writeBehind->drained.push_back(Core::FS::WriteBehind::Drained {
+      writeBehind->queued,
+      callback
+    });
+
+    // someone is waiting, so do not wait for the window
+    flushWriteBehind(desc);
+  }
+
+  // the first failed buffered write is reported once, by the next write,
+  // fsync or close on the descriptor
+  static int takeWriteBehindError (Core::FS::Descriptor* desc) {
+    auto err = desc->writeBehind.err;
+    desc->writeBehind.err = 0;
+    return err;
+  }
+
+  static void closeWriteBehindTimer (Core::FS::Descriptor* desc) {
+    auto timer = desc->writeBehind.timer;
+
+    if (timer == nullptr) {
+      return;
+    }
+
+    desc->writeBehind.timer = nullptr;
+    uv_timer_stop(timer);
+    uv_close((uv_handle_t*) timer, [](uv_handle_t* handle) {
+      delete (uv_timer_t*) handle;
+    });
+  }
+
+  // Flushes the queue once `WRITE_BEHIND_WINDOW` has passed since the first
+  // write queued behind an idle descriptor, or right away once
+  // `WRITE_BEHIND_MAX_BYTES` are queued. An in-flight write flushes what was
+  // queued behind it as soon as it completes.
+  static void scheduleWriteBehind (Core::FS::Descriptor* desc) {
+    auto writeBehind = &desc->writeBehind;
+
+    if (writeBehind->bytes >= Core::FS::WRITE_BEHIND_MAX_BYTES) {
+      return flushWriteBehind(desc);
+    }
+
+    if (writeBehind->writing) {
+      return;
+    }
+
+    if (writeBehind->timer == nullptr) {
+      writeBehind->timer = new uv_timer_t;
+      uv_timer_init(&desc->core->eventLoop, writeBehind->timer);
+      writeBehind->timer->data = (void *) desc;
+    }
+
+    if (uv_is_active((uv_handle_t*) writeBehind->timer)) {
+      return;
+    }
+
+    uv_timer_start(writeBehind->timer, [](uv_timer_t* handle) {
+      flushWriteBehind(static_cast<Core::FS::Descriptor*>(handle->data));
+    }, Core::FS::WRITE_BEHIND_WINDOW, 0);
+  }
+
+  static void commitWriteBehind (
+    Core::FS::Descriptor* desc,
+    Vector<Core::FS::WriteBehind::Write>& writes,
+    int64_t result
+  ) {
+    auto writeBehind = &desc->writeBehind;
+
+    if (result < 0) {
+      // the writes were already answered, see `takeWriteBehindError()`
+      if (writeBehind->err == 0) {
+        writeBehind->err = (int) result;
+      }
+
+      writeBehind->committed = writes.back().number;
+      return;
+    }
+
+    // a short write puts what was not written back at the front of the queue
+    auto remaining = result;
+    auto unwritten = Vector<Core::FS::WriteBehind::Write> {};
+
+    for (auto& write : writes) {
+      auto size = (int64_t) (write.bytes.size() - write.start);
+
+      if (remaining >= size) {
+        remaining -= size;
+        writeBehind->committed = write.number;
+        continue;
+      }
+
+      write.start += remaining;
+
+      if (write.offset >= 0) {
+        write.offset += remaining;
+      }
+
+      writeBehind->bytes += write.bytes.size() - write.start;
+      remaining = 0;
+      unwritten.push_back(std::move(write));
+    }
+
+    writeBehind->queue.insert(
+      writeBehind->queue.begin(),
+      std::make_move_iterator(unwritten.begin()),
+      std::make_move_iterator(unwritten.end())
+    );
+  }
+
+  // Writes the queued writes that are contiguous with the first one in a
+  // single vectored write (pwritev(2)), one batch in flight at a time.
+  static void flushWriteBehind (Core::FS::Descriptor* desc) {
+    auto writeBehind = &desc->writeBehind;
+
+    if (writeBehind->timer != nullptr) {
+      uv_timer_stop(writeBehind->timer);
+    }
+
+    if (writeBehind->writing || writeBehind->queue.size() == 0) {
+      return notifyDescriptorDrained(desc);
+    }
+
+    auto loop = &desc->core->eventLoop;
+    auto ctx = new WriteBehindContext();
+    auto offset = writeBehind->queue.front().offset;
+    auto end = offset;
+    size_t count = 0;
+    size_t bytes = 0;
+
+    for (const auto& write : writeBehind->queue) {
+      auto size = write.bytes.size() - write.start;
+
+      // `-1` writes at the current position, so those are always adjacent
+      if (offset >= 0 && write.offset != end) {
+        break;
+      } else if (offset < 0 && write.offset >= 0) {
+        break;
+      } else if (count > 0 && bytes + size > Core::FS::WRITE_BEHIND_MAX_BYTES) {
+        break;
+      }
+
+      ctx->bufs.push_back(uv_buf_init(
+        (char *) write.bytes.data() + write.start,
+        (unsigned int) size
+      ));
+
+      end += size;
+      bytes += size;
+      count++;
+    }
+
+    ctx->desc = desc;
+    ctx->req.data = (void *) ctx;
+    ctx->writes.assign(
+      std::make_move_iterator(writeBehind->queue.begin()),
+      std::make_move_iterator(writeBehind->queue.begin() + count)
+    );
+
+    writeBehind->queue.erase(
+      writeBehind->queue.begin(),
+      writeBehind->queue.begin() + count
+    );
+
+    writeBehind->bytes -= bytes;
+    writeBehind->writing = true;
+
+    auto err = uv_fs_write(loop, &ctx->req, desc->fd, ctx->bufs.data(), ctx->bufs.size(), offset, [](uv_fs_t* req) {
+      auto ctx = static_cast<WriteBehindContext*>(req->data);
+      auto desc = ctx->desc;
+
+      commitWriteBehind(desc, ctx->writes, uv_fs_get_result(req));
+      uv_fs_req_cleanup(req);
+      delete ctx;
+
+      // the file changed after the writes were answered
+      desc->core->fs.resetReadAhead(desc->path);
+
+      desc->writeBehind.writing = false;
+      notifyDescriptorDrained(desc);
+      flushWriteBehind(desc);
+    });
+
+    if (err < 0) {
+      commitWriteBehind(desc, ctx->writes, err);
+      delete ctx;
+
+      writeBehind->writing = false;
+      flushWriteBehind(desc);
+    }
+  }
+
+  static void replyToGroupCommit (
     uint64_t id,
-    Module::Callback cb
+    Vector<Core::Module::RequestContext>& waiters,
+    int64_t result
   ) {
-    this->core->dispatchEventLoop([=, this]() {
-      auto desc = getDescriptor(id);
+    auto json = JSON::Object {};
 
-      if (desc == nullptr) {
-        auto json = JSON::Object::Entries {
+    if (result < 0) {
+      json = JSON::Object::Entries {
+        {"source", "fs.fsync"},
+        {"err", JSON::Object::Entries {
+          {"id", std::to_string(id)},
+          {"code", result},
+          {"message", String(uv_strerror((int) result))}
+        }}
+      };
+    } else {
+      json = JSON::Object::Entries {
+        {"source", "fs.fsync"},
+        {"data", JSON::Object::Entries {
+          {"result", result},
+        }}
+      };
+    }
+
+    for (const auto& waiter : waiters) {
+      waiter.cb(waiter.seq, json, Post{});
+    }
+  }
+
+  // Resolves every `fsync` waiting on a descriptor with one fsync(2). Waiters
+  // that arrive while it is in flight are resolved by the next one.
+  static void startGroupCommit (Core::FS::Descriptor* desc) {
+    auto groupCommit = &desc->groupCommit;
+
+    if (groupCommit->syncing || groupCommit->waiters.size() == 0) {
+      return;
+    }
+
+    auto loop = &desc->core->eventLoop;
+    auto ctx = new GroupCommitContext();
+
+    ctx->desc = desc;
+    ctx->req.data = (void *) ctx;
+    ctx->waiters = std::move(groupCommit->waiters);
+    groupCommit->waiters.clear();
+    groupCommit->syncing = true;
+
+    auto err = uv_fs_fsync(loop, &ctx->req, desc->fd, [](uv_fs_t* req) {
+      auto ctx = static_cast<GroupCommitContext*>(req->data);
+      auto desc = ctx->desc;
+
+      replyToGroupCommit(desc->id, ctx->waiters, uv_fs_get_result(req));
+      uv_fs_req_cleanup(req);
+      delete ctx;
+
+      desc->groupCommit.syncing = false;
+      startGroupCommit(desc);
+      notifyDescriptorDrained(desc);
+    });
+
+    if (err < 0) {
+      replyToGroupCommit(desc->id, ctx->waiters, err);
+      delete ctx;
+
+      groupCommit->syncing = false;
+      notifyDescriptorDrained(desc);
+    }
+  }
+
+  static void closeDescriptor (
+    Core::FS::Descriptor* desc,
+    const String seq,
+    Core::Module::Callback cb
+  ) {
+    closeWriteBehindTimer(desc);
+
+    auto loop = &desc->core->eventLoop;
+    auto ctx = new Core::FS::RequestContext(desc, seq, cb);
+    auto req = &ctx->req;
+    auto err = uv_fs_close(loop, req, desc->fd, [](uv_fs_t* req) {
+      auto ctx = (Core::FS::RequestContext *) req->data;
+      auto desc = ctx->desc;
+      auto json = JSON::Object {};
+      auto writeBehindError = takeWriteBehindError(desc);
+
+      if (uv_fs_get_result(req) < 0) {
+        json = JSON::Object::Entries {
           {"source", "fs.close"},
           {"err", JSON::Object::Entries {
-            {"id", std::to_string(id)},
-            {"code", "ENOTOPEN"},
-            {"type", "NotFoundError"},
-            {"message", "No file descriptor found with that id"}
+            {"id", std::to_string(desc->id)},
+            {"code", req->result},
+            {"message", String(uv_strerror((int) req->result))}
           }}
         };
-
-        return cb(seq, json, Post{});
-      }
-
-      auto loop = &this->core->eventLoop;
-      auto ctx = new RequestContext(desc, seq, cb);
-      auto req = &ctx->req;
-      auto err = uv_fs_close(loop, req, desc->fd, [](uv_fs_t* req) {
-        auto ctx = (RequestContext *) req->data;
-        auto desc = ctx->desc;
-        auto json = JSON::Object {};
-
-        if (uv_fs_get_result(req) < 0) {
+      } else {
+        if (writeBehindError < 0) {
           json = JSON::Object::Entries {
             {"source", "fs.close"},
             {"err", JSON::Object::Entries {
               {"id", std::to_string(desc->id)},
-              {"code", req->result},
-              {"message", String(uv_strerror((int) req->result))}
+              {"code", writeBehindError},
+              {"message", String(uv_strerror(writeBehindError))}
             }}
           };
         } else {
@@ -550,28 +1097,76 @@ namespace SSC {
               {"fd", desc->fd}
             }}
           };
-
-          desc->core->fs.removeDescriptor(desc->id);
-          delete desc;
         }
 
-        ctx->cb(ctx->seq, json, Post{});
-        delete ctx;
-      });
+        // the descriptor is gone even if a buffered write failed
+        desc->core->fs.removeDescriptor(desc->id);
+        delete desc;
+      }
 
-      if (err < 0) {
+      ctx->cb(ctx->seq, json, Post{});
+      delete ctx;
+    });
+
+    if (err < 0) {
+      auto json = JSON::Object::Entries {
+        {"source", "fs.close"},
+        {"err", JSON::Object::Entries {
+          {"id", std::to_string(desc->id)},
+          {"code", err},
+          {"message", String(uv_strerror(err))}
+        }}
+      };
+
+      ctx->cb(ctx->seq, json, Post{});
+      delete ctx;
+    }
+  }
+
+  // an fsync in flight must finish before its descriptor is closed
+  static void closeWhenSynced (
+    Core::FS::Descriptor* desc,
+    std::function<void()> close
+  ) {
+    if (!desc->groupCommit.syncing) {
+      return close();
+    }
+
+    desc->writeBehind.drained.push_back(Core::FS::WriteBehind::Drained {
+      0,
+      [desc, close]() { closeWhenSynced(desc, close); }
+    });
+  }
+
+  void Core::FS::close (
+    const String seq,
+    uint64_t id,
+    Module::Callback cb
+  ) {
+    this->core->dispatchEventLoop([=, this]() {
+      auto desc = getDescriptor(id);
+
+      if (desc == nullptr) {
         auto json = JSON::Object::Entries {
           {"source", "fs.close"},
           {"err", JSON::Object::Entries {
-            {"id", std::to_string(desc->id)},
-            {"code", err},
-            {"message", String(uv_strerror(err))}
+            {"id", std::to_string(id)},
+            {"code", "ENOTOPEN"},
+            {"type", "NotFoundError"},
+            {"message", "No file descriptor found with that id"}
           }}
         };
 
-        ctx->cb(ctx->seq, json, Post{});
-        delete ctx;
+        return cb(seq, json, Post{});
       }
+
+      // wait for the buffered writes queued before the close to be
+      // committed, later writes do not postpone it
+      whenWriteBehindDrained(desc, [=]() {
+        closeWhenSynced(desc, [=]() {
+          closeDescriptor(desc, seq, cb);
+        });
+      });
     });
   }
 
@@ -582,10 +1177,24 @@ namespace SSC {
     int flags,
     int mode,
     Module::Callback cb
+  ) {
+    this->open(seq, id, path, flags, mode, OpenOptions {}, cb);
+  }
+
+  void Core::FS::open (
+    const String seq,
+    uint64_t id,
+    const String path,
+    int flags,
+    int mode,
+    OpenOptions options,
+    Module::Callback cb
   ) {
     this->core->dispatchEventLoop([=, this]() {
       auto filename = path.c_str();
       auto desc = new Descriptor(this->core, id);
+      desc->path = path;
+      desc->writeBehind.enabled = options.writeBehind;
       auto loop = &this->core->eventLoop;
       auto ctx = new RequestContext(desc, seq, cb);
       auto req = &ctx->req;
@@ -615,9 +1224,9 @@ namespace SSC {
           };
 
           desc->fd = (int) req->result;
-          // insert into `descriptors` map
+          // insert into `descriptors` table
           Lock lock(desc->core->fs.mutex);
-          desc->core->fs.descriptors.insert_or_assign(desc->id, desc);
+          desc->core->fs.descriptors.insert(desc);
         }
 
         ctx->cb(ctx->seq, json, Post{});
@@ -678,9 +1287,9 @@ namespace SSC {
           };
 
           desc->dir = (uv_dir_t *) req->ptr;
-          // insert into `descriptors` map
+          // insert into `descriptors` table
           Lock lock(desc->core->fs.mutex);
-          desc->core->fs.descriptors.insert_or_assign(desc->id, desc);
+          desc->core->fs.descriptors.insert(desc);
         }
 
         ctx->cb(ctx->seq, json, Post{});
@@ -929,16 +1538,15 @@ namespace SSC {
     auto json = JSON::Object {};
     auto ids = Vector<uint64_t> {};
 
-    for (auto const &tuple : descriptors) {
-      ids.push_back(tuple.first);
-    }
+    descriptors.forEach([&ids](auto desc) {
+      ids.push_back(desc->id);
+    });
 
     for (auto const id : ids) {
-      auto desc = descriptors[id];
+      auto desc = descriptors.get(id);
       pending--;
 
       if (desc == nullptr) {
-        descriptors.erase(id);
         continue;
       }
 
@@ -968,11 +1576,155 @@ namespace SSC {
     }
   }
 
+  Core::FS::ReadAhead::~ReadAhead () {
+    this->reset();
+  }
+
+  void Core::FS::ReadAhead::reset () {
+    for (auto chunk : this->chunks) {
+      if (chunk->done) {
+        delete [] chunk->buf.base;
+        delete chunk;
+      } else {
+        // still in flight, freed when the read completes
+        chunk->owner = nullptr;
+      }
+    }
+
+    this->chunks.clear();
+    this->scheduledOffset = 0;
+    this->eof = false;
+  }
+
+  static void replyWithReadAheadChunk (Core::FS::ReadAheadChunk* chunk) {
+    auto json = JSON::Object {};
+    Post post = {0};
+
+    if (chunk->result < 0) {
+      json = JSON::Object::Entries {
+        {"source", "fs.read"},
+        {"err", JSON::Object::Entries {
+          {"id", std::to_string(chunk->id)},
+          {"code", chunk->result},
+          {"message", String(uv_strerror((int) chunk->result))}
+        }}
+      };
+
+      delete [] chunk->buf.base;
+    } else {
+      auto length = std::min((size_t) chunk->result, chunk->size);
+      auto headers = Headers {{
+        {"content-type" ,"application/octet-stream"},
+        {"content-length", length}
+      }};
+
+      // the chunk buffer is handed off as the post body
+      post.id = SSC::rand64();
+      post.body = chunk->buf.base;
+      post.length = (int) length;
+      post.headers = std::move(headers);
+    }
+
+    chunk->buf.base = nullptr;
+    chunk->cb(chunk->seq, json, post);
+  }
+
+  // Keeps `window` chunks of `size` bytes in flight past the current read,
+  // holding no more than `MAX_READ_AHEAD_BYTES`
+  static void scheduleReadAhead (
+    Core::FS::Descriptor* desc,
+    size_t offset,
+    size_t size
+  ) {
+    auto readAhead = &desc->readAhead;
+    auto loop = &desc->core->eventLoop;
+
+    if (
+      size == 0 ||
+      readAhead->eof ||
+      readAhead->window == 0 ||
+      readAhead->streak < Core::FS::READ_AHEAD_SEQUENTIAL_THRESHOLD
+    ) {
+      return;
+    }
+
+    if (!readAhead->advised) {
+    #if defined(__linux__)
+      posix_fadvise(desc->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    #elif defined(__APPLE__)
+      fcntl(desc->fd, F_RDAHEAD, 1);
+    #endif
+      readAhead->advised = true;
+    }
+
+    auto next = std::max(readAhead->scheduledOffset, offset + size);
+
+    auto window = std::min(
+      readAhead->window,
+      Core::FS::MAX_READ_AHEAD_BYTES / size
+    );
+
+    while (readAhead->chunks.size() < window) {
+      auto chunk = new Core::FS::ReadAheadChunk();
+      chunk->owner = readAhead;
+      chunk->id = desc->id;
+      chunk->offset = next;
+      chunk->buf.base = new char[size]{0};
+      chunk->buf.len = size;
+      chunk->req.data = (void *) chunk;
+
+      auto err = uv_fs_read(loop, &chunk->req, desc->fd, &chunk->buf, 1, next, [](uv_fs_t* req) {
+        auto chunk = static_cast<Core::FS::ReadAheadChunk*>(req->data);
+
+        chunk->result = uv_fs_get_result(req);
+        chunk->done = true;
+        uv_fs_req_cleanup(req);
+
+        // stop reading ahead at the end of the file, a direct read that
+        // returns data again clears `eof` for files that grow
+        if (chunk->owner != nullptr && chunk->result < (int64_t) chunk->buf.len) {
+          chunk->owner->eof = true;
+        }
+
+        if (chunk->cb != nullptr) {
+          // a read was waiting on this chunk
+          replyWithReadAheadChunk(chunk);
+          delete chunk;
+        } else if (chunk->owner == nullptr) {
+          delete [] chunk->buf.base;
+          delete chunk;
+        }
+      });
+
+      if (err < 0) {
+        delete [] chunk->buf.base;
+        delete chunk;
+        break;
+      }
+
+      readAhead->chunks.push_back(chunk);
+      next += size;
+    }
+
+    readAhead->scheduledOffset = next;
+  }
+
+  void Core::FS::read (
+    const String seq,
+    uint64_t id,
+    size_t size,
+    size_t offset,
+    Module::Callback cb
+  ) {
+    this->read(seq, id, size, offset, ReadOptions {}, cb);
+  }
+
   void Core::FS::read (
     const String seq,
     uint64_t id,
     size_t size,
     size_t offset,
+    ReadOptions options,
     Module::Callback cb
   ) {
     this->core->dispatchEventLoop([=, this]() {
@@ -992,6 +1744,49 @@ namespace SSC {
         return cb(seq, json, Post{});
       }
 
+      // buffered writes are answered before they reach the file
+      if (desc->writeBehind.committed < desc->writeBehind.queued) {
+        return whenWriteBehindDrained(desc, [=, this]() {
+          this->read(seq, id, size, offset, options, cb);
+        });
+      }
+
+      auto readAhead = &desc->readAhead;
+      auto sequential = offset == readAhead->expectedOffset;
+
+      readAhead->window = std::min(options.readAhead, MAX_READ_AHEAD_WINDOW);
+      readAhead->streak = sequential ? readAhead->streak + 1 : 0;
+      readAhead->expectedOffset = offset + size;
+
+      if (!sequential) {
+        readAhead->reset();
+      } else if (readAhead->chunks.size() > 0) {
+        auto chunk = readAhead->chunks.front();
+
+        // short chunks are never served from the cache, the file may have
+        // grown since they were read
+        auto complete = !chunk->done || chunk->result == (int64_t) chunk->buf.len;
+
+        if (chunk->offset == offset && chunk->buf.len >= size && complete) {
+          // served from a chunk read ahead, or when it lands if in flight
+          readAhead->chunks.erase(readAhead->chunks.begin());
+          chunk->owner = nullptr;
+          chunk->seq = seq;
+          chunk->cb = cb;
+          chunk->size = size;
+
+          if (chunk->done) {
+            replyWithReadAheadChunk(chunk);
+            delete chunk;
+          }
+
+          return scheduleReadAhead(desc, offset, size);
+        }
+
+        // chunk size or position changed, or the chunk is short, start over
+        readAhead->reset();
+      }
+
       auto loop = &this->core->eventLoop;
       auto ctx = new RequestContext(desc, seq, cb);
       auto req = &ctx->req;
@@ -1028,7 +1823,12 @@ namespace SSC {
           post.id = SSC::rand64();
           post.body = ctx->getBuffer();
           post.length = (int) req->result;
-          post.headers = headers.str();
+          post.headers = std::move(headers);
+
+          // the file has data past a previous end of file, read ahead again
+          if (req->result > 0) {
+            desc->readAhead.eof = false;
+          }
         }
 
         ctx->cb(ctx->seq, json, post);
@@ -1048,6 +1848,140 @@ namespace SSC {
         ctx->cb(ctx->seq, json, Post{});
         delete [] bytes;
         delete ctx;
+        return;
+      }
+
+      scheduleReadAhead(desc, offset, size);
+    });
+  }
+
+  struct ReadFileContext {
+    String seq;
+    Core::Module::Callback cb;
+    uv_work_t req;
+    String path;
+    Core::FS::ReadFileOptions options;
+    char *bytes = nullptr;
+    size_t size = 0;
+    int err = 0;
+  };
+
+  void Core::FS::readFile (
+    const String seq,
+    const String path,
+    ReadFileOptions options,
+    Module::Callback cb
+  ) {
+    this->core->dispatchEventLoop([=, this]() {
+      auto loop = &this->core->eventLoop;
+      auto ctx = new ReadFileContext();
+
+      ctx->seq = seq;
+      ctx->cb = cb;
+      ctx->path = path;
+      ctx->options = options;
+      ctx->req.data = (void *) ctx;
+
+      // open, fstat, read and close with synchronous calls on the threadpool
+      auto err = uv_queue_work(loop, &ctx->req, [](uv_work_t* work) {
+        auto ctx = static_cast<ReadFileContext*>(work->data);
+        auto filename = ctx->path.c_str();
+        uv_fs_t req;
+
+        auto fd = uv_fs_open(nullptr, &req, filename, ctx->options.flags, 0, nullptr);
+        uv_fs_req_cleanup(&req);
+
+        if (fd < 0) {
+          ctx->err = fd;
+          return;
+        }
+
+        auto err = uv_fs_fstat(nullptr, &req, fd, nullptr);
+        auto expected = err < 0 ? 0 : (size_t) req.statbuf.st_size;
+        uv_fs_req_cleanup(&req);
+
+        // files without a size (pipes, procfs) are read until EOF
+        auto capacity = expected > 0 ? expected : (size_t) 64 * 1024;
+        ctx->bytes = new char[capacity]{0};
+
+        while (true) {
+          if (ctx->size == capacity) {
+            if (expected > 0) {
+              break;
+            }
+
+            auto bytes = new char[capacity * 2]{0};
+            memcpy(bytes, ctx->bytes, ctx->size);
+            delete [] ctx->bytes;
+            ctx->bytes = bytes;
+            capacity *= 2;
+          }
+
+          auto length = std::min(capacity - ctx->size, Core::FS::MAX_IO_CHUNK_SIZE);
+          auto buf = uv_buf_init(ctx->bytes + ctx->size, (unsigned int) length);
+          auto result = uv_fs_read(nullptr, &req, fd, &buf, 1, (int64_t) ctx->size, nullptr);
+          uv_fs_req_cleanup(&req);
+
+          if (result < 0) {
+            ctx->err = result;
+            break;
+          } else if (result == 0) {
+            break;
+          }
+
+          ctx->size += result;
+        }
+
+        uv_fs_close(nullptr, &req, fd, nullptr);
+        uv_fs_req_cleanup(&req);
+      }, [](uv_work_t* work, int status) {
+        auto ctx = static_cast<ReadFileContext*>(work->data);
+        auto err = ctx->err < 0 ? ctx->err : status;
+
+        if (err < 0) {
+          auto json = JSON::Object::Entries {
+            {"source", "fs.readFile"},
+            {"err", JSON::Object::Entries {
+              {"code", err},
+              {"message", String(uv_strerror(err))}
+            }}
+          };
+
+          if (ctx->bytes != nullptr) {
+            delete [] ctx->bytes;
+          }
+
+          ctx->cb(ctx->seq, json, Post{});
+          delete ctx;
+          return;
+        }
+
+        auto post = Post {};
+        auto headers = Headers {{
+          {"content-type" ,"application/octet-stream"},
+          {"content-length", ctx->size}
+        }};
+
+        post.id = SSC::rand64();
+        post.body = ctx->bytes;
+        post.length = ctx->size;
+        post.headers = std::move(headers);
+
+        ctx->cb(ctx->seq, JSON::Object {}, post);
+        delete ctx;
+      });
+
+      if (err < 0) {
+        auto json = JSON::Object::Entries {
+          {"source", "fs.readFile"},
+          {"err", JSON::Object::Entries {
+            {"code", err},
+            {"message", String(uv_strerror(err))}
+          }}
+        };
+
+        ctx->cb(ctx->seq, json, Post{});
+        delete ctx;
       }
     });
   }
@@ -1161,6 +2095,49 @@ namespace SSC {
         return cb(seq, json, Post{});
       }
 
+      // data read ahead here or by other descriptors open at the same path
+      // may no longer match the file
+      desc->readAhead.reset();
+      this->resetReadAhead(desc->path);
+
+      if (desc->writeBehind.enabled) {
+        auto writeBehind = &desc->writeBehind;
+        auto err = takeWriteBehindError(desc);
+
+        if (err < 0) {
+          auto json = JSON::Object::Entries {
+            {"source", "fs.write"},
+            {"err", JSON::Object::Entries {
+              {"id", std::to_string(desc->id)},
+              {"code", err},
+              {"message", String(uv_strerror(err))}
+            }}
+          };
+
+          return cb(seq, json, Post{});
+        }
+
+        writeBehind->queue.push_back(WriteBehind::Write {
+          String(bytes, size),
+          0,
+          (int64_t) offset,
+          ++writeBehind->queued
+        });
+
+        writeBehind->bytes += size;
+        scheduleWriteBehind(desc);
+
+        auto json = JSON::Object::Entries {
+          {"source", "fs.write"},
+          {"data", JSON::Object::Entries {
+            {"id", std::to_string(desc->id)},
+            {"result", size}
+          }}
+        };
+
+        return cb(seq, json, Post{});
+      }
+
       auto loop = &this->core->eventLoop;
       auto ctx = new RequestContext(desc, seq, cb);
       auto req = &ctx->req;
@@ -1210,9 +2187,187 @@ namespace SSC {
     });
   }
 
+  struct WriteFileContext {
+    Core *core = nullptr;
+    String seq;
+    Core::Module::Callback cb;
+    uv_work_t req;
+    String path;
+    Core::FS::WriteFileOptions options;
+    char *bytes = nullptr;
+    size_t size = 0;
+    int err = 0;
+  };
+
+  static int writeFileContents (uv_file fd, char *bytes, size_t size) {
+    uv_fs_t req;
+    size_t written = 0;
+
+    while (written < size) {
+      auto length = std::min(size - written, Core::FS::MAX_IO_CHUNK_SIZE);
+      auto buf = uv_buf_init(bytes + written, (unsigned int) length);
+      auto result = uv_fs_write(nullptr, &req, fd, &buf, 1, -1, nullptr);
+      uv_fs_req_cleanup(&req);
+
+      if (result < 0) {
+        return result;
+      }
+
+      written += result;
+    }
+
+    return 0;
+  }
+
+  void Core::FS::writeFile (
+    const String seq,
+    const String path,
+    char *bytes,
+    size_t size,
+    WriteFileOptions options,
+    Module::Callback cb
+  ) {
+    this->core->dispatchEventLoop([=, this]() {
+      auto loop = &this->core->eventLoop;
+      auto ctx = new WriteFileContext();
+
+      ctx->core = this->core;
+      ctx->seq = seq;
+      ctx->cb = cb;
+      ctx->path = path;
+      ctx->bytes = bytes;
+      ctx->size = size;
+      ctx->options = options;
+      ctx->req.data = (void *) ctx;
+
+      // open, write and close with synchronous calls on the threadpool
+      auto err = uv_queue_work(loop, &ctx->req, [](uv_work_t* work) {
+        auto ctx = static_cast<WriteFileContext*>(work->data);
+        auto filename = ctx->path;
+        auto flags = ctx->options.flags;
+        uv_fs_t req;
+
+        if (ctx->options.atomic) {
+          filename = ctx->path + ".tmp-" + std::to_string(SSC::rand64());
+          flags = UV_FS_O_WRONLY | UV_FS_O_CREAT | UV_FS_O_EXCL | UV_FS_O_TRUNC;
+        }
+
+        auto fd = uv_fs_open(nullptr, &req, filename.c_str(), flags, ctx->options.mode, nullptr);
+        uv_fs_req_cleanup(&req);
+
+        if (fd < 0) {
+          ctx->err = fd;
+          return;
+        }
+
+        ctx->err = writeFileContents(fd, ctx->bytes, ctx->size);
+
+        if (ctx->err == 0 && ctx->options.atomic) {
+          ctx->err = uv_fs_fsync(nullptr, &req, fd, nullptr);
+          uv_fs_req_cleanup(&req);
+        }
+
+        auto err = uv_fs_close(nullptr, &req, fd, nullptr);
+        uv_fs_req_cleanup(&req);
+
+        if (ctx->err == 0) {
+          ctx->err = err;
+        }
+
+        if (ctx->options.atomic) {
+          if (ctx->err == 0) {
+            ctx->err = uv_fs_rename(nullptr, &req, filename.c_str(), ctx->path.c_str(), nullptr);
+            uv_fs_req_cleanup(&req);
+          }
+
+          if (ctx->err < 0) {
+            uv_fs_unlink(nullptr, &req, filename.c_str(), nullptr);
+            uv_fs_req_cleanup(&req);
+          }
+
+        #if !defined(_WIN32)
+          // persist the rename, which is an entry in the parent directory
+          if (ctx->err == 0) {
+            auto dirname = std::filesystem::path(ctx->path).parent_path().string();
+
+            if (dirname.size() == 0) {
+              dirname = ".";
+            }
+
+            auto dir = uv_fs_open(nullptr, &req, dirname.c_str(), UV_FS_O_RDONLY, 0, nullptr);
+            uv_fs_req_cleanup(&req);
+
+            if (dir >= 0) {
+              auto err = uv_fs_fsync(nullptr, &req, dir, nullptr);
+              uv_fs_req_cleanup(&req);
+
+              // some file systems cannot sync a directory
+              if (err < 0 && err != UV_EINVAL) {
+                ctx->err = err;
+              }
+
+              uv_fs_close(nullptr, &req, dir, nullptr);
+              uv_fs_req_cleanup(&req);
+            }
+          }
+        #endif
+        }
+      }, [](uv_work_t* work, int status) {
+        auto ctx = static_cast<WriteFileContext*>(work->data);
+        auto err = ctx->err < 0 ? ctx->err : status;
+        auto json = JSON::Object {};
+
+        // descriptors open at `path` may have read ahead the previous contents
+        ctx->core->fs.resetReadAhead(ctx->path);
+
+        if (err < 0) {
+          json = JSON::Object::Entries {
+            {"source", "fs.writeFile"},
+            {"err", JSON::Object::Entries {
+              {"code", err},
+              {"message", String(uv_strerror(err))}
+            }}
+          };
+        } else {
+          json = JSON::Object::Entries {
+            {"source", "fs.writeFile"},
+            {"data", JSON::Object::Entries {
+              {"result", ctx->size}
+            }}
+          };
+        }
+
+        ctx->cb(ctx->seq, json, Post{});
+        delete ctx;
+      });
+
+      if (err < 0) {
+        auto json = JSON::Object::Entries {
+          {"source", "fs.writeFile"},
+          {"err", JSON::Object::Entries {
+            {"code", err},
+            {"message", String(uv_strerror(err))}
+          }}
+        };
+
+        ctx->cb(ctx->seq, json, Post{});
+        delete ctx;
+      }
+    });
+  }
+
+  void Core::FS::stat (
+    const String seq,
+    const String path,
+    Module::Callback cb
+  ) {
+    this->stat(seq, path, StatOptions {}, cb);
+  }
+
   void Core::FS::stat (
     const String seq,
     const String path,
+    StatOptions options,
     Module::Callback cb
   ) {
     this->core->dispatchEventLoop([=, this]() {
@@ -1220,9 +2375,11 @@ namespace SSC {
       auto loop = &this->core->eventLoop;
       auto ctx = new RequestContext(seq, cb);
       auto req = &ctx->req;
+      ctx->binary = options.binary;
       auto err = uv_fs_stat(loop, req, filename, [](uv_fs_t *req) {
         auto ctx = (RequestContext *) req->data;
         auto json = JSON::Object {};
+        auto post = Post {};
 
         if (uv_fs_get_result(req) < 0) {
           json = JSON::Object::Entries {
@@ -1232,11 +2389,15 @@ namespace SSC {
               {"message", String(uv_strerror((int) req->result))}
             }}
           };
+        } else if (ctx->binary) {
+          auto body = new char[STATS_RECORD_SIZE]{0};
+          writeStatsRecord(body, 0, uv_fs_get_statbuf(req));
+          post = getStatsPost(body, STATS_RECORD_SIZE);
         } else {
           json = getStatsJSON("fs.stat", uv_fs_get_statbuf(req));
         }
 
-        ctx->cb(ctx->seq, json, Post{});
+        ctx->cb(ctx->seq, json, post);
         delete ctx;
       });
 
@@ -1255,6 +2416,52 @@ namespace SSC {
     });
   }
 
+  void Core::FS::statMany (
+    const String seq,
+    const Vector<String> paths,
+    Module::Callback cb
+  ) {
+    this->core->dispatchEventLoop([=, this]() {
+      auto loop = &this->core->eventLoop;
+      auto batch = new StatManyContext();
+      // the extra pending count guards against completing the batch while
+      // requests are still being queued below
+      batch->pending = paths.size() + 1;
+      batch->size = paths.size() * STATS_RECORD_SIZE;
+      batch->body = new char[batch->size]{0};
+      batch->reqs.resize(paths.size());
+      batch->seq = seq;
+      batch->cb = cb;
+
+      for (size_t i = 0; i < paths.size(); ++i) {
+        auto req = &batch->reqs[i];
+        req->data = (void *) batch;
+        auto err = uv_fs_stat(loop, req, paths[i].c_str(), [](uv_fs_t* req) {
+          auto batch = (StatManyContext *) req->data;
+          auto index = (size_t) (req - batch->reqs.data());
+          auto bytes = batch->body + index * STATS_RECORD_SIZE;
+          auto result = uv_fs_get_result(req);
+
+          if (result < 0) {
+            writeStatsRecord(bytes, result, nullptr);
+          } else {
+            writeStatsRecord(bytes, 0, uv_fs_get_statbuf(req));
+          }
+
+          uv_fs_req_cleanup(req);
+          finishStatMany(batch);
+        });
+
+        if (err < 0) {
+          writeStatsRecord(batch->body + i * STATS_RECORD_SIZE, err, nullptr);
+          finishStatMany(batch);
+        }
+      }
+
+      finishStatMany(batch);
+    });
+  }
+
   void Core::FS::stopWatch (
     const String seq,
     uint64_t id,
@@ -1321,47 +2528,27 @@ namespace SSC {
         return cb(seq, json, Post{});
       }
 
-      auto loop = &this->core->eventLoop;
-      auto ctx = new RequestContext(desc, seq, cb);
-      auto req = &ctx->req;
-      auto err = uv_fs_fsync(loop, req, desc->fd, [](uv_fs_t *req) {
-        auto ctx = (RequestContext *) req->data;
-        auto json = JSON::Object {};
+      // joins the group commit once the buffered writes queued before it
+      // are committed, concurrent calls are coalesced into one fsync(2)
+      whenWriteBehindDrained(desc, [=]() {
+        auto err = takeWriteBehindError(desc);
 
-        if (uv_fs_get_result(req) < 0) {
-          json = JSON::Object::Entries {
+        if (err < 0) {
+          auto json = JSON::Object::Entries {
             {"source", "fs.fsync"},
             {"err", JSON::Object::Entries {
-              {"code", req->result},
-              {"message", String(uv_strerror((int) req->result))}
-            }}
-          };
-        } else {
-          json = JSON::Object::Entries {
-            {"source", "fs.fsync"},
-            {"data", JSON::Object::Entries {
-              {"result", req->result},
+              {"id", std::to_string(desc->id)},
+              {"code", err},
+              {"message", String(uv_strerror(err))}
             }}
           };
+
+          return cb(seq, json, Post{});
         }
 
-        ctx->cb(ctx->seq, json, Post{});
-        delete ctx;
+        desc->groupCommit.waiters.push_back(Module::RequestContext(seq, cb));
+        startGroupCommit(desc);
       });
-
-      if (err < 0) {
-        auto json = JSON::Object::Entries {
-          {"source", "fs.fsync"},
-          {"err", JSON::Object::Entries {
-            {"id", std::to_string(id)},
-            {"code", err},
-            {"message", String(uv_strerror(err))}
-          }}
-        };
-
-        ctx->cb(ctx->seq, json, Post{});
-        delete ctx;
-      }
     });
   }
 
@@ -1388,6 +2575,18 @@ namespace SSC {
         return cb(seq, json, Post{});
       }
 
+      // buffered writes are answered before they reach the file
+      if (desc->writeBehind.committed < desc->writeBehind.queued) {
+        return whenWriteBehindDrained(desc, [=, this]() {
+          this->ftruncate(seq, id, offset, cb);
+        });
+      }
+
+      // data read ahead here or by other descriptors open at the same path
+      // may no longer match the file
+      desc->readAhead.reset();
+      this->resetReadAhead(desc->path);
+
       auto loop = &this->core->eventLoop;
       auto ctx = new RequestContext(desc, seq, cb);
       auto req = &ctx->req;
@@ -1436,6 +2635,15 @@ namespace SSC {
     const String seq,
     uint64_t id,
     Module::Callback cb
+  ) {
+    this->fstat(seq, id, StatOptions {}, cb);
+  }
+
+  void Core::FS::fstat (
+    const String seq,
+    uint64_t id,
+    StatOptions options,
+    Module::Callback cb
   ) {
     this->core->dispatchEventLoop([=, this]() {
       auto desc = getDescriptor(id);
@@ -1454,13 +2662,22 @@ namespace SSC {
         return cb(seq, json, Post{});
       }
 
+      // buffered writes are answered before they reach the file
+      if (desc->writeBehind.committed < desc->writeBehind.queued) {
+        return whenWriteBehindDrained(desc, [=, this]() {
+          this->fstat(seq, id, options, cb);
+        });
+      }
+
       auto loop = &this->core->eventLoop;
       auto ctx = new RequestContext(desc, seq, cb);
       auto req = &ctx->req;
+      ctx->binary = options.binary;
       auto err = uv_fs_fstat(loop, req, desc->fd, [](uv_fs_t *req) {
         auto ctx = (RequestContext *) req->data;
         auto desc = ctx->desc;
         auto json = JSON::Object {};
+        auto post = Post {};
 
         if (uv_fs_get_result(req) < 0) {
           json = JSON::Object::Entries {
@@ -1471,11 +2688,15 @@ namespace SSC {
               {"message", String(uv_strerror((int) req->result))}
             }}
           };
+        } else if (ctx->binary) {
+          auto body = new char[STATS_RECORD_SIZE]{0};
+          writeStatsRecord(body, 0, uv_fs_get_statbuf(req));
+          post = getStatsPost(body, STATS_RECORD_SIZE);
         } else {
           json = getStatsJSON("fs.fstat", uv_fs_get_statbuf(req));
         }
 
-        ctx->cb(ctx->seq, json, Post{});
+        ctx->cb(ctx->seq, json, post);
         delete ctx;
       });
 
@@ -1502,11 +2723,9 @@ namespace SSC {
     Lock lock(this->mutex);
     auto entries = Vector<JSON::Any> {};
 
-    for (auto const &tuple : descriptors) {
-      auto desc = tuple.second;
-
-      if (!desc || (desc->isStale() && !desc->isRetained())) {
-        continue;
+    descriptors.forEach([this, &entries](auto desc) {
+      if (descriptors.isStale(desc) && !descriptors.isRetained(desc)) {
+        return;
       }
 
       auto entry = JSON::Object::Entries {
@@ -1516,7 +2735,7 @@ namespace SSC {
       };
 
       entries.push_back(entry);
-    }
+    });
 
     auto json = JSON::Object::Entries {
       {"source", "fs.getOpenDescriptors"},
@@ -1530,15 +2749,26 @@ namespace SSC {
     const String seq,
     const String path,
     Module::Callback cb
+  ) {
+    this->lstat(seq, path, StatOptions {}, cb);
+  }
+
+  void Core::FS::lstat (
+    const String seq,
+    const String path,
+    StatOptions options,
+    Module::Callback cb
   ) {
     this->core->dispatchEventLoop([=, this]() {
       auto filename = path.c_str();
       auto loop = &this->core->eventLoop;
       auto ctx = new RequestContext(seq, cb);
       auto req = &ctx->req;
+      ctx->binary = options.binary;
       auto err = uv_fs_lstat(loop, req, filename, [](uv_fs_t* req) {
         auto ctx = (RequestContext *) req->data;
         auto json = JSON::Object {};
+        auto post = Post {};
 
         if (uv_fs_get_result(req) < 0) {
           json = JSON::Object::Entries {
@@ -1548,11 +2778,15 @@ namespace SSC {
               {"message", String(uv_strerror((int) req->result))}
             }}
           };
+        } else if (ctx->binary) {
+          auto body = new char[STATS_RECORD_SIZE]{0};
+          writeStatsRecord(body, 0, uv_fs_get_statbuf(req));
+          post = getStatsPost(body, STATS_RECORD_SIZE);
         } else {
           json = getStatsJSON("fs.lstat", uv_fs_get_statbuf(req));
         }
 
-        ctx->cb(ctx->seq, json, Post{});
+        ctx->cb(ctx->seq, json, post);
         delete ctx;
       });
 
@@ -2078,7 +3312,7 @@ namespace SSC {
       .ttl = 0,
       .body = nullptr,
       .length = 0,
-      .headers = headers.str()
+      .headers = headers
     };
 
     cb(seq, json, post);
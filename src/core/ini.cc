@@ -6,15 +6,16 @@ namespace SSC::INI {
   }
 
   Map parse (const String& source, const String& keyPathSeparator) {
-    Vector<String> entries = split(source, '\n');
+    auto lines = Tokenizer(source, '\n');
+    StringView line;
     String prefix = "";
     Map settings = {};
 
-    for (auto entry : entries) {
-      entry = trim(entry);
+    while (lines.next(line)) {
+      const auto entry = trimView(line);
 
       // handle a variety of comment styles
-      if (entry[0] == ';' || entry[0] == '#') {
+      if (entry.empty() || entry[0] == ';' || entry[0] == '#') {
         continue;
       }
 
@@ -25,7 +26,7 @@ namespace SSC::INI {
           prefix = entry.substr(1, entry.length() - 2);
         }
 
-        prefix = replace(prefix, "\\.", keyPathSeparator);
+        prefix = replaceAll(prefix, ".", keyPathSeparator);
         if (prefix.size() > 0) {
           prefix += keyPathSeparator;
         }
@@ -35,18 +36,21 @@ namespace SSC::INI {
 
       auto index = entry.find_first_of('=');
 
-      if (index >= 0 && index <= entry.size()) {
-        auto key = trim(prefix + entry.substr(0, index));
-        auto value = trim(entry.substr(index + 1));
+      if (index != StringView::npos) {
+        auto key = prefix;
+        key += entry.substr(0, index);
+        key = trim(std::move(key));
+
+        auto value = trimView(entry.substr(index + 1));
 
         // trim quotes from quoted strings
         size_t closing_quote_index = -1;
         bool quoted_value = false;
-        if (value[0] == '"') {
+        if (value.starts_with('"')) {
           closing_quote_index = value.find_first_of('"', 1);
-          if (closing_quote_index != std::string::npos) {
+          if (closing_quote_index != StringView::npos) {
             quoted_value = true;
-            value = trim(value.substr(1, closing_quote_index - 1));
+            value = trimView(value.substr(1, closing_quote_index - 1));
           }
         }
 
@@ -56,27 +60,28 @@ namespace SSC::INI {
           auto j = value.find_first_of('#');
 
           if (i > 0) {
-            value = trim(value.substr(0, i));
+            value = trimView(value.substr(0, i));
           }
           else if (j > 0) {
-            value = trim(value.substr(0, j));
+            value = trimView(value.substr(0, j));
           }
         }
 
         if (key.ends_with("[]")) {
           key = trim(key.substr(0, key.size() - 2));
+          auto& setting = settings[key];
+
+          if (setting.size() > 0) {
+            setting += " ";
+          }
+
+          setting += value;
 
           // handle special configurations
           if (key == "webview_headers") {
             // inject '\n' as headers should be stored with
             // new lines for each entry in the configuration
-            value += "\n";
-          }
-
-          if (settings[key].size() > 0) {
-            settings[key] += " " + value;
-          } else {
-            settings[key] = value;
+            setting += "\n";
           }
         } else {
           settings[key] = value;
@@ -38,7 +38,7 @@ namespace SSC {
     const String& target,
     const JSON::Object& options
   ) {
-    SSC::String jsonValue = JSON::Any(SSC::replace(value, "\\\\", "\\\\")).str();
+    SSC::String jsonValue = JSON::Any(value).str();
 
     return createJavaScript("emit-to-render-process.js",
       "const name = decodeURIComponent(`" + event + "`);                     \n"
@@ -1,75 +1,72 @@
-#include <regex>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
 
 #include "json.hh"
-#include "string.hh"
+
+// floating point `std::from_chars()` and `std::to_chars()`, which libstdc++
+// and MSVC have without always defining `__cpp_lib_to_chars`
+#if (                                                                          \
+  defined(__cpp_lib_to_chars) ||                                               \
+  (defined(_GLIBCXX_RELEASE) && _GLIBCXX_RELEASE >= 11) ||                     \
+  (defined(_MSC_VER) && _MSC_VER >= 1924)                                      \
+)
+#define JSON_USE_FROM_CHARS 1
+#define JSON_USE_TO_CHARS 1
+// libc++ only has floating point `std::to_chars()`, since version 14, and
+// Apple platforms mark it unavailable before macOS 13.3 and iOS 16.3
+#elif defined(_LIBCPP_VERSION) && _LIBCPP_VERSION >= 14000 && !defined(__APPLE__)
+#define JSON_USE_TO_CHARS 1
+#endif
 
 namespace SSC::JSON {
   Null null;
   Any anyNull = nullptr;
 
-  Number::Number (const String& string) {
-    this->data = std::stod(string.str());
-  }
+  // the escape sequence character of each byte in a string, `0` for bytes
+  // written as they are and `u` for control characters written as `\u00XX`
+  static constexpr auto escapes = []() {
+    std::array<char, 256> table = {0};
 
-  std::string Number::str () const {
-    if (this->data == 0) {
-      return "0";
+    for (int i = 0; i < 0x20; ++i) {
+      table[i] = 'u';
     }
 
-    auto value = this->data;
-    auto output = std::to_string(value);
-    auto decimal = output.find(".");
+    table['"'] = '"';
+    table['\\'] = '\\';
+    table['\b'] = 'b';
+    table['\f'] = 'f';
+    table['\n'] = 'n';
+    table['\r'] = 'r';
+    table['\t'] = 't';
 
-    // trim trailing zeros
-    if (decimal >= 0) {
-      auto i = output.size() - 1;
-      while (output[i] == '0' && i >= decimal) {
-        i--;
-      }
+    return table;
+  }();
 
-      return output.substr(0, i);
-    }
+  Number::Number (const String& string) {
+    this->data = std::stod(string.data);
+  }
 
-    return output;
+  std::string Number::str () const {
+    Writer writer;
+    writer.write(*this);
+    return std::move(writer.output);
   }
 
   std::string Object::str () const {
-    std::stringstream stream;
-    auto count = this->data.size();
-    stream << std::string("{");
-    for (const auto& tuple : this->data) {
-      auto key = replace(tuple.first, "\"","\\\"");
-      auto value = tuple.second.str();
-
-      stream << std::string("\"");
-      stream << key;
-      stream << std::string("\":");
-      stream << value;
-
-      if (--count > 0) {
-        stream << std::string(",");
-      }
-    }
-
-    stream << std::string("}");
-    return stream.str();
+    Writer writer;
+    writer.write(*this);
+    return std::move(writer.output);
   }
 
   std::string Array::str () const {
-    std::stringstream stream;
-    auto count = this->data.size();
-    stream << std::string("[");
-
-    for (const auto& value : this->data) {
-      stream << value.str();
-
-      if (--count > 0) {
-        stream << std::string(",");
-      }
-    }
-
-    stream << std::string("]");
-    return stream.str();
+    Writer writer;
+    writer.write(*this);
+    return std::move(writer.output);
   }
 
   String::String (const Number& number) {
@@ -77,136 +74,1045 @@ namespace SSC::JSON {
   }
 
   SSC::String String::str () const {
-    auto escaped = replace(this->data, "\"", "\\\"");
-    return "\"" + replace(escaped, "\n", "\\n") + "\"";
+    Writer writer(this->data.size() + 2);
+    writer.write(*this);
+    return std::move(writer.output);
+  }
+
+  String::String (const Any& any) {
+    this->data = any.str();
   }
 
   Any::Any (const Null null) {
-    this->pointer = std::shared_ptr<void>(new Null());
     this->type = Type::Null;
   }
 
   Any::Any (std::nullptr_t) {
-    this->pointer = std::shared_ptr<void>(new Null());
     this->type = Type::Null;
   }
 
-  Any::Any (const char *string) {
-    this->pointer = std::shared_ptr<void>(new String(string));
+  Any::Any (const char *string)
+    : storage(std::in_place_type<String>, string)
+  {
+    this->type = Type::String;
+  }
+
+  Any::Any (const char string)
+    : storage(std::in_place_type<String>, string)
+  {
     this->type = Type::String;
   }
 
-  Any::Any (const char string) {
-    this->pointer = std::shared_ptr<void>(new String(string));
+  Any::Any (const SSC::String& string)
+    : storage(std::in_place_type<String>, string)
+  {
     this->type = Type::String;
   }
 
-  Any::Any (const std::string string) {
-    this->pointer = std::shared_ptr<void>(new String(string));
+  Any::Any (SSC::String&& string)
+    : storage(std::in_place_type<String>, std::move(string))
+  {
     this->type = Type::String;
   }
 
-  Any::Any (const String string) {
-    this->pointer = std::shared_ptr<void>(new String(string));
+  Any::Any (const String& string)
+    : storage(std::in_place_type<String>, string)
+  {
     this->type = Type::String;
   }
 
-  Any::Any (bool boolean) {
-    this->pointer = std::shared_ptr<void>(new Boolean(boolean));
+  Any::Any (String&& string)
+    : storage(std::in_place_type<String>, std::move(string))
+  {
+    this->type = Type::String;
+  }
+
+  Any::Any (bool boolean)
+    : storage(std::in_place_type<Boolean>, boolean)
+  {
     this->type = Type::Boolean;
   }
 
-  Any::Any (const Boolean boolean) {
-    this->pointer = std::shared_ptr<void>(new Boolean(boolean));
+  Any::Any (const Boolean boolean)
+    : storage(std::in_place_type<Boolean>, boolean)
+  {
     this->type = Type::Boolean;
   }
 
-  Any::Any (int32_t number) {
-    this->pointer = std::shared_ptr<void>(new Number((double) number));
+  Any::Any (int32_t number)
+    : storage(std::in_place_type<Number>, (double) number)
+  {
     this->type = Type::Number;
   }
 
-  Any::Any (uint32_t number) {
-    this->pointer = std::shared_ptr<void>(new Number((double) number));
+  Any::Any (uint32_t number)
+    : storage(std::in_place_type<Number>, (double) number)
+  {
     this->type = Type::Number;
   }
 
-  Any::Any (int64_t number) {
-    this->pointer = std::shared_ptr<void>(new Number((double) number));
+  Any::Any (int64_t number)
+    : storage(std::in_place_type<Number>, (double) number)
+  {
     this->type = Type::Number;
   }
 
-  Any::Any (uint64_t number) {
-    this->pointer = std::shared_ptr<void>(new Number((double) number));
+  Any::Any (uint64_t number)
+    : storage(std::in_place_type<Number>, (double) number)
+  {
     this->type = Type::Number;
   }
 
-  Any::Any (double number) {
-    this->pointer = std::shared_ptr<void>(new Number((double) number));
+  Any::Any (double number)
+    : storage(std::in_place_type<Number>, number)
+  {
     this->type = Type::Number;
   }
 
 #if defined(__APPLE__) && !TARGET_OS_IPHONE && !TARGET_IPHONE_SIMULATOR
-  Any::Any (size_t number) {
-    this->pointer = std::shared_ptr<void>(new Number((double) number));
+  Any::Any (size_t number)
+    : storage(std::in_place_type<Number>, (double) number)
+  {
     this->type = Type::Number;
   }
 #endif
 
 #if defined(__APPLE__)
-  Any::Any (ssize_t number) {
-    this->pointer = std::shared_ptr<void>(new Number((double) number));
+  Any::Any (ssize_t number)
+    : storage(std::in_place_type<Number>, (double) number)
+  {
     this->type = Type::Number;
   }
 #endif
 
-  Any::Any (const Number number) {
-    this->pointer = std::shared_ptr<void>(new Number(number));
+  Any::Any (const Number number)
+    : storage(std::in_place_type<Number>, number)
+  {
     this->type = Type::Number;
   }
 
-  Any::Any (const Object object) {
-    this->pointer = std::shared_ptr<void>(new Object(object));
+  Any::Any (const Object& object)
+    : storage(std::make_shared<Object>(object))
+  {
     this->type = Type::Object;
   }
 
-  Any::Any (const Object::Entries entries) {
-    this->pointer = std::shared_ptr<void>(new Object(entries));
+  Any::Any (Object&& object)
+    : storage(std::make_shared<Object>(std::move(object)))
+  {
     this->type = Type::Object;
   }
 
-  Any::Any (const Array array) {
-    this->pointer = std::shared_ptr<void>(new Array(array));
+  Any::Any (const Object::Entries& entries)
+    : storage(std::make_shared<Object>(entries))
+  {
+    this->type = Type::Object;
+  }
+
+  Any::Any (Object::Entries&& entries)
+    : storage(std::make_shared<Object>(std::move(entries)))
+  {
+    this->type = Type::Object;
+  }
+
+  Any::Any (const Array& array)
+    : storage(std::make_shared<Array>(array))
+  {
     this->type = Type::Array;
   }
 
-  Any::Any (const Array::Entries entries) {
-    this->pointer = std::shared_ptr<void>(new Array(entries));
+  Any::Any (Array&& array)
+    : storage(std::make_shared<Array>(std::move(array)))
+  {
     this->type = Type::Array;
   }
 
-  Any::Any (const Raw source) {
-    this->pointer = std::shared_ptr<void>(new Raw(source));
+  Any::Any (const Array::Entries& entries)
+    : storage(std::make_shared<Array>(entries))
+  {
+    this->type = Type::Array;
+  }
+
+  Any::Any (Array::Entries&& entries)
+    : storage(std::make_shared<Array>(std::move(entries)))
+  {
+    this->type = Type::Array;
+  }
+
+  Any::Any (const Raw& source)
+    : storage(std::in_place_type<Raw>, source)
+  {
+    this->type = Type::Raw;
+  }
+
+  Any::Any (Raw&& source)
+    : storage(std::in_place_type<Raw>, std::move(source))
+  {
     this->type = Type::Raw;
   }
 
   std::string Any::str () const {
-    const auto ptr = this->pointer.get() == nullptr
-      ? reinterpret_cast<const void*>(this)
-      : this->pointer.get();
-
-    switch (this->type) {
-      case Type::Empty: return "";
-      case Type::Any: return "";
-      case Type::Raw: return reinterpret_cast<const Raw*>(ptr)->str();
-      case Type::Null: return "null";
-      case Type::Object: return reinterpret_cast<const Object*>(ptr)->str();
-      case Type::Array: return reinterpret_cast<const Array*>(ptr)->str();
-      case Type::Boolean: return reinterpret_cast<const Boolean*>(ptr)->str();
-      case Type::Number: return reinterpret_cast<const Number*>(ptr)->str();
-      case Type::String: return reinterpret_cast<const String*>(ptr)->str();
-    }
-
-    return "";
+    if (this->type == Type::Empty || this->type == Type::Any) {
+      return "";
+    }
+
+    Writer writer;
+    writer.write(*this);
+    return std::move(writer.output);
+  }
+
+  void* Any::pointer () const {
+    return std::visit([](auto& value) -> void* {
+      using T = std::decay_t<decltype(value)>;
+      if constexpr (
+        std::is_same_v<T, std::shared_ptr<Object>> ||
+        std::is_same_v<T, std::shared_ptr<Array>>
+      ) {
+        return value.get();
+      } else {
+        return &value;
+      }
+    }, this->storage);
+  }
+
+  ObjectEntries::ObjectEntries (std::initializer_list<value_type> entries) {
+    this->entries.reserve(entries.size());
+    // like a `std::map` initializer list, the first of duplicate keys wins
+    for (const auto& entry : entries) {
+      this->insert(entry);
+    }
+  }
+
+  ObjectEntries::iterator ObjectEntries::lower_bound (const std::string_view key) {
+    // most entries are added in key order, so check the end first
+    if (this->entries.empty() || this->entries.back().first < key) {
+      return this->entries.end();
+    }
+
+    return std::lower_bound(
+      this->entries.begin(),
+      this->entries.end(),
+      key,
+      [](const value_type& entry, const std::string_view key) {
+        return entry.first < key;
+      }
+    );
+  }
+
+  ObjectEntries::const_iterator ObjectEntries::lower_bound (const std::string_view key) const {
+    return const_cast<ObjectEntries*>(this)->lower_bound(key);
+  }
+
+  ObjectEntries::iterator ObjectEntries::find (const std::string_view key) {
+    auto entry = this->lower_bound(key);
+    if (entry != this->entries.end() && entry->first == key) {
+      return entry;
+    }
+
+    return this->entries.end();
+  }
+
+  ObjectEntries::const_iterator ObjectEntries::find (const std::string_view key) const {
+    return const_cast<ObjectEntries*>(this)->find(key);
+  }
+
+  Any& ObjectEntries::at (const std::string_view key) {
+    auto entry = this->find(key);
+    if (entry == this->entries.end()) {
+      throw std::out_of_range("ObjectEntries::at");
+    }
+
+    return entry->second;
+  }
+
+  const Any& ObjectEntries::at (const std::string_view key) const {
+    return const_cast<ObjectEntries*>(this)->at(key);
+  }
+
+  Any& ObjectEntries::operator [] (const std::string_view key) {
+    auto entry = this->lower_bound(key);
+    if (entry == this->entries.end() || entry->first != key) {
+      entry = this->entries.emplace(entry, SSC::String(key), Any());
+    }
+
+    return entry->second;
+  }
+
+  std::pair<ObjectEntries::iterator, bool> ObjectEntries::insert_or_assign (
+    const std::string_view key,
+    const Any& value
+  ) {
+    auto entry = this->lower_bound(key);
+    if (entry != this->entries.end() && entry->first == key) {
+      entry->second = value;
+      return std::make_pair(entry, false);
+    }
+
+    return std::make_pair(this->entries.emplace(entry, SSC::String(key), value), true);
+  }
+
+  std::pair<ObjectEntries::iterator, bool> ObjectEntries::insert_or_assign (
+    SSC::String&& key,
+    Any&& value
+  ) {
+    auto entry = this->lower_bound(key);
+    if (entry != this->entries.end() && entry->first == key) {
+      entry->second = std::move(value);
+      return std::make_pair(entry, false);
+    }
+
+    return std::make_pair(
+      this->entries.emplace(entry, std::move(key), std::move(value)),
+      true
+    );
+  }
+
+  size_t ObjectEntries::erase (const std::string_view key) {
+    auto entry = this->find(key);
+    if (entry == this->entries.end()) {
+      return 0;
+    }
+
+    this->entries.erase(entry);
+    return 1;
+  }
+
+  void Writer::write (const Any& value) {
+    switch (value.type) {
+      case Type::Empty: return;
+      case Type::Any: return;
+      case Type::Raw: return this->write(value.as<Raw>());
+      case Type::Null: return this->write(null);
+      case Type::Object: return this->write(value.as<Object>());
+      case Type::Array: return this->write(value.as<Array>());
+      case Type::Boolean: return this->write(value.as<Boolean>());
+      case Type::Number: return this->write(value.as<Number>());
+      case Type::String: return this->write(value.as<String>());
+    }
+  }
+
+  void Writer::write (const Null& value) {
+    this->output.append("null", 4);
+  }
+
+  void Writer::write (const Raw& value) {
+    this->output.append(value.data);
+  }
+
+  void Writer::write (const Object& value) {
+    auto first = true;
+    this->output.push_back('{');
+
+    for (const auto& tuple : value.data) {
+      if (!first) {
+        this->output.push_back(',');
+      }
+
+      first = false;
+      this->writeString(tuple.first.data(), tuple.first.size());
+      this->output.push_back(':');
+      this->write(tuple.second);
+    }
+
+    this->output.push_back('}');
+  }
+
+  void Writer::write (const Array& value) {
+    auto first = true;
+    this->output.push_back('[');
+
+    for (const auto& entry : value.data) {
+      if (!first) {
+        this->output.push_back(',');
+      }
+
+      first = false;
+      this->write(entry);
+    }
+
+    this->output.push_back(']');
+  }
+
+  void Writer::write (const Boolean& value) {
+    if (value.data) {
+      this->output.append("true", 4);
+    } else {
+      this->output.append("false", 5);
+    }
+  }
+
+  void Writer::write (const Number& value) {
+    this->writeNumber(value.data);
+  }
+
+  void Writer::write (const String& value) {
+    this->writeString(value.data.data(), value.data.size());
+  }
+
+  // `strtod()` and `snprintf()` use the decimal point of the current locale,
+  // which is not '.' in "de_DE" and others
+  static char getLocaleDecimalPoint () {
+    auto point = localeconv()->decimal_point;
+    return point != nullptr && point[0] != '\0' ? point[0] : '.';
+  }
+
+  // parses a JSON number in `source`, which may be modified, with `strtod()`
+  static double parseDouble (SSC::String& source) {
+    auto point = getLocaleDecimalPoint();
+
+    if (point != '.') {
+      std::replace(source.begin(), source.end(), '.', point);
+    }
+
+    return strtod(source.c_str(), nullptr);
+  }
+
+#if !defined(JSON_USE_TO_CHARS)
+  // writes the shortest of `%.15g`, `%.16g` and `%.17g` that reads back as
+  // `value`, `%.17g` always does
+  static char* formatDouble (char* buffer, size_t size, double value) {
+    auto point = getLocaleDecimalPoint();
+    SSC::String scratch;
+    int length = 0;
+
+    for (int precision = 15; precision <= 17; ++precision) {
+      length = snprintf(buffer, size, "%.*g", precision, value);
+      std::replace(buffer, buffer + length, point, '.');
+      scratch.assign(buffer, length);
+
+      if (parseDouble(scratch) == value) {
+        break;
+      }
+    }
+
+    return buffer + length;
+  }
+#endif
+
+  void Writer::writeNumber (double value) {
+    char buffer[32];
+    char* end = buffer;
+
+    // like `JSON.stringify()`, there is no representation for these
+    if (!std::isfinite(value)) {
+      this->output.append("null", 4);
+      return;
+    }
+
+    // integers that a double holds exactly are written without a fraction
+    if (value == std::trunc(value) && std::fabs(value) < 9007199254740992.0) {
+      end = std::to_chars(buffer, buffer + sizeof(buffer), (int64_t) value).ptr;
+    } else {
+    #if defined(JSON_USE_TO_CHARS)
+      end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+    #else
+      // floating point `std::to_chars()` is missing from some standard libraries
+      end = formatDouble(buffer, sizeof(buffer), value);
+    #endif
+    }
+
+    this->output.append(buffer, end - buffer);
+  }
+
+  void Writer::writeString (const char* data, size_t size) {
+    static constexpr char hex[] = "0123456789abcdef";
+    auto bytes = reinterpret_cast<const unsigned char*>(data);
+    size_t start = 0;
+
+    this->output.push_back('"');
+
+    for (size_t i = 0; i < size; ++i) {
+      auto escape = escapes[bytes[i]];
+
+      if (escape == 0) {
+        continue;
+      }
+
+      // bytes before the escaped one are copied as one run
+      this->output.append(data + start, i - start);
+      start = i + 1;
+
+      if (escape == 'u') {
+        const char sequence[6] = {
+          '\\', 'u', '0', '0', hex[bytes[i] >> 4], hex[bytes[i] & 0x0F]
+        };
+
+        this->output.append(sequence, sizeof(sequence));
+      } else {
+        const char sequence[2] = { '\\', escape };
+        this->output.append(sequence, sizeof(sequence));
+      }
+    }
+
+    this->output.append(data + start, size - start);
+    this->output.push_back('"');
+  }
+}
+
+namespace SSC::JSON {
+  // whether any of the eight bytes in `word` is a quote, a backslash or a
+  // control character, which end a run of plain characters in a string
+  static inline bool hasStringDelimiter (uint64_t word) {
+    constexpr uint64_t ones = 0x0101010101010101ULL;
+    constexpr uint64_t highs = 0x8080808080808080ULL;
+    const auto quotes = word ^ (ones * '"');
+    const auto backslashes = word ^ (ones * '\\');
+
+    return (
+      ((quotes - ones) & ~quotes) |
+      ((backslashes - ones) & ~backslashes) |
+      ((word - ones * 0x20) & ~word)
+    ) & highs;
+  }
+
+  static void appendUTF8 (SSC::String& output, uint32_t codepoint) {
+    if (codepoint < 0x80) {
+      output.push_back((char) codepoint);
+    } else if (codepoint < 0x800) {
+      output.push_back((char) (0xC0 | (codepoint >> 6)));
+      output.push_back((char) (0x80 | (codepoint & 0x3F)));
+    } else if (codepoint < 0x10000) {
+      output.push_back((char) (0xE0 | (codepoint >> 12)));
+      output.push_back((char) (0x80 | ((codepoint >> 6) & 0x3F)));
+      output.push_back((char) (0x80 | (codepoint & 0x3F)));
+    } else {
+      output.push_back((char) (0xF0 | (codepoint >> 18)));
+      output.push_back((char) (0x80 | ((codepoint >> 12) & 0x3F)));
+      output.push_back((char) (0x80 | ((codepoint >> 6) & 0x3F)));
+      output.push_back((char) (0x80 | (codepoint & 0x3F)));
+    }
+  }
+
+  // builds a value from the events of a document
+  class Builder : public Visitor {
+    public:
+      Any root = nullptr;
+      Vector<Any> containers;
+      Vector<SSC::String> keys;
+
+      void add (Any value) {
+        if (this->containers.size() == 0) {
+          this->root = std::move(value);
+        } else if (this->containers.back().type == Type::Object) {
+          auto& object = this->containers.back().as<Object>();
+          object.data.insert_or_assign(std::move(this->keys.back()), std::move(value));
+        } else {
+          this->containers.back().as<Array>().data.push_back(std::move(value));
+        }
+      }
+
+      bool onNull () override {
+        this->add(nullptr);
+        return true;
+      }
+
+      bool onBoolean (bool value) override {
+        this->add(value);
+        return true;
+      }
+
+      bool onNumber (double value) override {
+        this->add(value);
+        return true;
+      }
+
+      bool onString (std::string_view value) override {
+        this->add(SSC::String(value));
+        return true;
+      }
+
+      bool onKey (std::string_view key) override {
+        this->keys.back().assign(key.data(), key.size());
+        return true;
+      }
+
+      bool onObjectStart () override {
+        this->containers.push_back(Object());
+        this->keys.push_back("");
+        return true;
+      }
+
+      bool onObjectEnd () override {
+        auto object = std::move(this->containers.back());
+        this->containers.pop_back();
+        this->keys.pop_back();
+        this->add(std::move(object));
+        return true;
+      }
+
+      bool onArrayStart () override {
+        this->containers.push_back(Array());
+        this->keys.push_back("");
+        return true;
+      }
+
+      bool onArrayEnd () override {
+        return this->onObjectEnd();
+      }
+  };
+
+  // a recursive descent parser that reports values to a `Visitor`
+  class Reader {
+    public:
+      const char* begin = nullptr;
+      const char* cursor = nullptr;
+      const char* end = nullptr;
+      Visitor* visitor = nullptr;
+      // strings with escapes are decoded here
+      SSC::String scratch;
+      int depth = 0;
+
+      Reader (const char* source, size_t size, Visitor* visitor) {
+        this->begin = source;
+        this->cursor = source;
+        this->end = source + size;
+        this->visitor = visitor;
+      }
+
+      [[noreturn]] void fail (const SSC::String& message) {
+        throw Error(
+          "SyntaxError",
+          message + " at position " + std::to_string(this->cursor - this->begin),
+          "SSC::JSON::parse"
+        );
+      }
+
+      void skipWhitespace () {
+        while (this->cursor < this->end) {
+          const auto c = *this->cursor;
+          if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+            break;
+          }
+
+          this->cursor++;
+        }
+      }
+
+      void expect (char c) {
+        if (this->cursor >= this->end) {
+          this->fail("Unexpected end of input");
+        }
+
+        if (*this->cursor != c) {
+          this->fail(SSC::String("Expected '") + c + "'");
+        }
+
+        this->cursor++;
+      }
+
+      bool document () {
+        this->skipWhitespace();
+
+        if (!this->value()) {
+          return false;
+        }
+
+        this->skipWhitespace();
+
+        if (this->cursor != this->end) {
+          this->fail("Unexpected token after value");
+        }
+
+        return true;
+      }
+
+      bool value () {
+        if (this->cursor >= this->end) {
+          this->fail("Unexpected end of input");
+        }
+
+        switch (*this->cursor) {
+          case '{': return this->object();
+          case '[': return this->array();
+          case '"': return this->visitor->onString(this->string());
+          case 't': return this->literal("true", 4) && this->visitor->onBoolean(true);
+          case 'f': return this->literal("false", 5) && this->visitor->onBoolean(false);
+          case 'n': return this->literal("null", 4) && this->visitor->onNull();
+          default: return this->visitor->onNumber(this->number());
+        }
+      }
+
+      bool literal (const char* word, size_t length) {
+        if ((size_t) (this->end - this->cursor) < length || memcmp(this->cursor, word, length) != 0) {
+          this->fail("Unexpected token");
+        }
+
+        this->cursor += length;
+        return true;
+      }
+
+      bool object () {
+        if (++this->depth > MAX_PARSE_DEPTH) {
+          this->fail("Maximum nesting depth exceeded");
+        }
+
+        this->cursor++;
+
+        if (!this->visitor->onObjectStart()) {
+          return false;
+        }
+
+        this->skipWhitespace();
+
+        if (this->cursor < this->end && *this->cursor == '}') {
+          this->cursor++;
+          this->depth--;
+          return this->visitor->onObjectEnd();
+        }
+
+        while (true) {
+          this->skipWhitespace();
+
+          if (this->cursor >= this->end || *this->cursor != '"') {
+            this->fail("Expected property name");
+          }
+
+          if (!this->visitor->onKey(this->string())) {
+            return false;
+          }
+
+          this->skipWhitespace();
+          this->expect(':');
+          this->skipWhitespace();
+
+          if (!this->value()) {
+            return false;
+          }
+
+          this->skipWhitespace();
+
+          if (this->cursor < this->end && *this->cursor == ',') {
+            this->cursor++;
+            continue;
+          }
+
+          this->expect('}');
+          break;
+        }
+
+        this->depth--;
+        return this->visitor->onObjectEnd();
+      }
+
+      bool array () {
+        if (++this->depth > MAX_PARSE_DEPTH) {
+          this->fail("Maximum nesting depth exceeded");
+        }
+
+        this->cursor++;
+
+        if (!this->visitor->onArrayStart()) {
+          return false;
+        }
+
+        this->skipWhitespace();
+
+        if (this->cursor < this->end && *this->cursor == ']') {
+          this->cursor++;
+          this->depth--;
+          return this->visitor->onArrayEnd();
+        }
+
+        while (true) {
+          this->skipWhitespace();
+
+          if (!this->value()) {
+            return false;
+          }
+
+          this->skipWhitespace();
+
+          if (this->cursor < this->end && *this->cursor == ',') {
+            this->cursor++;
+            continue;
+          }
+
+          this->expect(']');
+          break;
+        }
+
+        this->depth--;
+        return this->visitor->onArrayEnd();
+      }
+
+      // strings without escapes are views of the source
+      std::string_view string () {
+        const auto start = ++this->cursor;
+
+        while (true) {
+          while (this->end - this->cursor >= 8) {
+            uint64_t word;
+            memcpy(&word, this->cursor, sizeof(word));
+
+            if (hasStringDelimiter(word)) {
+              break;
+            }
+
+            this->cursor += 8;
+          }
+
+          if (this->cursor >= this->end) {
+            this->fail("Unterminated string");
+          }
+
+          const auto c = (unsigned char) *this->cursor;
+
+          if (c == '"') {
+            return std::string_view(start, this->cursor++ - start);
+          }
+
+          if (c == '\\') {
+            this->scratch.assign(start, this->cursor - start);
+            return this->escapedString();
+          }
+
+          if (c < 0x20) {
+            this->fail("Bad control character in string");
+          }
+
+          this->cursor++;
+        }
+      }
+
+      std::string_view escapedString () {
+        while (this->cursor < this->end) {
+          const auto c = (unsigned char) *this->cursor;
+
+          if (c == '"') {
+            this->cursor++;
+            return std::string_view(this->scratch);
+          }
+
+          if (c < 0x20) {
+            this->fail("Bad control character in string");
+          }
+
+          if (c != '\\') {
+            this->scratch.push_back((char) c);
+            this->cursor++;
+            continue;
+          }
+
+          if (++this->cursor >= this->end) {
+            break;
+          }
+
+          switch (*this->cursor++) {
+            case '"': this->scratch.push_back('"'); break;
+            case '\\': this->scratch.push_back('\\'); break;
+            case '/': this->scratch.push_back('/'); break;
+            case 'b': this->scratch.push_back('\b'); break;
+            case 'f': this->scratch.push_back('\f'); break;
+            case 'n': this->scratch.push_back('\n'); break;
+            case 'r': this->scratch.push_back('\r'); break;
+            case 't': this->scratch.push_back('\t'); break;
+            case 'u': {
+              auto codepoint = this->hex();
+
+              // a high surrogate followed by a low surrogate is one codepoint
+              if (
+                codepoint >= 0xD800 && codepoint <= 0xDBFF &&
+                this->end - this->cursor >= 6 &&
+                this->cursor[0] == '\\' && this->cursor[1] == 'u'
+              ) {
+                const auto next = this->cursor;
+                this->cursor += 2;
+                const auto low = this->hex();
+
+                if (low >= 0xDC00 && low <= 0xDFFF) {
+                  codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                } else {
+                  this->cursor = next;
+                }
+              }
+
+              appendUTF8(this->scratch, codepoint);
+              break;
+            }
+
+            default:
+              this->cursor--;
+              this->fail("Bad escaped character in string");
+          }
+        }
+
+        this->fail("Unterminated string");
+      }
+
+      uint32_t hex () {
+        uint32_t value = 0;
+
+        if (this->end - this->cursor < 4) {
+          this->fail("Bad Unicode escape in string");
+        }
+
+        for (int i = 0; i < 4; ++i) {
+          const auto c = *this->cursor++;
+          value <<= 4;
+
+          if (c >= '0' && c <= '9') {
+            value |= c - '0';
+          } else if (c >= 'a' && c <= 'f') {
+            value |= c - 'a' + 10;
+          } else if (c >= 'A' && c <= 'F') {
+            value |= c - 'A' + 10;
+          } else {
+            this->fail("Bad Unicode escape in string");
+          }
+        }
+
+        return value;
+      }
+
+      double number () {
+        const auto start = this->cursor;
+        auto negative = false;
+        auto integral = true;
+        uint64_t integer = 0;
+        int digits = 0;
+
+        auto isDigit = [this]() {
+          return this->cursor < this->end && *this->cursor >= '0' && *this->cursor <= '9';
+        };
+
+        if (*this->cursor == '-') {
+          negative = true;
+          this->cursor++;
+        }
+
+        if (!isDigit()) {
+          this->fail("Unexpected token");
+        }
+
+        if (*this->cursor == '0') {
+          this->cursor++;
+        } else {
+          while (isDigit()) {
+            integer = integer * 10 + (*this->cursor++ - '0');
+            digits++;
+          }
+        }
+
+        if (this->cursor < this->end && *this->cursor == '.') {
+          integral = false;
+          this->cursor++;
+
+          if (!isDigit()) {
+            this->fail("Unterminated fractional number");
+          }
+
+          while (isDigit()) {
+            this->cursor++;
+          }
+        }
+
+        if (this->cursor < this->end && (*this->cursor == 'e' || *this->cursor == 'E')) {
+          integral = false;
+          this->cursor++;
+
+          if (this->cursor < this->end && (*this->cursor == '+' || *this->cursor == '-')) {
+            this->cursor++;
+          }
+
+          if (!isDigit()) {
+            this->fail("Exponent part is missing a number");
+          }
+
+          while (isDigit()) {
+            this->cursor++;
+          }
+        }
+
+        // integers of up to 15 digits are exact without conversion
+        if (integral && digits <= 15) {
+          return negative ? -(double) integer : (double) integer;
+        }
+
+        double value = 0;
+      #if defined(JSON_USE_FROM_CHARS)
+        const auto result = std::from_chars(start, this->cursor, value);
+        // `value` is left untouched when out of range, defer to `strtod()`
+        // so `1e400` is infinity and `1e-400` is zero, like `JSON.parse()`
+        if (result.ec == std::errc::result_out_of_range) {
+          this->scratch.assign(start, this->cursor - start);
+          value = parseDouble(this->scratch);
+        }
+      #else
+        // floating point `std::from_chars()` is missing from some standard libraries
+        this->scratch.assign(start, this->cursor - start);
+        value = parseDouble(this->scratch);
+      #endif
+        return value;
+      }
+  };
+
+  Any parse (const char* source, size_t size) {
+    Builder builder;
+    Reader reader(source, size, &builder);
+    reader.document();
+    return builder.root;
+  }
+
+  Any parse (const SSC::String& source) {
+    return parse(source.data(), source.size());
+  }
+
+  bool parse (const char* source, size_t size, Visitor& visitor) {
+    Reader reader(source, size, &visitor);
+    return reader.document();
+  }
+
+  bool parse (const SSC::String& source, Visitor& visitor) {
+    return parse(source.data(), source.size(), visitor);
+  }
+
+  Any pick (const char* source, size_t size, const SSC::String& key) {
+    Visitor skip;
+    Reader reader(source, size, &skip);
+
+    reader.skipWhitespace();
+    reader.expect('{');
+    reader.skipWhitespace();
+
+    if (reader.cursor < reader.end && *reader.cursor == '}') {
+      return nullptr;
+    }
+
+    while (true) {
+      reader.skipWhitespace();
+
+      if (reader.cursor >= reader.end || *reader.cursor != '"') {
+        reader.fail("Expected property name");
+      }
+
+      const auto match = reader.string() == key;
+
+      reader.skipWhitespace();
+      reader.expect(':');
+      reader.skipWhitespace();
+
+      // the rest of the document is not read once the value is found
+      if (match) {
+        Builder builder;
+        reader.visitor = &builder;
+        reader.value();
+        return builder.root;
+      }
+
+      reader.value();
+      reader.skipWhitespace();
+
+      if (reader.cursor < reader.end && *reader.cursor == ',') {
+        reader.cursor++;
+        continue;
+      }
+
+      reader.expect('}');
+      return nullptr;
+    }
+  }
+
+  Any pick (const SSC::String& source, const SSC::String& key) {
+    return pick(source.data(), source.size(), key);
   }
 }
@@ -1,6 +1,9 @@
 #ifndef SSC_SOCKET_JSON_HH
 #define SSC_SOCKET_JSON_HH
 
+#include <string_view>
+#include <variant>
+
 #include "types.hh"
 
 namespace SSC::JSON {
@@ -13,8 +16,8 @@ namespace SSC::JSON {
   class Boolean;
   class Number;
   class String;
+  class ObjectEntries;
 
-  using ObjectEntries = std::map<SSC::String, Any>;
   using ArrayEntries = std::vector<Any>;
 
   class Error : public std::invalid_argument {
@@ -94,30 +97,170 @@ namespace SSC::JSON {
 
   extern Null null;
 
-  class Any : public Value<void *, Type::Any> {
+  class Raw : public Value<SSC::String, Type::Raw> {
     public:
-      std::shared_ptr<void> pointer = nullptr;
+      Raw (const Raw& raw) = default;
+      Raw (Raw&& raw) = default;
+      Raw (const Raw* raw) { this->data = raw->data; }
+      Raw (const SSC::String& source) { this->data = source; }
+      Raw& operator = (const Raw&) = default;
+      Raw& operator = (Raw&&) = default;
 
-      Any () {
-        this->pointer = nullptr;
-        this->type = Type::Null;
+      const SSC::String str () const {
+        return this->data;
+      }
+  };
+
+  class Boolean : public Value<bool, Type::Boolean> {
+    public:
+      Boolean () = default;
+      Boolean (const Boolean& boolean) {
+        this->data = boolean.value();
+      }
+
+      Boolean (bool boolean) {
+        this->data = boolean;
+      }
+
+      Boolean (int data) {
+        this->data = data != 0;
+      }
+
+      Boolean (int64_t data) {
+        this->data = data != 0;
+      }
+
+      Boolean (double data) {
+        this->data = data != 0;
+      }
+
+      Boolean (void *data) {
+        this->data = data != nullptr;
+      }
+
+      Boolean (SSC::String string) {
+        this->data = string.size() > 0;
+      }
+
+      Boolean& operator = (const Boolean&) = default;
+
+      bool value () const {
+        return this->data;
+      }
+
+      SSC::String str () const {
+        return this->data ? "true" : "false";
+      }
+  };
+
+  class Number : public Value<double, Type::Number> {
+    public:
+      Number () = default;
+      Number (const Number& number) = default;
+
+      Number (double number) {
+        this->data = number;
+      }
+
+      Number (char number) {
+        this->data = (double) number;
+      }
+
+      Number (int number) {
+        this->data = (double) number;
+      }
+
+      Number (int64_t number) {
+        this->data = (double) number;
+      }
+
+      Number (bool number) {
+        this->data = (double) number;
+      }
+
+      Number (const String& string);
+
+      Number& operator = (const Number&) = default;
+
+      float value () const {
+        return this->data;
+      }
+
+      SSC::String str () const;
+  };
+
+  class String : public Value<SSC::String, Type::String> {
+    public:
+      String () = default;
+      String (const String& data) = default;
+      String (String&& data) = default;
+
+      String (const SSC::String& data) {
+        this->data = data;
+      }
+
+      String (SSC::String&& data) {
+        this->data = std::move(data);
+      }
+
+      String (const char data) {
+        this->data = SSC::String(1, data);
+      }
+
+      String (const char *data) {
+        this->data = SSC::String(data);
+      }
+
+      String (const Any& any);
+      String (const Number& number);
+
+      String (const Boolean& boolean) {
+        this->data = boolean.str();
       }
 
-      ~Any () {
-        this->pointer = nullptr;
-        this->type = Type::Any;
+      String& operator = (const String&) = default;
+      String& operator = (String&&) = default;
+
+      SSC::String str () const;
+
+      SSC::String value () const {
+        return this->data;
       }
 
-      Any (const Any &any) {
-        this->pointer = any.pointer;
-        this->type = any.type;
+      auto size () const {
+        return this->data.size();
       }
+  };
 
-      Any (Type type, std::shared_ptr<void> pointer) {
-        this->type = type;
-        this->pointer = pointer;
+  /**
+   * A value of any type. Null, booleans, numbers and strings are stored in
+   * the value itself, so they are not allocated on their own (short strings
+   * fit in `SSC::String` without allocating at all). Objects and arrays are
+   * allocated once and shared by copies of the value, like they were before.
+   */
+  class Any : public Value<void *, Type::Any> {
+    public:
+      using Storage = std::variant<
+        Null,
+        Boolean,
+        Number,
+        String,
+        Raw,
+        std::shared_ptr<Object>,
+        std::shared_ptr<Array>
+      >;
+
+      mutable Storage storage;
+
+      Any () {
+        this->type = Type::Null;
       }
 
+      Any (const Any&) = default;
+      Any (Any&&) noexcept = default;
+      Any& operator = (const Any&) = default;
+      Any& operator = (Any&&) noexcept = default;
+
       Any (std::nullptr_t);
       Any (const Null);
       Any (bool);
@@ -136,35 +279,44 @@ namespace SSC::JSON {
       Any (const Number);
       Any (const char);
       Any (const char *);
-      Any (const SSC::String);
-      Any (const String);
-      Any (const Object);
-      Any (const ObjectEntries);
-      Any (const Array);
-      Any (const ArrayEntries);
-      Any (const Raw source);
+      Any (const SSC::String&);
+      Any (SSC::String&&);
+      Any (const String&);
+      Any (String&&);
+      Any (const Object&);
+      Any (Object&&);
+      Any (const ObjectEntries&);
+      Any (ObjectEntries&&);
+      Any (const Array&);
+      Any (Array&&);
+      Any (const ArrayEntries&);
+      Any (ArrayEntries&&);
+      Any (const Raw& source);
+      Any (Raw&& source);
 
       SSC::String str () const;
 
-      template <typename T> T& as () const {
-        auto ptr = this->pointer.get();
+      // the address of the stored value, which starts with its `type`
+      void* pointer () const;
 
-        if (ptr != nullptr && this->type != Type::Null) {
-          return *reinterpret_cast<T *>(ptr);
+      template <typename T> T& as () const {
+        if constexpr (std::is_same_v<T, Object> || std::is_same_v<T, Array>) {
+          auto container = std::get_if<std::shared_ptr<T>>(&this->storage);
+          if (container != nullptr && *container != nullptr) {
+            return **container;
+          }
+        } else {
+          auto value = std::get_if<T>(&this->storage);
+          if (value != nullptr && (this->type != Type::Null || std::is_same_v<T, Null>)) {
+            return *value;
+          }
         }
 
-        throw Error("BadCastError", "cannot cast to null value", __PRETTY_FUNCTION__);
-      }
-  };
-
-  class Raw : public Value<SSC::String, Type::Raw> {
-    public:
-      Raw (const Raw& raw) { this->data = raw.data; }
-      Raw (const Raw* raw) { this->data = raw->data; }
-      Raw (const SSC::String& source) { this->data = source; }
+        if (this->type == Type::Null) {
+          throw Error("BadCastError", "cannot cast to null value", __PRETTY_FUNCTION__);
+        }
 
-      const SSC::String str () const {
-        return this->data;
+        throw Error("BadCastError", "cannot cast to a different type", __PRETTY_FUNCTION__);
       }
   };
 
@@ -174,62 +326,117 @@ namespace SSC::JSON {
     return any.typeof();
   }
 
+  /**
+   * The entries of an object in a vector sorted by key, which replaces a
+   * `std::map` node per entry with one allocation per object. Lookups are a
+   * binary search and entries added in key order, like `Writer` output and
+   * most literals, are appended without moving the others.
+   */
+  class ObjectEntries {
+    public:
+      using value_type = std::pair<SSC::String, Any>;
+      using Storage = std::vector<value_type>;
+      using iterator = Storage::iterator;
+      using const_iterator = Storage::const_iterator;
+
+      Storage entries;
+
+      ObjectEntries () = default;
+      ObjectEntries (std::initializer_list<value_type> entries);
+
+      iterator begin () { return this->entries.begin(); }
+      iterator end () { return this->entries.end(); }
+      const_iterator begin () const { return this->entries.begin(); }
+      const_iterator end () const { return this->entries.end(); }
+
+      size_t size () const { return this->entries.size(); }
+      bool empty () const { return this->entries.empty(); }
+      void clear () { this->entries.clear(); }
+      void reserve (size_t size) { this->entries.reserve(size); }
+
+      iterator lower_bound (const std::string_view key);
+      const_iterator lower_bound (const std::string_view key) const;
+      iterator find (const std::string_view key);
+      const_iterator find (const std::string_view key) const;
+
+      size_t count (const std::string_view key) const {
+        return this->find(key) != this->end() ? 1 : 0;
+      }
+
+      Any& at (const std::string_view key);
+      const Any& at (const std::string_view key) const;
+      Any& operator [] (const std::string_view key);
+
+      std::pair<iterator, bool> insert_or_assign (const std::string_view key, const Any& value);
+      std::pair<iterator, bool> insert_or_assign (SSC::String&& key, Any&& value);
+
+      // like `std::map::insert()`, an existing entry is kept
+      template <typename Entry> std::pair<iterator, bool> insert (const Entry& entry) {
+        auto position = this->lower_bound(entry.first);
+        if (position != this->end() && position->first == entry.first) {
+          return std::make_pair(position, false);
+        }
+
+        return std::make_pair(
+          this->entries.emplace(position, entry.first, Any(entry.second)),
+          true
+        );
+      }
+
+      size_t erase (const std::string_view key);
+      iterator erase (const_iterator position) {
+        return this->entries.erase(position);
+      }
+  };
+
   class Object : public Value<ObjectEntries, Type::Object> {
     public:
       using Entries = ObjectEntries;
       Object () = default;
       Object (std::map<SSC::String, int> entries) {
-        for (auto const &tuple : entries) {
-          auto key = tuple.first;
-          auto value = tuple.second;
-          this->data.insert_or_assign(key, value);
+        for (const auto& tuple : entries) {
+          this->data.insert_or_assign(tuple.first, tuple.second);
         }
       }
 
       Object (std::map<SSC::String, bool> entries) {
-        for (auto const &tuple : entries) {
-          auto key = tuple.first;
-          auto value = tuple.second;
-          this->data.insert_or_assign(key, value);
+        for (const auto& tuple : entries) {
+          this->data.insert_or_assign(tuple.first, tuple.second);
         }
       }
 
       Object (std::map<SSC::String, double> entries) {
-        for (auto const &tuple : entries) {
-          auto key = tuple.first;
-          auto value = tuple.second;
-          this->data.insert_or_assign(key, value);
+        for (const auto& tuple : entries) {
+          this->data.insert_or_assign(tuple.first, tuple.second);
         }
       }
 
       Object (std::map<SSC::String, int64_t> entries) {
-        for (auto const &tuple : entries) {
-          auto key = tuple.first;
-          auto value = tuple.second;
-          this->data.insert_or_assign(key, value);
+        for (const auto& tuple : entries) {
+          this->data.insert_or_assign(tuple.first, tuple.second);
         }
       }
 
-      Object (const Object::Entries entries) {
-        for (const auto& tuple : entries) {
-          auto key = tuple.first;
-          auto value = tuple.second;
-          this->data.insert_or_assign(key, value);
-        }
+      Object (const Object::Entries& entries) {
+        this->data = entries;
       }
 
-      Object (const Object& object) {
-        this->data = object.value();
+      Object (Object::Entries&& entries) {
+        this->data = std::move(entries);
       }
 
+      Object (const Object& object) = default;
+      Object (Object&& object) = default;
+
       Object (const std::map<SSC::String, SSC::String> map) {
         for (const auto& tuple : map) {
-          auto key = tuple.first;
-          auto value = Any(tuple.second);
-          this->data.insert_or_assign(key, value);
+          this->data.insert_or_assign(tuple.first, tuple.second);
         }
       }
 
+      Object& operator = (const Object&) = default;
+      Object& operator = (Object&&) = default;
+
       SSC::String str () const;
 
       const Object::Entries value () const {
@@ -237,15 +444,16 @@ namespace SSC::JSON {
       }
 
       Any& get (const SSC::String key) {
-        if (this->data.find(key) != this->data.end()) {
-          return this->data.at(key);
+        auto entry = this->data.find(key);
+        if (entry != this->data.end()) {
+          return entry->second;
         }
 
         return anyNull;
       }
 
       void set (const SSC::String key, Any value) {
-        this->data[key] = value;
+        this->data[key] = std::move(value);
       }
 
       bool has (const SSC::String& key) const {
@@ -253,8 +461,9 @@ namespace SSC::JSON {
       }
 
       Any operator [] (const SSC::String& key) const {
-        if (this->data.find(key) != this->data.end()) {
-          return this->data.at(key);
+        auto entry = this->data.find(key);
+        if (entry != this->data.end()) {
+          return entry->second;
         }
 
         return nullptr;
@@ -273,16 +482,20 @@ namespace SSC::JSON {
     public:
       using Entries = ArrayEntries;
       Array () = default;
-      Array (const Array& array) {
-        this->data = array.value();
+      Array (const Array& array) = default;
+      Array (Array&& array) = default;
+
+      Array (const Array::Entries& entries) {
+        this->data = entries;
       }
 
-      Array (const Array::Entries entries) {
-        for (const auto& value : entries) {
-          this->data.push_back(value);
-        }
+      Array (Array::Entries&& entries) {
+        this->data = std::move(entries);
       }
 
+      Array& operator = (const Array&) = default;
+      Array& operator = (Array&&) = default;
+
       SSC::String str () const;
 
       Array::Entries value () const {
@@ -290,7 +503,7 @@ namespace SSC::JSON {
       }
 
       bool has (const unsigned int index) const {
-        return this->data.size() < index;
+        return index < this->data.size();
       }
 
       auto size () const {
@@ -310,19 +523,19 @@ namespace SSC::JSON {
           this->data.resize(index + 1);
         }
 
-        this->data[index] = value;
+        this->data[index] = std::move(value);
       }
 
       void push (Any value) {
-        this->set(this->size(), value);
+        this->data.push_back(std::move(value));
       }
 
-      Any& pop () {
+      Any pop () {
         if (this->size() == 0) {
           return anyNull;
         }
 
-        auto& value = this->data.back();
+        auto value = std::move(this->data.back());
         this->data.pop_back();
         return value;
       }
@@ -344,121 +557,73 @@ namespace SSC::JSON {
       }
   };
 
-  class Boolean : public Value<bool, Type::Boolean> {
+  /**
+   * Serializes values into a single output buffer, which keeps its capacity
+   * after `reset()` so a writer can be reused without allocating again.
+   */
+  class Writer {
     public:
-      Boolean () = default;
-      Boolean (const Boolean& boolean) {
-        this->data = boolean.value();
-      }
-
-      Boolean (bool boolean) {
-        this->data = boolean;
-      }
-
-      Boolean (int data) {
-        this->data = data != 0;
-      }
+      SSC::String output;
 
-      Boolean (int64_t data) {
-        this->data = data != 0;
-      }
-
-      Boolean (double data) {
-        this->data = data != 0;
-      }
-
-      Boolean (void *data) {
-        this->data = data != nullptr;
+      Writer () = default;
+      Writer (size_t capacity) {
+        this->output.reserve(capacity);
       }
 
-      Boolean (SSC::String string) {
-        this->data = string.size() > 0;
+      void reset () {
+        this->output.clear();
       }
 
-      bool value () const {
-        return this->data;
+      const SSC::String& str () const {
+        return this->output;
       }
 
-      SSC::String str () const {
-        return this->data ? "true" : "false";
-      }
+      void write (const Any& value);
+      void write (const Null& value);
+      void write (const Raw& value);
+      void write (const Object& value);
+      void write (const Array& value);
+      void write (const Boolean& value);
+      void write (const Number& value);
+      void write (const String& value);
+      void writeNumber (double value);
+      void writeString (const char* data, size_t size);
   };
 
-  class Number : public Value<double, Type::Number> {
+  /**
+   * Receives the values of a document in order while it is parsed. Keys and
+   * strings are only valid until the call returns. Returning `false` from
+   * any method stops parsing.
+   */
+  class Visitor {
     public:
-      Number () = default;
-      Number (const Number& number) {
-        this->data = number.value();
-      }
-
-      Number (double number) {
-        this->data = number;
-      }
-
-      Number (char number) {
-        this->data = (double) number;
-      }
-
-      Number (int number) {
-        this->data = (double) number;
-      }
-
-      Number (int64_t number) {
-        this->data = (double) number;
-      }
-
-      Number (bool number) {
-        this->data = (double) number;
-      }
-
-      Number (const String& string);
-
-      float value () const {
-        return this->data;
-      }
-
-      SSC::String str () const;
+      virtual ~Visitor () = default;
+      virtual bool onNull () { return true; }
+      virtual bool onBoolean (bool value) { return true; }
+      virtual bool onNumber (double value) { return true; }
+      virtual bool onString (std::string_view value) { return true; }
+      virtual bool onKey (std::string_view key) { return true; }
+      virtual bool onObjectStart () { return true; }
+      virtual bool onObjectEnd () { return true; }
+      virtual bool onArrayStart () { return true; }
+      virtual bool onArrayEnd () { return true; }
   };
 
-  class String : public Value<SSC::String, Type::String> {
-    public:
-      String () = default;
-      String (const String& data) {
-        this->data = SSC::String(data.value());
-      }
-
-      String (const SSC::String data) {
-        this->data = data;
-      }
-
-      String (const char data) {
-        this->data = SSC::String(1, data);
-      }
+  // the deepest nesting of objects and arrays `parse()` accepts
+  constexpr int MAX_PARSE_DEPTH = 512;
 
-      String (const char *data) {
-        this->data = SSC::String(data);
-      }
+  // parses a document into a value, throws `Error` for invalid JSON
+  Any parse (const char* source, size_t size);
+  Any parse (const SSC::String& source);
 
-      String (const Any& any) {
-        this->data = any.str();
-      }
+  // parses a document into `visitor`, returns `false` if it stopped early
+  bool parse (const char* source, size_t size, Visitor& visitor);
+  bool parse (const SSC::String& source, Visitor& visitor);
 
-      String (const Number& number);
-
-      String (const Boolean& boolean) {
-        this->data = boolean.str();
-      }
-
-      SSC::String str () const;
-
-      SSC::String value () const {
-        return this->data;
-      }
-
-      auto size () const {
-        return this->data.size();
-      }
-  };
+  // parses only the value of `key` in an object document, other values
+  // are scanned without being built, `null` if there is no such key
+  Any pick (const char* source, size_t size, const SSC::String& key);
+  Any pick (const SSC::String& source, const SSC::String& key);
 }
 
 #endif
@@ -1,5 +1,9 @@
 #include "core.hh"
 
+#if defined(__linux__)
+#include <netinet/udp.h>
+#endif
+
 namespace SSC {
   void Core::resumeAllPeers () {
     dispatchEventLoop([=, this]() {
@@ -79,6 +83,28 @@ namespace SSC {
     return peer;
   }
 
+  /**
+   * Rewrites an IPv4-mapped IPv6 address (`::ffff:a.b.c.d`) as IPv4.
+   */
+  static void unmapSocketAddress (struct sockaddr_storage *addr) {
+    if (addr->ss_family != AF_INET6) return;
+
+    auto in6 = (struct sockaddr_in6 *) addr;
+    auto bytes = (const uint8_t *) &in6->sin6_addr;
+    static const uint8_t prefix[12] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF };
+
+    if (memcmp(bytes, prefix, sizeof(prefix)) != 0) return;
+
+    struct sockaddr_in in4;
+    memset(&in4, 0, sizeof(in4));
+    in4.sin_family = AF_INET;
+    in4.sin_port = in6->sin6_port;
+    memcpy(&in4.sin_addr, bytes + 12, 4);
+
+    memset(addr, 0, sizeof(struct sockaddr_storage));
+    memcpy(addr, &in4, sizeof(in4));
+  }
+
   int LocalPeerInfo::getsockname (uv_udp_t *socket, struct sockaddr *addr) {
     int namelen = sizeof(struct sockaddr_storage);
     return uv_udp_getsockname(socket, addr, &namelen);
@@ -159,7 +185,13 @@ namespace SSC {
     this->init(&this->addr);
   }
 
-  void RemotePeerInfo::init (const struct sockaddr_storage *addr) {
+  void RemotePeerInfo::init (const struct sockaddr_storage *storage) {
+    struct sockaddr_storage unmapped;
+    auto addr = &unmapped;
+
+    memcpy(&unmapped, storage, sizeof(unmapped));
+    unmapSocketAddress(&unmapped);
+
     if (addr->ss_family == AF_INET) {
       this->family = "IPv4";
       this->address = addrToIPv4((struct sockaddr_in*) addr);
@@ -181,6 +213,10 @@ namespace SSC {
     this->type = peerType;
     this->core = core;
 
+    memset(&this->addr, 0, sizeof(this->addr));
+    memset(&this->local.addr, 0, sizeof(this->local.addr));
+    memset(&this->remote.addr, 0, sizeof(this->remote.addr));
+
     if (isEphemeral) {
       this->flags = (peer_flag_t) (this->flags | PEER_FLAG_EPHEMERAL);
     }
@@ -190,6 +226,18 @@ namespace SSC {
 
   Peer::~Peer () {
     this->core->removePeer(this->id, true); // auto close
+
+    if (this->slab.bytes != nullptr) {
+      delete [] this->slab.bytes;
+      this->slab.bytes = nullptr;
+      this->slab.size = 0;
+    }
+
+    for (auto request : this->sendRequests) {
+      delete request;
+    }
+
+    this->sendRequests.clear();
   }
 
   int Peer::init () {
@@ -200,7 +248,9 @@ namespace SSC {
     memset(&this->handle, 0, sizeof(this->handle));
 
     if (this->type == PEER_TYPE_UDP) {
-      if ((err = uv_udp_init(loop, (uv_udp_t *) &this->handle))) {
+      // `UV_UDP_RECVMMSG` is ignored on platforms without `recvmmsg(2)`
+      auto flags = AF_UNSPEC | UV_UDP_RECVMMSG;
+      if ((err = uv_udp_init_ex(loop, (uv_udp_t *) &this->handle, flags))) {
         return err;
       }
       this->handle.udp.data = (void *) this;
@@ -227,6 +277,8 @@ namespace SSC {
   int Peer::initLocalPeerInfo () {
     Lock lock(this->mutex);
     if (this->type == PEER_TYPE_UDP) {
+      // cached destinations depend on the family of the local address
+      this->destinations.clear();
       this->local.init((uv_udp_t *) &this->handle);
     } else if (this->type == PEER_TYPE_TCP) {
       this->local.init((uv_tcp_t *) &this->handle);
@@ -316,7 +368,12 @@ namespace SSC {
       return info->err;
     }
 
-    return this->bind(info->address, info->port, this->options.udp.reuseAddr);
+    return this->bind(
+      info->address,
+      info->port,
+      this->options.udp.reuseAddr,
+      this->options.udp.ipv6Only
+    );
   }
 
   int Peer::bind (const String address, int port) {
@@ -324,23 +381,37 @@ namespace SSC {
   }
 
   int Peer::bind (const String address, int port, bool reuseAddr) {
+    return this->bind(address, port, reuseAddr, false);
+  }
+
+  int Peer::bind (
+    const String address,
+    int port,
+    bool reuseAddr,
+    bool ipv6Only
+  ) {
     Lock lock(this->mutex);
     auto sockaddr = (struct sockaddr*) &this->addr;
     int flags = 0;
     int err = 0;
 
     this->options.udp.reuseAddr = reuseAddr;
+    this->options.udp.ipv6Only = ipv6Only;
 
     if (reuseAddr) {
       flags |= UV_UDP_REUSEADDR;
     }
 
     if (this->isUDP()) {
-      if ((err = uv_ip4_addr((char *) address.c_str(), port, &this->addr))) {
+      if ((err = parseSocketAddress(address, port, &this->addr))) {
         return err;
       }
 
-      // @TODO(jwerle): support flags in `bind()`
+      // sockets bound to an IPv6 address are dual-stack unless `ipv6Only`
+      if (ipv6Only && this->addr.ss_family == AF_INET6) {
+        flags |= UV_UDP_IPV6ONLY;
+      }
+
       if ((err = uv_udp_bind((uv_udp_t *) &this->handle, sockaddr, flags))) {
         return err;
       }
@@ -365,7 +436,7 @@ namespace SSC {
     }
 
     Lock lock(this->mutex);
-    memset((void *) &this->addr, 0, sizeof(struct sockaddr_in));
+    memset((void *) &this->addr, 0, sizeof(this->addr));
 
     if ((err = this->bind())) {
       return err;
@@ -385,7 +456,7 @@ namespace SSC {
     auto sockaddr = (struct sockaddr*) &this->addr;
     int err = 0;
 
-    if ((err = uv_ip4_addr((char *) address.c_str(), port, &this->addr))) {
+    if ((err = this->getDestinationAddress(address, port, &this->addr))) {
       return err;
     }
 
@@ -419,6 +490,51 @@ namespace SSC {
     return err;
   }
 
+  int Peer::getDestinationAddress (
+    const String& address,
+    int port,
+    struct sockaddr_storage *addr
+  ) {
+    Lock lock(this->mutex);
+    auto key = address + ":" + std::to_string(port);
+    auto cached = this->destinations.find(key);
+    int err = 0;
+
+    if (cached != this->destinations.end()) {
+      *addr = cached->second;
+      return err;
+    }
+
+    if ((err = parseSocketAddress(address, port, addr))) {
+      return err;
+    }
+
+    // dual-stack sockets reach IPv4 destinations through mapped addresses
+    if (
+      addr->ss_family == AF_INET &&
+      this->local.addr.ss_family == AF_INET6 &&
+      !this->options.udp.ipv6Only
+    ) {
+      auto in4 = *((struct sockaddr_in *) addr);
+      auto in6 = (struct sockaddr_in6 *) addr;
+      auto bytes = (uint8_t *) &in6->sin6_addr;
+
+      memset(addr, 0, sizeof(struct sockaddr_storage));
+      in6->sin6_family = AF_INET6;
+      in6->sin6_port = in4.sin_port;
+      bytes[10] = 0xFF;
+      bytes[11] = 0xFF;
+      memcpy(bytes + 12, &in4.sin_addr, 4);
+    }
+
+    if (this->destinations.size() >= UDP_DESTINATION_CACHE_SIZE) {
+      this->destinations.clear();
+    }
+
+    this->destinations.emplace(std::move(key), *addr);
+    return err;
+  }
+
   void Peer::send (
     char *buf,
     size_t size,
@@ -426,53 +542,549 @@ namespace SSC {
     const String address,
     Peer::RequestContext::Callback cb
   ) {
-    Lock lock(this->mutex);
+    return this->send(buf, size, port, address, 0, cb);
+  }
+
+  void Peer::send (
+    char *buf,
+    size_t size,
+    int port,
+    const String address,
+    size_t segmentSize,
+    Peer::RequestContext::Callback cb
+  ) {
+    if (segmentSize > 0 && size > segmentSize) {
+      return this->sendSegments(buf, size, port, address, segmentSize, cb);
+    }
+
     int err = 0;
 
+    struct sockaddr_storage destination;
     struct sockaddr *sockaddr = nullptr;
 
     if (!this->isConnected()) {
-      sockaddr = (struct sockaddr *) &this->addr;
-      err = uv_ip4_addr((char *) address.c_str(), port, &this->addr);
+      sockaddr = (struct sockaddr *) &destination;
+      err = this->getDestinationAddress(address, port, &destination);
 
       if (err) {
         return cb(err, Post{});
       }
     }
 
+    auto handle = (uv_udp_t *) &this->handle;
     auto buffer = uv_buf_init(buf, (int) size);
-    auto ctx = new Peer::RequestContext(cb);
-    auto req = new uv_udp_send_t;
 
-    req->data = (void *) ctx;
-    ctx->peer = this;
+    // most sends complete right away, so only queue a request when the
+    // socket would block or when earlier sends are still queued, which
+    // `uv_udp_try_send()` also reports as `UV_EAGAIN`
+    err = uv_udp_try_send(handle, &buffer, 1, sockaddr);
 
-    err = uv_udp_send(req, (uv_udp_t *) &this->handle, &buffer, 1, sockaddr, [](uv_udp_send_t *req, int status) {
-      auto ctx = reinterpret_cast<Peer::RequestContext*>(req->data);
-      auto peer = ctx->peer;
+    if (err != UV_EAGAIN && err != UV_ENOSYS) {
+      cb(err < 0 ? err : 0, Post{});
+
+      if (this->isEphemeral()) {
+        this->close();
+      }
+
+      return;
+    }
 
-      ctx->cb(status, Post{});
+    UDPSendRequest *request = nullptr;
+
+    if (this->sendRequests.size() > 0) {
+      request = this->sendRequests.back();
+      this->sendRequests.pop_back();
+    } else {
+      request = new UDPSendRequest;
+    }
+
+    request->cb = std::move(cb);
+    request->peer = this;
+    request->req.data = (void *) request;
+
+    err = uv_udp_send(&request->req, handle, &buffer, 1, sockaddr, [](uv_udp_send_t *req, int status) {
+      auto request = reinterpret_cast<UDPSendRequest*>(req->data);
+      auto peer = request->peer;
+      auto cb = std::move(request->cb);
+
+      request->cb = nullptr;
+
+      if (peer->sendRequests.size() < UDP_SEND_REQUEST_POOL_SIZE) {
+        peer->sendRequests.push_back(request);
+      } else {
+        delete request;
+      }
+
+      cb(status, Post{});
 
       if (peer->isEphemeral()) {
         peer->close();
       }
-
-      delete ctx;
-      delete req;
     });
 
     if (err < 0) {
-      ctx->cb(err, Post{});
+      auto cb = std::move(request->cb);
+      request->cb = nullptr;
+      this->sendRequests.push_back(request);
+
+      cb(err, Post{});
 
       if (this->isEphemeral()) {
         this->close();
       }
+    }
+  }
 
-      delete ctx;
-      delete req;
+  /**
+   * Sends `buf` as datagrams of `segmentSize` bytes, the last one possibly
+   * shorter. On Linux the kernel splits them with UDP segmentation offload
+   * (GSO), otherwise, or once the socket would block, the remaining
+   * segments are sent with `sendMany()`.
+   */
+  void Peer::sendSegments (
+    char *buf,
+    size_t size,
+    int port,
+    const String address,
+    size_t segmentSize,
+    Peer::RequestContext::Callback cb
+  ) {
+    Vector<UDPSendDatagram> segments;
+    size_t offset = 0;
+
+  #if defined(__linux__) && defined(UDP_SEGMENT)
+    auto handle = (uv_udp_t *) &this->handle;
+    auto connected = this->isConnected();
+    struct sockaddr_storage destination;
+    uv_os_fd_t fd;
+    int err = 0;
+
+    if (!connected && (err = this->getDestinationAddress(address, port, &destination))) {
+      return cb(err, Post{});
+    }
+
+    // like `sendMany()`, only write directly when nothing is queued in libuv
+    if (
+      (this->flags & PEER_FLAG_UDP_GSO_UNSUPPORTED) == 0 &&
+      uv_udp_get_send_queue_count(handle) == 0 &&
+      uv_fileno((uv_handle_t *) handle, &fd) == 0
+    ) {
+      auto count = std::min(UDP_GSO_MAX_SEGMENTS, UDP_GSO_MAX_SIZE / segmentSize);
+
+      while (count > 0 && offset < size) {
+        char control[CMSG_SPACE(sizeof(uint16_t))] = {0};
+        auto length = std::min(size - offset, count * segmentSize);
+        struct iovec iov = { buf + offset, length };
+        struct msghdr header;
+
+        memset(&header, 0, sizeof(header));
+        header.msg_iov = &iov;
+        header.msg_iovlen = 1;
+
+        if (!connected) {
+          header.msg_name = &destination;
+          header.msg_namelen = getSocketAddressLength(&destination);
+        }
+
+        if (length > segmentSize) {
+          header.msg_control = control;
+          header.msg_controllen = sizeof(control);
+
+          auto cmsg = CMSG_FIRSTHDR(&header);
+          uint16_t value = (uint16_t) segmentSize;
+          cmsg->cmsg_level = SOL_UDP;
+          cmsg->cmsg_type = UDP_SEGMENT;
+          cmsg->cmsg_len = CMSG_LEN(sizeof(value));
+          memcpy(CMSG_DATA(cmsg), &value, sizeof(value));
+        }
+
+        auto result = sendmsg(fd, &header, MSG_DONTWAIT);
+
+        if (result >= 0) {
+          offset += length;
+        } else if (errno == EINTR) {
+          continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+          break;
+        } else if (
+          offset == 0 &&
+          (errno == EINVAL || errno == EIO || errno == ENOPROTOOPT || errno == EOPNOTSUPP)
+        ) {
+          // the kernel, route or device does not support GSO for this socket
+          this->flags = (peer_flag_t) (this->flags | PEER_FLAG_UDP_GSO_UNSUPPORTED);
+          break;
+        } else {
+          cb(uv_translate_sys_error(errno), Post{});
+
+          if (this->isEphemeral()) {
+            this->close();
+          }
+
+          return;
+        }
+      }
+    }
+
+    if (offset == size) {
+      cb(0, Post{});
+
+      if (this->isEphemeral()) {
+        this->close();
+      }
+
+      return;
+    }
+  #endif
+
+    for (; offset < size; offset += segmentSize) {
+      UDPSendDatagram segment;
+      segment.bytes = buf + offset;
+      segment.size = std::min(segmentSize, size - offset);
+      segment.address = address;
+      segment.port = port;
+      segments.push_back(segment);
+    }
+
+    this->sendMany(segments, [cb](auto err, auto sent, auto failed) {
+      cb(failed > 0 ? err : 0, Post{});
+    });
+  }
+
+  struct SendManyContext {
+    Peer *peer = nullptr;
+    Peer::UDPSendManyCallback cb;
+    size_t pending = 0;
+    size_t sent = 0;
+    size_t failed = 0;
+    int err = 0;
+
+    void fail (int err) {
+      if (this->err == 0) {
+        this->err = err;
+      }
+
+      this->failed++;
+    }
+  };
+
+  static void finishSendMany (SendManyContext *ctx) {
+    auto peer = ctx->peer;
+
+    ctx->cb(ctx->err, ctx->sent, ctx->failed);
+
+    if (peer->isEphemeral()) {
+      peer->close();
+    }
+
+    delete ctx;
+  }
+
+  void Peer::sendMany (
+    const Vector<UDPSendDatagram>& datagrams,
+    UDPSendManyCallback cb
+  ) {
+    Lock lock(this->mutex);
+    auto handle = (uv_udp_t *) &this->handle;
+    auto connected = this->isConnected();
+    auto ctx = new SendManyContext;
+
+    Vector<struct sockaddr_storage> addrs;
+    Vector<uv_buf_t> buffers;
+    size_t count = 0;
+    size_t i = 0;
+
+    ctx->peer = this;
+    ctx->cb = cb;
+
+    addrs.resize(datagrams.size());
+    buffers.resize(datagrams.size());
+
+    // destinations are parsed up front, unparsable ones are counted as failed
+    for (const auto& datagram : datagrams) {
+      auto addr = &addrs[count];
+      int err = 0;
+
+      memset(addr, 0, sizeof(struct sockaddr_storage));
+
+      if (!connected) {
+        err = this->getDestinationAddress(datagram.address, datagram.port, addr);
+      }
+
+      if (err) {
+        ctx->fail(err);
+        continue;
+      }
+
+      buffers[count++] = uv_buf_init((char *) datagram.bytes, (unsigned int) datagram.size);
+    }
+
+  #if defined(__linux__)
+    // `sendmmsg(2)` writes the whole batch with one syscall, but only when
+    // nothing is queued in libuv, otherwise datagrams would be reordered
+    uv_os_fd_t fd;
+    if (
+      count > 0 &&
+      uv_udp_get_send_queue_count(handle) == 0 &&
+      uv_fileno((uv_handle_t *) handle, &fd) == 0
+    ) {
+      Vector<struct mmsghdr> messages(count);
+
+      for (size_t j = 0; j < count; ++j) {
+        auto& header = messages[j].msg_hdr;
+        memset(&messages[j], 0, sizeof(struct mmsghdr));
+        // `uv_buf_t` is ABI compatible with `struct iovec` on unix
+        header.msg_iov = (struct iovec *) &buffers[j];
+        header.msg_iovlen = 1;
+
+        if (!connected) {
+          header.msg_name = &addrs[j];
+          header.msg_namelen = getSocketAddressLength(&addrs[j]);
+        }
+      }
+
+      while (i < count) {
+        auto result = sendmmsg(fd, messages.data() + i, count - i, MSG_DONTWAIT);
+
+        if (result > 0) {
+          ctx->sent += result;
+          i += result;
+        } else if (result < 0 && errno == EINTR) {
+          continue;
+        } else if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+          break;
+        } else {
+          // the datagram at `i` was rejected, skip it and carry on
+          ctx->fail(uv_translate_sys_error(errno));
+          i++;
+        }
+      }
+    }
+  #endif
+
+    // `uv_udp_try_send()` binds unbound sockets and covers other platforms
+    for (; i < count; ++i) {
+      auto addr = connected ? nullptr : (const struct sockaddr *) &addrs[i];
+      auto err = uv_udp_try_send(handle, &buffers[i], 1, addr);
+
+      if (err == UV_EAGAIN) {
+        break;
+      } else if (err < 0) {
+        ctx->fail(err);
+      } else {
+        ctx->sent++;
+      }
+    }
+
+    // the rest is queued in libuv once the socket would block
+    for (; i < count; ++i) {
+      auto addr = connected ? nullptr : (const struct sockaddr *) &addrs[i];
+      auto req = new uv_udp_send_t;
+
+      req->data = (void *) ctx;
+      ctx->pending++;
+
+      auto err = uv_udp_send(req, handle, &buffers[i], 1, addr, [](uv_udp_send_t *req, int status) {
+        auto ctx = reinterpret_cast<SendManyContext*>(req->data);
+
+        if (status < 0) {
+          ctx->fail(status);
+        } else {
+          ctx->sent++;
+        }
+
+        delete req;
+
+        if (--ctx->pending == 0) {
+          finishSendMany(ctx);
+        }
+      });
+
+      if (err < 0) {
+        ctx->pending--;
+        ctx->fail(err);
+        delete req;
+      }
+    }
+
+    if (ctx->pending == 0) {
+      finishSendMany(ctx);
+    }
+  }
+
+#if defined(__linux__) && defined(UDP_GRO)
+  /**
+   * Reads up to `UDP_RECV_BATCH_SIZE` coalesced reads from a socket with
+   * UDP generic receive offload (GRO) enabled into the receive slab and
+   * splits each one into datagrams with the segment size from the kernel.
+   */
+  static void onGenericReceiveOffloadPoll (uv_poll_t *poll, int status, int events) {
+    auto peer = (Peer *) poll->data;
+    auto size = Peer::UDP_RECV_DATAGRAM_SIZE * Peer::UDP_RECV_BATCH_SIZE;
+    uv_os_fd_t fd;
+    size_t reads = 0;
+
+    peer->datagrams.clear();
+
+    if (status < 0) {
+      return peer->receiveCallback(status, peer->datagrams);
+    }
+
+    if (uv_fileno((uv_handle_t *) poll, &fd) != 0) {
+      return;
+    }
+
+    if (peer->slab.size < size) {
+      if (peer->slab.bytes != nullptr) {
+        delete [] peer->slab.bytes;
+      }
+
+      peer->slab.bytes = new char[size]{0};
+      peer->slab.size = size;
+    }
+
+    while (reads < Peer::UDP_RECV_BATCH_SIZE) {
+      char control[CMSG_SPACE(sizeof(int))] = {0};
+      auto bytes = peer->slab.bytes + reads * Peer::UDP_RECV_DATAGRAM_SIZE;
+      struct iovec iov = { bytes, Peer::UDP_RECV_DATAGRAM_SIZE };
+      struct sockaddr_storage addr;
+      struct msghdr header;
+
+      memset(&header, 0, sizeof(header));
+      header.msg_name = &addr;
+      header.msg_namelen = sizeof(addr);
+      header.msg_iov = &iov;
+      header.msg_iovlen = 1;
+      header.msg_control = control;
+      header.msg_controllen = sizeof(control);
+
+      auto nread = recvmsg(fd, &header, MSG_DONTWAIT);
+
+      if (nread < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+
+        // deliver errors other than an empty socket when nothing was read
+        if (errno != EAGAIN && errno != EWOULDBLOCK && peer->datagrams.size() == 0) {
+          return peer->receiveCallback(uv_translate_sys_error(errno), peer->datagrams);
+        }
+
+        break;
+      }
+
+      // without a `UDP_GRO` control message the read is a single datagram
+      auto segmentSize = (ssize_t) nread;
+      for (auto cmsg = CMSG_FIRSTHDR(&header); cmsg != nullptr; cmsg = CMSG_NXTHDR(&header, cmsg)) {
+        if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+          int value = 0;
+          memcpy(&value, CMSG_DATA(cmsg), sizeof(value));
+          if (value > 0) {
+            segmentSize = value;
+          }
+        }
+      }
+
+      // IPv4 senders on a dual-stack socket are reported as IPv4
+      unmapSocketAddress(&addr);
+
+      ssize_t offset = 0;
+      do {
+        Peer::UDPDatagram datagram;
+        datagram.bytes = bytes + offset;
+        datagram.size = (size_t) std::min(segmentSize, nread - offset);
+        datagram.addr = addr;
+        peer->datagrams.push_back(datagram);
+        offset += segmentSize;
+      } while (offset < nread);
+
+      reads++;
+    }
+
+    if (peer->datagrams.size() > 0) {
+      peer->receiveCallback((ssize_t) peer->datagrams.size(), peer->datagrams);
+      peer->datagrams.clear();
     }
   }
 
+  static int startGenericReceiveOffload (Peer *peer) {
+    auto handle = (uv_handle_t *) &peer->handle;
+    uv_os_fd_t fd;
+    int enable = 1;
+    int err = 0;
+
+    if ((err = uv_fileno(handle, &fd))) {
+      return err;
+    }
+
+    if (setsockopt(fd, SOL_UDP, UDP_GRO, &enable, sizeof(enable)) < 0) {
+      return uv_translate_sys_error(errno);
+    }
+
+    // libuv keeps a single watcher per descriptor, so a duplicate is polled
+    // and read directly because `uv_udp_recv_start()` drops control messages
+    auto poll = new uv_poll_t;
+    auto pollfd = dup(fd);
+
+    if (pollfd < 0) {
+      err = uv_translate_sys_error(errno);
+    } else if ((err = uv_poll_init(peer->core->getEventLoop(), poll, pollfd)) == 0) {
+      poll->data = (void *) peer;
+
+      if ((err = uv_poll_start(poll, UV_READABLE, onGenericReceiveOffloadPoll)) == 0) {
+        peer->groPoll = poll;
+        return 0;
+      }
+
+      uv_close((uv_handle_t *) poll, [](uv_handle_t *handle) {
+        delete (uv_poll_t *) handle;
+      });
+
+      poll = nullptr;
+    }
+
+    if (poll != nullptr) {
+      delete poll;
+    }
+
+    if (pollfd >= 0) {
+      ::close(pollfd);
+    }
+
+    enable = 0;
+    setsockopt(fd, SOL_UDP, UDP_GRO, &enable, sizeof(enable));
+    return err;
+  }
+
+  static void stopGenericReceiveOffload (Peer *peer) {
+    auto poll = peer->groPoll;
+    uv_os_fd_t pollfd;
+    uv_os_fd_t fd;
+    int enable = 0;
+
+    if (poll == nullptr) {
+      return;
+    }
+
+    peer->groPoll = nullptr;
+
+    auto hasPollDescriptor = uv_fileno((uv_handle_t *) poll, &pollfd) == 0;
+
+    uv_close((uv_handle_t *) poll, [](uv_handle_t *handle) {
+      delete (uv_poll_t *) handle;
+    });
+
+    // `uv_close()` stops polling right away, so the duplicate can go now
+    if (hasPollDescriptor) {
+      ::close(pollfd);
+    }
+
+    // later reads through libuv must not be coalesced
+    if (uv_fileno((uv_handle_t *) &peer->handle, &fd) == 0) {
+      setsockopt(fd, SOL_UDP, UDP_GRO, &enable, sizeof(enable));
+    }
+  }
+#endif
+
   int Peer::recvstart () {
     if (this->receiveCallback != nullptr) {
       return this->recvstart(this->receiveCallback);
@@ -491,11 +1103,36 @@ namespace SSC {
     this->addState(PEER_STATE_UDP_RECV_STARTED);
     this->receiveCallback = receiveCallback;
 
+    this->datagrams.reserve(UDP_RECV_BATCH_SIZE);
+
+  #if defined(__linux__) && defined(UDP_GRO)
+    // falls back to reading through libuv when GRO is not available
+    if (this->options.udp.gro && startGenericReceiveOffload(this) == 0) {
+      return 0;
+    }
+  #endif
+
+    // a single slab is reused for every read: libuv slices it into
+    // `UDP_RECV_DATAGRAM_SIZE` chunks when `recvmmsg(2)` is in use and
+    // datagrams are copied out before the next read is scheduled
     auto allocate = [](uv_handle_t *handle, size_t size, uv_buf_t *buf) {
-      if (size > 0) {
-        buf->base = (char *) new char[size]{0};
-        buf->len = size;
+      auto peer = (Peer *) handle->data;
+
+      if (uv_udp_using_recvmmsg((uv_udp_t *) handle)) {
+        size = UDP_RECV_DATAGRAM_SIZE * UDP_RECV_BATCH_SIZE;
+      }
+
+      if (peer->slab.size < size) {
+        if (peer->slab.bytes != nullptr) {
+          delete [] peer->slab.bytes;
+        }
+
+        peer->slab.bytes = new char[size]{0};
+        peer->slab.size = size;
       }
+
+      buf->base = peer->slab.bytes;
+      buf->len = peer->slab.size;
     };
 
     auto receive = [](
@@ -508,11 +1145,39 @@ namespace SSC {
       auto peer = (Peer *) handle->data;
 
       if (nread == UV_ENOTCONN) {
+        peer->datagrams.clear();
         peer->recvstop();
         return;
       }
 
-      peer->receiveCallback(nread, buf, addr);
+      if (nread < 0) {
+        peer->datagrams.clear();
+        peer->receiveCallback(nread, peer->datagrams);
+        return;
+      }
+
+      // `nread == 0` without an address means there was nothing to read
+      if (addr != nullptr) {
+        UDPDatagram datagram;
+        auto size = addr->sa_family == AF_INET6
+          ? sizeof(struct sockaddr_in6)
+          : sizeof(struct sockaddr_in);
+
+        datagram.bytes = buf->base;
+        datagram.size = (size_t) nread;
+        memset(&datagram.addr, 0, sizeof(datagram.addr));
+        memcpy(&datagram.addr, addr, size);
+        // IPv4 senders on a dual-stack socket are reported as IPv4
+        unmapSocketAddress(&datagram.addr);
+        peer->datagrams.push_back(datagram);
+      }
+
+      // chunks of a `recvmmsg(2)` batch are followed by a final call
+      // with `UV_UDP_MMSG_FREE`, so only deliver when the batch is done
+      if ((flags & UV_UDP_MMSG_CHUNK) == 0 && peer->datagrams.size() > 0) {
+        peer->receiveCallback((ssize_t) peer->datagrams.size(), peer->datagrams);
+        peer->datagrams.clear();
+      }
     };
 
     return uv_udp_recv_start((uv_udp_t *) &this->handle, allocate, receive);
@@ -524,15 +1189,432 @@ namespace SSC {
     if (this->hasState(PEER_STATE_UDP_RECV_STARTED)) {
       this->removeState(PEER_STATE_UDP_RECV_STARTED);
       Lock lock(this->core->loopMutex);
+
+    #if defined(__linux__) && defined(UDP_GRO)
+      if (this->groPoll != nullptr) {
+        stopGenericReceiveOffload(this);
+        return err;
+      }
+    #endif
+
       err = uv_udp_recv_stop((uv_udp_t *) &this->handle);
     }
 
     return err;
   }
 
+  int Peer::setBroadcast (bool enabled) {
+    Lock lock(this->mutex);
+    return uv_udp_set_broadcast((uv_udp_t *) &this->handle, enabled ? 1 : 0);
+  }
+
+  int Peer::setTTL (int ttl) {
+    Lock lock(this->mutex);
+    return uv_udp_set_ttl((uv_udp_t *) &this->handle, ttl);
+  }
+
+  int Peer::setMulticastTTL (int ttl) {
+    Lock lock(this->mutex);
+    return uv_udp_set_multicast_ttl((uv_udp_t *) &this->handle, ttl);
+  }
+
+  int Peer::setMulticastLoopback (bool enabled) {
+    Lock lock(this->mutex);
+    return uv_udp_set_multicast_loop((uv_udp_t *) &this->handle, enabled ? 1 : 0);
+  }
+
+  int Peer::setMulticastInterface (const String& interfaceAddress) {
+    Lock lock(this->mutex);
+    return uv_udp_set_multicast_interface(
+      (uv_udp_t *) &this->handle,
+      interfaceAddress.size() > 0 ? interfaceAddress.c_str() : nullptr
+    );
+  }
+
+  int Peer::setMembership (
+    const String& multicastAddress,
+    const String& interfaceAddress,
+    bool join
+  ) {
+    Lock lock(this->mutex);
+    return uv_udp_set_membership(
+      (uv_udp_t *) &this->handle,
+      multicastAddress.c_str(),
+      interfaceAddress.size() > 0 ? interfaceAddress.c_str() : nullptr,
+      join ? UV_JOIN_GROUP : UV_LEAVE_GROUP
+    );
+  }
+
+  int Peer::setSourceMembership (
+    const String& multicastAddress,
+    const String& interfaceAddress,
+    const String& sourceAddress,
+    bool join
+  ) {
+    Lock lock(this->mutex);
+    return uv_udp_set_source_membership(
+      (uv_udp_t *) &this->handle,
+      multicastAddress.c_str(),
+      interfaceAddress.size() > 0 ? interfaceAddress.c_str() : nullptr,
+      sourceAddress.c_str(),
+      join ? UV_JOIN_GROUP : UV_LEAVE_GROUP
+    );
+  }
+
+  /**
+   * Marks sent datagrams with a differentiated services code point, the
+   * upper six bits of the IPv4 type of service or IPv6 traffic class.
+   * libuv has no wrapper for it, so the option is set on the descriptor.
+   */
+  int Peer::setDSCP (int dscp) {
+    if (dscp < 0 || dscp > 63) {
+      return UV_EINVAL;
+    }
+
+  #if defined(_WIN32)
+    // Windows ignores `IP_TOS`, traffic is marked with QoS policies instead
+    return UV_ENOTSUP;
+  #else
+    Lock lock(this->mutex);
+    auto handle = (uv_udp_t *) &this->handle;
+    struct sockaddr_storage local;
+    int namelen = sizeof(local);
+    int value = dscp << 2; // the lower two bits are ECN
+    uv_os_fd_t fd;
+    int err = 0;
+
+    if ((err = uv_fileno((uv_handle_t *) handle, &fd))) {
+      return err;
+    }
+
+    if ((err = uv_udp_getsockname(handle, (struct sockaddr *) &local, &namelen))) {
+      return err;
+    }
+
+    if (local.ss_family == AF_INET6) {
+      if (setsockopt(fd, IPPROTO_IPV6, IPV6_TCLASS, &value, sizeof(value)) < 0) {
+        return uv_translate_sys_error(errno);
+      }
+
+      // dual-stack sockets also mark datagrams sent to IPv4 destinations,
+      // which not every platform supports, so this may fail
+      if (!this->options.udp.ipv6Only) {
+        setsockopt(fd, IPPROTO_IP, IP_TOS, &value, sizeof(value));
+      }
+
+      return err;
+    }
+
+    if (setsockopt(fd, IPPROTO_IP, IP_TOS, &value, sizeof(value)) < 0) {
+      return uv_translate_sys_error(errno);
+    }
+
+    return err;
+  #endif
+  }
+
+  struct TCPConnectContext {
+    Peer *peer = nullptr;
+    Peer::TCPCallback cb;
+    uv_connect_t req;
+  };
+
+  struct TCPWriteContext {
+    Peer *peer = nullptr;
+    Peer::TCPCallback cb;
+    uv_write_t req;
+    char *bytes = nullptr;
+    bool replied = false;
+  };
+
+  struct TCPShutdownContext {
+    Peer *peer = nullptr;
+    Peer::TCPCallback cb;
+    uv_shutdown_t req;
+  };
+
+  int Peer::listen (
+    const String address,
+    int port,
+    int backlog,
+    bool ipv6Only,
+    TCPConnectionCallback onconnection
+  ) {
+    Lock lock(this->mutex);
+    auto sockaddr = (struct sockaddr*) &this->addr;
+    unsigned int flags = 0;
+    int err = 0;
+
+    if (!this->isTCP()) {
+      return UV_EINVAL;
+    }
+
+    if (this->hasState(PEER_STATE_TCP_LISTENING)) {
+      return UV_EALREADY;
+    }
+
+    if ((err = parseSocketAddress(address, port, &this->addr))) {
+      return err;
+    }
+
+    if (ipv6Only && this->addr.ss_family == AF_INET6) {
+      flags |= UV_TCP_IPV6ONLY;
+    }
+
+    this->options.tcp.ipv6Only = ipv6Only;
+
+    if ((err = uv_tcp_bind((uv_tcp_t *) &this->handle, sockaddr, flags))) {
+      return err;
+    }
+
+    this->connectionCallback = onconnection;
+
+    err = uv_listen((uv_stream_t *) &this->handle, backlog, [](uv_stream_t *server, int status) {
+      auto peer = (Peer *) server->data;
+
+      if (status < 0) {
+        peer->connectionCallback(status, nullptr);
+        return;
+      }
+
+      // accepted peers stay idle until `readstart()` is called for them
+      auto client = peer->core->createPeer(PEER_TYPE_TCP, rand64());
+      auto err = uv_accept(server, (uv_stream_t *) &client->handle);
+
+      if (err < 0) {
+        client->close();
+        peer->connectionCallback(err, nullptr);
+        return;
+      }
+
+      client->addState(PEER_STATE_TCP_CONNECTED);
+      client->initLocalPeerInfo();
+      client->initRemotePeerInfo();
+      peer->connectionCallback(0, client);
+    });
+
+    if (err < 0) {
+      return err;
+    }
+
+    this->addState((peer_state_t) (PEER_STATE_TCP_BOUND | PEER_STATE_TCP_LISTENING));
+    return this->initLocalPeerInfo();
+  }
+
+  void Peer::connect (const String address, int port, TCPCallback cb) {
+    Lock lock(this->mutex);
+    struct sockaddr_storage addr;
+    int err = 0;
+
+    if (!this->isTCP()) {
+      return cb(UV_EINVAL);
+    }
+
+    if ((err = parseSocketAddress(address, port, &addr))) {
+      return cb(err);
+    }
+
+    auto ctx = new TCPConnectContext;
+    ctx->req.data = (void *) ctx;
+    ctx->peer = this;
+    ctx->cb = cb;
+
+    err = uv_tcp_connect(&ctx->req, (uv_tcp_t *) &this->handle, (struct sockaddr *) &addr, [](uv_connect_t *req, int status) {
+      auto ctx = reinterpret_cast<TCPConnectContext*>(req->data);
+      auto peer = ctx->peer;
+
+      if (status == 0) {
+        peer->addState(PEER_STATE_TCP_CONNECTED);
+        peer->initLocalPeerInfo();
+        peer->initRemotePeerInfo();
+      }
+
+      ctx->cb(status);
+      delete ctx;
+    });
+
+    if (err < 0) {
+      delete ctx;
+      cb(err);
+    }
+  }
+
+  void Peer::write (const char *bytes, size_t size, TCPCallback cb) {
+    Lock lock(this->mutex);
+    auto stream = (uv_stream_t *) &this->handle;
+    auto buffer = uv_buf_init((char *) bytes, (unsigned int) size);
+    int err = 0;
+
+    if (!this->isConnected()) {
+      return cb(UV_ENOTCONN);
+    }
+
+    // write synchronously when nothing is queued ahead of `bytes`
+    if (uv_stream_get_write_queue_size(stream) == 0) {
+      err = uv_try_write(stream, &buffer, 1);
+
+      if (err >= 0 && (size_t) err == size) {
+        return cb(0);
+      } else if (err >= 0) {
+        buffer.base += err;
+        buffer.len -= err;
+      } else if (err != UV_EAGAIN) {
+        return cb(err);
+      }
+    }
+
+    // the rest is copied as `bytes` is only valid until `cb` is called
+    auto ctx = new TCPWriteContext;
+    ctx->bytes = new char[buffer.len];
+    ctx->req.data = (void *) ctx;
+    ctx->peer = this;
+    ctx->cb = cb;
+
+    memcpy(ctx->bytes, buffer.base, buffer.len);
+    buffer = uv_buf_init(ctx->bytes, buffer.len);
+
+    err = uv_write(&ctx->req, stream, &buffer, 1, [](uv_write_t *req, int status) {
+      auto ctx = reinterpret_cast<TCPWriteContext*>(req->data);
+      auto peer = ctx->peer;
+
+      if (!ctx->replied) {
+        ctx->cb(status);
+      } else if (status < 0 && status != UV_ECANCELED && peer->readCallback != nullptr) {
+        // the writer has moved on, so surface the error on the read side
+        peer->readCallback(status, nullptr);
+      }
+
+      delete [] ctx->bytes;
+      delete ctx;
+    });
+
+    if (err < 0) {
+      delete [] ctx->bytes;
+      delete ctx;
+      return cb(err);
+    }
+
+    // below the high water mark the writer can continue right away,
+    // above it the reply waits for the write to finish (backpressure)
+    if (uv_stream_get_write_queue_size(stream) < TCP_WRITE_HIGH_WATER_MARK) {
+      ctx->replied = true;
+      cb(0);
+    }
+  }
+
+  int Peer::readstart () {
+    if (this->readCallback != nullptr) {
+      return this->readstart(this->readCallback);
+    }
+
+    return UV_EINVAL;
+  }
+
+  int Peer::readstart (TCPReadCallback onread) {
+    Lock lock(this->mutex);
+
+    if (!this->isTCP()) {
+      return UV_EINVAL;
+    }
+
+    if (this->hasState(PEER_STATE_TCP_READING)) {
+      return UV_EALREADY;
+    }
+
+    this->addState(PEER_STATE_TCP_READING);
+    this->readCallback = onread;
+
+    if (this->isPaused()) {
+      return 0;
+    }
+
+    // read buffers are handed to `readCallback` as is, without copying
+    auto allocate = [](uv_handle_t *handle, size_t size, uv_buf_t *buf) {
+      buf->base = new char[size];
+      buf->len = size;
+    };
+
+    auto read = [](uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf) {
+      auto peer = (Peer *) stream->data;
+
+      if (nread > 0) {
+        peer->readCallback(nread, buf->base);
+        return;
+      }
+
+      if (buf->base != nullptr) {
+        delete [] buf->base;
+      }
+
+      if (nread < 0) {
+        peer->removeState(PEER_STATE_TCP_READING);
+        peer->readCallback(nread, nullptr);
+      }
+    };
+
+    return uv_read_start((uv_stream_t *) &this->handle, allocate, read);
+  }
+
+  int Peer::readstop () {
+    int err = 0;
+
+    if (this->hasState(PEER_STATE_TCP_READING)) {
+      this->removeState(PEER_STATE_TCP_READING);
+      Lock lock(this->mutex);
+      err = uv_read_stop((uv_stream_t *) &this->handle);
+    }
+
+    return err;
+  }
+
+  void Peer::shutdown (TCPCallback cb) {
+    Lock lock(this->mutex);
+
+    if (!this->isConnected()) {
+      return cb(UV_ENOTCONN);
+    }
+
+    if (this->hasState(PEER_STATE_TCP_SHUTDOWN)) {
+      return cb(UV_EALREADY);
+    }
+
+    auto ctx = new TCPShutdownContext;
+    ctx->req.data = (void *) ctx;
+    ctx->peer = this;
+    ctx->cb = cb;
+
+    // pending writes are flushed before the write side is closed
+    auto err = uv_shutdown(&ctx->req, (uv_stream_t *) &this->handle, [](uv_shutdown_t *req, int status) {
+      auto ctx = reinterpret_cast<TCPShutdownContext*>(req->data);
+      ctx->cb(status);
+      delete ctx;
+    });
+
+    if (err < 0) {
+      delete ctx;
+      return cb(err);
+    }
+
+    this->addState(PEER_STATE_TCP_SHUTDOWN);
+  }
+
   int Peer::resume () {
     int err = 0;
 
+    // TCP streams survive while paused, only reading is stopped
+    if (this->isTCP()) {
+      if (this->isPaused()) {
+        this->removeState(PEER_STATE_TCP_PAUSED);
+
+        if (this->hasState(PEER_STATE_TCP_READING)) {
+          this->removeState(PEER_STATE_TCP_READING);
+          err = this->readstart();
+        }
+      }
+
+      return err;
+    }
+
     if (this->isPaused()) {
       if ((err = this->init())) {
         return err;
@@ -555,6 +1637,19 @@ namespace SSC {
   int Peer::pause () {
     int err = 0;
 
+    if (this->isTCP()) {
+      if (!this->isPaused() && !this->isClosing()) {
+        this->addState(PEER_STATE_TCP_PAUSED);
+
+        if (this->hasState(PEER_STATE_TCP_READING)) {
+          Lock lock(this->mutex);
+          err = uv_read_stop((uv_stream_t *) &this->handle);
+        }
+      }
+
+      return err;
+    }
+
     if ((err = this->recvstop())) {
       return err;
     }
@@ -597,7 +1692,13 @@ namespace SSC {
       this->onclose.push_back(onclose);
     }
 
-    if (this->type == PEER_TYPE_UDP) {
+  #if defined(__linux__) && defined(UDP_GRO)
+    if (this->groPoll != nullptr) {
+      stopGenericReceiveOffload(this);
+    }
+  #endif
+
+    if (this->type == PEER_TYPE_UDP || this->type == PEER_TYPE_TCP) {
       Lock lock(this->mutex);
       // reset state and set to CLOSED
       uv_close((uv_handle_t*) &this->handle, [](uv_handle_t *handle) {
@@ -606,7 +1707,11 @@ namespace SSC {
           peer->removeState((peer_state_t) (
             PEER_STATE_UDP_BOUND |
             PEER_STATE_UDP_CONNECTED |
-            PEER_STATE_UDP_RECV_STARTED
+            PEER_STATE_UDP_RECV_STARTED |
+            PEER_STATE_TCP_BOUND |
+            PEER_STATE_TCP_CONNECTED |
+            PEER_STATE_TCP_LISTENING |
+            PEER_STATE_TCP_READING
           ));
 
           for (const auto &onclose : peer->onclose) {
@@ -1,28 +1,141 @@
 #include "string.hh"
 #include "debug.hh"
 
+#include <algorithm>
+#include <cctype>
 #include <regex>
+#include <string_view>
+#include <unordered_map>
 
 #if defined(min)
 #undef min
 #endif
 
 namespace SSC {
+  // compiled patterns of `replace()`, per thread so they need no lock
+  static const std::regex& getCachedRegex (const String& pattern) {
+    static constexpr size_t CACHE_MAX_ENTRIES = 64;
+    thread_local std::unordered_map<String, std::regex> cache;
+    auto entry = cache.find(pattern);
+
+    if (entry != cache.end()) {
+      return entry->second;
+    }
+
+    auto regex = std::regex(pattern);
+
+    if (cache.size() >= CACHE_MAX_ENTRIES) {
+      cache.clear();
+    }
+
+    return cache.emplace(pattern, std::move(regex)).first->second;
+  }
+
+  // the text `pattern` matches if it is plain text, where escaped
+  // punctuation like "\\." or "\\+" stands for itself
+  static bool getLiteralPattern (const String& pattern, String& literal) {
+    static constexpr auto special = std::string_view("^$\\.*+?()[]{}|");
+
+    literal.clear();
+    literal.reserve(pattern.size());
+
+    for (size_t i = 0; i < pattern.size(); ++i) {
+      const auto character = pattern[i];
+
+      if (character == '\\') {
+        // other escapes, like "\\d" or "\\s", have a special meaning
+        if (++i == pattern.size() || !std::ispunct((unsigned char) pattern[i])) {
+          return false;
+        }
+
+        literal.push_back(pattern[i]);
+      } else if (special.find(character) != std::string_view::npos) {
+        return false;
+      } else {
+        literal.push_back(character);
+      }
+    }
+
+    return literal.size() > 0;
+  }
+
   String replace (const String& source, const std::regex& regex, const String& value) {
     return std::regex_replace(source, regex, value);
   }
 
   String replace (const String& source, const String& regex, const String& value) {
-    return replace(source, std::regex(regex), value);
+    String literal;
+
+    // most patterns are plain text, which does not need a regular expression,
+    // unless the replacement refers to the match with `$`
+    if (value.find('$') == String::npos && getLiteralPattern(regex, literal)) {
+      return replaceAll(source, literal, value);
+    }
+
+    return replace(source, getCachedRegex(regex), value);
+  }
+
+  String replace (const String& source, const char character, const char value) {
+    auto output = source;
+    std::replace(output.begin(), output.end(), character, value);
+    return output;
+  }
+
+  String replaceAll (const String& source, const String& search, const String& value) {
+    auto position = search.size() > 0 ? source.find(search) : String::npos;
+
+    if (position == String::npos) {
+      return source;
+    }
+
+    String output;
+    size_t start = 0;
+    output.reserve(source.size());
+
+    while (position != String::npos) {
+      output.append(source, start, position - start);
+      output.append(value);
+      start = position + search.size();
+      position = source.find(search, start);
+    }
+
+    output.append(source, start);
+    return output;
   }
 
   String tmpl (const String& source, const Map& variables) {
     String output = source;
 
-    for (const auto tuple : variables) {
-      auto key = String("[{]+(" + tuple.first + ")[}]+");
-      auto value = tuple.second;
-      output = std::regex_replace(output, std::regex(key), value);
+    // replaces each `{key}`, `{{key}}` (or any number of braces) in turn
+    for (const auto& tuple : variables) {
+      const auto& key = tuple.first;
+      String result;
+      size_t start = 0;
+      auto position = output.find('{');
+
+      while (position != String::npos) {
+        const auto name = output.find_first_not_of('{', position);
+
+        if (
+          name != String::npos &&
+          output.compare(name, key.size(), key) == 0 &&
+          name + key.size() < output.size() &&
+          output[name + key.size()] == '}'
+        ) {
+          const auto end = output.find_first_not_of('}', name + key.size());
+          result.append(output, start, position - start);
+          result.append(tuple.second);
+          start = end == String::npos ? output.size() : end;
+          position = output.find('{', start);
+        } else {
+          position = name == String::npos ? name : output.find('{', name);
+        }
+      }
+
+      if (start > 0) {
+        result.append(output, start);
+        output = std::move(result);
+      }
     }
 
     return output;
@@ -50,20 +163,12 @@ namespace SSC {
   }
 
   const Vector<String> split (const String& source, const char character) {
-    String buffer;
+    auto tokenizer = Tokenizer(source, character);
     Vector<String> result;
+    StringView part;
 
-    for (const auto current : source) {
-      if (current != character) {
-        buffer += current;
-      } else if (current == character && buffer != "") {
-        result.push_back(buffer);
-        buffer = "";
-      }
-    }
-
-    if (!buffer.empty()) {
-      result.push_back(buffer);
+    while (tokenizer.next(part)) {
+      result.emplace_back(part);
     }
 
     return result;
@@ -93,6 +198,41 @@ namespace SSC {
     return source;
   }
 
+  StringView trimView (StringView source) {
+    const auto start = source.find_first_not_of(" \r\n\t");
+
+    if (start == StringView::npos) {
+      return source.substr(source.size());
+    }
+
+    return source.substr(start, source.find_last_not_of(" \r\n\t") - start + 1);
+  }
+
+  Tokenizer::Tokenizer (StringView source, const char separator)
+    : source(source),
+      separator(separator)
+  {}
+
+  bool Tokenizer::next (StringView& part) {
+    while (this->offset < this->source.size()) {
+      auto end = this->source.find(this->separator, this->offset);
+
+      if (end == StringView::npos) {
+        end = this->source.size();
+      }
+
+      const auto start = this->offset;
+      this->offset = end + 1;
+
+      if (end > start) {
+        part = this->source.substr(start, end - start);
+        return true;
+      }
+    }
+
+    return false;
+  }
+
   WString convertStringToWString (const String& source) {
     WString result(source.length(), L' ');
     std::copy(source.begin(), source.end(), result.begin());
@@ -15,6 +15,8 @@ namespace SSC {
   // transform
   String replace (const String& source, const String& regex, const String& value);
   String replace (const String& source, const std::regex& regex, const String& value);
+  String replace (const String& source, const char character, const char value);
+  String replaceAll (const String& source, const String& search, const String& value);
   String tmpl (const String& source, const Map& variables);
   String trim (String source);
 
@@ -33,6 +35,29 @@ namespace SSC {
   Vector<String> parseStringList (const String& string, const Vector<char>& separators);
   Vector<String> parseStringList (const String& string, const char separator);
   Vector<String> parseStringList (const String& string);
+
+  // views, which point into the source and do not allocate
+  StringView trimView (StringView source);
+
+  /**
+   * Yields the non-empty parts of `source` between `separator` characters
+   * as views into `source`, the same parts `split()` copies out.
+   * `source` must outlive the tokenizer.
+   *
+   *   StringView line;
+   *   for (auto lines = Tokenizer(source, '\n'); lines.next(line);) {
+   *     // ...
+   *   }
+   */
+  class Tokenizer {
+    StringView source;
+    size_t offset = 0;
+    char separator;
+
+    public:
+      Tokenizer (StringView source, const char separator);
+      bool next (StringView& part);
+  };
 }
 
 #endif
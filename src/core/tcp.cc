@@ -0,0 +1,442 @@
+#include "core.hh"
+
+namespace SSC {
+  static JSON::Object::Entries ERR_SOCKET_CLOSED (
+    const String& source,
+    uint64_t id
+  ) {
+    return JSON::Object::Entries {
+      {"source", source},
+      {"err", JSON::Object::Entries {
+        {"id", std::to_string(id)},
+        {"type", "InternalError"},
+        {"code", "ERR_SOCKET_CLOSED"},
+        {"message", "Socket is closed"}
+      }}
+    };
+  }
+
+  static JSON::Object::Entries ERR_SOCKET_CLOSING (
+    const String& source,
+    uint64_t id
+  ) {
+    return JSON::Object::Entries {
+      {"source", source},
+      {"err", JSON::Object::Entries {
+        {"id", std::to_string(id)},
+        {"type", "NotFoundError"},
+        {"code", "ERR_SOCKET_CLOSING"},
+        {"message", "Socket is closing"}
+      }}
+    };
+  }
+
+  static JSON::Object::Entries ERR_SOCKET_NOT_RUNNING (
+    const String& source,
+    uint64_t id
+  ) {
+    return JSON::Object::Entries {
+      {"source", source},
+      {"err", JSON::Object::Entries {
+        {"id", std::to_string(id)},
+        {"type", "NotFoundError"},
+        {"code", "ERR_SOCKET_NOT_RUNNING"},
+        {"message", "Not running"}
+      }}
+    };
+  }
+
+  static JSON::Object::Entries ERR_SOCKET_UV (
+    const String& source,
+    uint64_t id,
+    int err
+  ) {
+    return JSON::Object::Entries {
+      {"source", source},
+      {"err", JSON::Object::Entries {
+        {"id", std::to_string(id)},
+        {"code", String(uv_err_name(err))},
+        {"message", String(uv_strerror(err))}
+      }}
+    };
+  }
+
+  /**
+   * Returns the running TCP peer for `peerId` or `nullptr` after calling
+   * `cb` with an error for a missing, closing or closed peer.
+   */
+  static Peer* getRunningPeer (
+    Core *core,
+    const String& source,
+    const String& seq,
+    uint64_t peerId,
+    const Core::Module::Callback& cb
+  ) {
+    if (!core->hasPeer(peerId)) {
+      cb(seq, ERR_SOCKET_NOT_RUNNING(source, peerId), Post{});
+      return nullptr;
+    }
+
+    auto peer = core->getPeer(peerId);
+
+    if (!peer->isTCP()) {
+      cb(seq, ERR_SOCKET_NOT_RUNNING(source, peerId), Post{});
+      return nullptr;
+    }
+
+    if (peer->isClosed()) {
+      cb(seq, ERR_SOCKET_CLOSED(source, peerId), Post{});
+      return nullptr;
+    }
+
+    if (peer->isClosing()) {
+      cb(seq, ERR_SOCKET_CLOSING(source, peerId), Post{});
+      return nullptr;
+    }
+
+    return peer;
+  }
+
+  void Core::TCP::listen (
+    const String seq,
+    uint64_t peerId,
+    TCP::ListenOptions options,
+    Module::Callback cb
+  ) {
+    this->core->dispatchEventLoop([=, this]() {
+      if (this->core->hasPeer(peerId)) {
+        auto peer = this->core->getPeer(peerId);
+        if (!peer->isTCP() || peer->isBound()) {
+          auto json = JSON::Object::Entries {
+            {"source", "tcp.listen"},
+            {"err", JSON::Object::Entries {
+              {"id", std::to_string(peerId)},
+              {"type", "InternalError"},
+              {"code", "ERR_SERVER_ALREADY_LISTEN"},
+              {"message", "Server is already listening"}
+            }}
+          };
+
+          return cb(seq, json, Post{});
+        }
+      }
+
+      auto peer = this->core->createPeer(PEER_TYPE_TCP, peerId);
+      auto err = peer->listen(
+        options.address,
+        options.port,
+        options.backlog,
+        options.ipv6Only,
+        [=](auto status, auto client) {
+          if (status < 0) {
+            return cb("-1", ERR_SOCKET_UV("tcp.listen", peerId, status), Post{});
+          }
+
+          auto remote = client->getRemotePeerInfo();
+          auto json = JSON::Object::Entries {
+            {"source", "tcp.listen"},
+            {"data", JSON::Object::Entries {
+              {"id", std::to_string(peerId)},
+              {"event", "connection"},
+              {"connection", std::to_string(client->id)},
+              {"address", remote->address},
+              {"family", remote->family},
+              {"port", (int) remote->port}
+            }}
+          };
+
+          cb("-1", json, Post{});
+        }
+      );
+
+      if (err < 0) {
+        this->core->removePeer(peerId, true);
+        return cb(seq, ERR_SOCKET_UV("tcp.listen", peerId, err), Post{});
+      }
+
+      auto info = peer->getLocalPeerInfo();
+      auto json = JSON::Object::Entries {
+        {"source", "tcp.listen"},
+        {"data", JSON::Object::Entries {
+          {"id", std::to_string(peerId)},
+          {"event", "listening"},
+          {"address", info->address},
+          {"family", info->family},
+          {"port", (int) info->port}
+        }}
+      };
+
+      cb(seq, json, Post{});
+    });
+  }
+
+  void Core::TCP::connect (
+    const String seq,
+    uint64_t peerId,
+    TCP::ConnectOptions options,
+    Module::Callback cb
+  ) {
+    this->core->dispatchEventLoop([=, this]() {
+      if (this->core->hasPeer(peerId)) {
+        auto peer = this->core->getPeer(peerId);
+        if (!peer->isTCP() || peer->isConnected()) {
+          auto json = JSON::Object::Entries {
+            {"source", "tcp.connect"},
+            {"err", JSON::Object::Entries {
+              {"id", std::to_string(peerId)},
+              {"type", "InternalError"},
+              {"code", "ERR_SOCKET_CONNECTED"},
+              {"message", "Already connected"}
+            }}
+          };
+
+          return cb(seq, json, Post{});
+        }
+      }
+
+      auto peer = this->core->createPeer(PEER_TYPE_TCP, peerId);
+      peer->connect(options.address, options.port, [=](auto status) {
+        if (status < 0) {
+          return cb(seq, ERR_SOCKET_UV("tcp.connect", peerId, status), Post{});
+        }
+
+        auto local = peer->getLocalPeerInfo();
+        auto remote = peer->getRemotePeerInfo();
+        auto json = JSON::Object::Entries {
+          {"source", "tcp.connect"},
+          {"data", JSON::Object::Entries {
+            {"id", std::to_string(peerId)},
+            {"address", remote->address},
+            {"family", remote->family},
+            {"port", (int) remote->port},
+            {"localAddress", local->address},
+            {"localPort", (int) local->port}
+          }}
+        };
+
+        cb(seq, json, Post{});
+      });
+    });
+  }
+
+  void Core::TCP::write (
+    const String seq,
+    uint64_t peerId,
+    TCP::WriteOptions options,
+    Module::Callback cb
+  ) {
+    this->core->dispatchEventLoop([=, this]() {
+      auto peer = getRunningPeer(this->core, "tcp.write", seq, peerId, cb);
+
+      if (peer == nullptr) {
+        return;
+      }
+
+      peer->write(options.bytes, options.size, [=](auto status) {
+        if (status < 0) {
+          return cb(seq, ERR_SOCKET_UV("tcp.write", peerId, status), Post{});
+        }
+
+        auto stream = (uv_stream_t *) &peer->handle;
+        auto json = JSON::Object::Entries {
+          {"source", "tcp.write"},
+          {"data", JSON::Object::Entries {
+            {"id", std::to_string(peerId)},
+            {"bytes", (int) options.size},
+            {"queueSize", (int) uv_stream_get_write_queue_size(stream)}
+          }}
+        };
+
+        cb(seq, json, Post{});
+      });
+    });
+  }
+
+  void Core::TCP::readStart (
+    const String seq,
+    uint64_t peerId,
+    Module::Callback cb
+  ) {
+    this->core->dispatchEventLoop([=, this]() {
+      auto peer = getRunningPeer(this->core, "tcp.readStart", seq, peerId, cb);
+
+      if (peer == nullptr) {
+        return;
+      }
+
+      auto err = peer->readstart([=](auto nread, auto bytes) {
+        if (nread == UV_EOF) {
+          auto json = JSON::Object::Entries {
+            {"source", "tcp.readStart"},
+            {"data", JSON::Object::Entries {
+              {"id", std::to_string(peerId)},
+              {"EOF", true}
+            }}
+          };
+
+          cb("-1", json, Post{});
+        } else if (nread < 0) {
+          cb("-1", ERR_SOCKET_UV("tcp.readStart", peerId, (int) nread), Post{});
+        } else if (nread > 0) {
+          Post post;
+          auto headers = Headers {{
+            {"content-type" ,"application/octet-stream"},
+            {"content-length", (int) nread}
+          }};
+
+          // `bytes` was allocated for the read and is owned by the post
+          post.id = rand64();
+          post.body = bytes;
+          post.length = (int) nread;
+          post.headers = std::move(headers);
+
+          auto json = JSON::Object::Entries {
+            {"source", "tcp.readStart"},
+            {"data", JSON::Object::Entries {
+              {"id", std::to_string(peerId)},
+              {"bytes", std::to_string(post.length)}
+            }}
+          };
+
+          cb("-1", json, post);
+        }
+      });
+
+      if (err < 0 && err != UV_EALREADY) {
+        return cb(seq, ERR_SOCKET_UV("tcp.readStart", peerId, err), Post{});
+      }
+
+      auto json = JSON::Object::Entries {
+        {"source", "tcp.readStart"},
+        {"data", JSON::Object::Entries {
+          {"id", std::to_string(peerId)}
+        }}
+      };
+
+      cb(seq, json, Post{});
+    });
+  }
+
+  void Core::TCP::readStop (
+    const String seq,
+    uint64_t peerId,
+    Module::Callback cb
+  ) {
+    this->core->dispatchEventLoop([=, this]() {
+      auto peer = getRunningPeer(this->core, "tcp.readStop", seq, peerId, cb);
+
+      if (peer == nullptr) {
+        return;
+      }
+
+      auto err = peer->readstop();
+
+      if (err < 0) {
+        return cb(seq, ERR_SOCKET_UV("tcp.readStop", peerId, err), Post{});
+      }
+
+      auto json = JSON::Object::Entries {
+        {"source", "tcp.readStop"},
+        {"data", JSON::Object::Entries {
+          {"id", std::to_string(peerId)}
+        }}
+      };
+
+      cb(seq, json, Post{});
+    });
+  }
+
+  void Core::TCP::setOptions (
+    const String seq,
+    uint64_t peerId,
+    TCP::SocketOptions options,
+    Module::Callback cb
+  ) {
+    this->core->dispatchEventLoop([=, this]() {
+      auto peer = getRunningPeer(this->core, "tcp.setOptions", seq, peerId, cb);
+
+      if (peer == nullptr) {
+        return;
+      }
+
+      auto handle = (uv_tcp_t *) &peer->handle;
+      int err = 0;
+
+      if (err == 0 && options.noDelay >= 0) {
+        err = uv_tcp_nodelay(handle, options.noDelay > 0);
+      }
+
+      if (err == 0 && options.keepAlive >= 0) {
+        auto delay = options.keepAliveDelay > 0 ? options.keepAliveDelay : TCP_KEEPALIVE_DELAY;
+        err = uv_tcp_keepalive(handle, options.keepAlive > 0, delay);
+      }
+
+      if (err < 0) {
+        return cb(seq, ERR_SOCKET_UV("tcp.setOptions", peerId, err), Post{});
+      }
+
+      auto json = JSON::Object::Entries {
+        {"source", "tcp.setOptions"},
+        {"data", JSON::Object::Entries {
+          {"id", std::to_string(peerId)}
+        }}
+      };
+
+      cb(seq, json, Post{});
+    });
+  }
+
+  void Core::TCP::shutdown (
+    const String seq,
+    uint64_t peerId,
+    Module::Callback cb
+  ) {
+    this->core->dispatchEventLoop([=, this]() {
+      auto peer = getRunningPeer(this->core, "tcp.shutdown", seq, peerId, cb);
+
+      if (peer == nullptr) {
+        return;
+      }
+
+      peer->shutdown([=](auto status) {
+        if (status < 0) {
+          return cb(seq, ERR_SOCKET_UV("tcp.shutdown", peerId, status), Post{});
+        }
+
+        auto json = JSON::Object::Entries {
+          {"source", "tcp.shutdown"},
+          {"data", JSON::Object::Entries {
+            {"id", std::to_string(peerId)}
+          }}
+        };
+
+        cb(seq, json, Post{});
+      });
+    });
+  }
+
+  void Core::TCP::close (
+    const String seq,
+    uint64_t peerId,
+    Module::Callback cb
+  ) {
+    this->core->dispatchEventLoop([=, this]() {
+      auto peer = getRunningPeer(this->core, "tcp.close", seq, peerId, cb);
+
+      if (peer == nullptr) {
+        return;
+      }
+
+      peer->close([=]() {
+        auto json = JSON::Object::Entries {
+          {"source", "tcp.close"},
+          {"data", JSON::Object::Entries {
+            {"id", std::to_string(peerId)}
+          }}
+        };
+
+        cb(seq, json, Post{});
+      });
+    });
+  }
+}
@@ -10,7 +10,9 @@
 #include <queue>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #if defined(__APPLE__)
@@ -23,6 +25,7 @@ namespace SSC {
   using AtomicBool = std::atomic<bool>;
   using String = std::string;
   using StringStream = std::stringstream;
+  using StringView = std::string_view;
   using WString = std::wstring;
   using WStringStream = std::wstringstream;
   using Map = std::map<String, String>;
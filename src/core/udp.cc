@@ -91,6 +91,73 @@ namespace SSC {
     };
   }
 
+  static JSON::Object::Entries ERR_SOCKET_DGRAM_WOULD_BLOCK (
+    const String& source,
+    uint64_t id
+  ) {
+    return JSON::Object::Entries {
+      {"source", source},
+      {"err", JSON::Object::Entries {
+        {"id", std::to_string(id)},
+        {"type", "InternalError"},
+        {"code", "ERR_SOCKET_DGRAM_WOULD_BLOCK"},
+        {"message", "Send queue is above its high-water mark"}
+      }}
+    };
+  }
+
+  static JSON::Object::Entries ERR_SOCKET_DGRAM_OPTION (
+    const String& source,
+    uint64_t id,
+    const String& option,
+    int err
+  ) {
+    return JSON::Object::Entries {
+      {"source", source},
+      {"err", JSON::Object::Entries {
+        {"id", std::to_string(id)},
+        {"option", option},
+        {"code", String(uv_err_name(err))},
+        {"message", option + ": " + String(uv_strerror(err))}
+      }}
+    };
+  }
+
+  /**
+   * Emits a "drain" event for a peer that refused a send once its send
+   * queue has fallen to half of the high-water mark.
+   */
+  static void emitDrainIfNeeded (
+    Peer *peer,
+    uint64_t peerId,
+    const Core::Module::Callback& cb
+  ) {
+    auto handle = (uv_udp_t *) &peer->handle;
+    auto queueSize = uv_udp_get_send_queue_size(handle);
+
+    if (!peer->hasState(PEER_STATE_UDP_SEND_BLOCKED)) {
+      return;
+    }
+
+    if (queueSize > peer->options.udp.sendHighWaterMark / 2) {
+      return;
+    }
+
+    peer->removeState(PEER_STATE_UDP_SEND_BLOCKED);
+
+    auto json = JSON::Object::Entries {
+      {"source", "udp.send"},
+      {"data", JSON::Object::Entries {
+        {"id", std::to_string(peerId)},
+        {"event", "drain"},
+        {"queueSize", (int) queueSize},
+        {"queueCount", (int) uv_udp_get_send_queue_count(handle)}
+      }}
+    };
+
+    cb("-1", json, Post{});
+  }
+
   void Core::UDP::bind (
     const String seq,
     uint64_t peerId,
@@ -106,7 +173,12 @@ namespace SSC {
       }
 
       auto peer = this->core->createPeer(PEER_TYPE_UDP, peerId);
-      auto err = peer->bind(options.address, options.port, options.reuseAddr);
+      auto err = peer->bind(
+        options.address,
+        options.port,
+        options.reuseAddr,
+        options.ipv6Only
+      );
 
       if (err < 0) {
         auto json = JSON::Object::Entries {
@@ -327,6 +399,7 @@ namespace SSC {
       return cb(seq, json, Post{});
     }
 
+    auto handle = (uv_udp_t *) &peer->handle;
     auto json = JSON::Object::Entries {
       {"source", "udp.getState"},
       {"data", JSON::Object::Entries {
@@ -337,7 +410,11 @@ namespace SSC {
         {"closed", peer->isClosed()},
         {"closing", peer->isClosing()},
         {"connected", peer->isConnected()},
-        {"ephemeral", peer->isEphemeral()}
+        {"ephemeral", peer->isEphemeral()},
+        {"sendQueueSize", (int) uv_udp_get_send_queue_size(handle)},
+        {"sendQueueCount", (int) uv_udp_get_send_queue_count(handle)},
+        {"sendHighWaterMark", (int) peer->options.udp.sendHighWaterMark},
+        {"sendBlocked", peer->hasState(PEER_STATE_UDP_SEND_BLOCKED)}
       }}
     };
 
@@ -352,11 +429,27 @@ namespace SSC {
   ) {
     this->core->dispatchEventLoop([=, this] {
       auto peer = this->core->createPeer(PEER_TYPE_UDP, peerId, options.ephemeral);
+      auto handle = (uv_udp_t *) &peer->handle;
       auto size = options.size; // @TODO(jwerle): validate MTU
       auto port = options.port;
       auto bytes = options.bytes;
       auto address = options.address;
-      peer->send(bytes, size, port, address, [=](auto status, auto post) {
+      auto segmentSize = options.segmentSize;
+
+      if (options.highWaterMark > 0) {
+        peer->options.udp.sendHighWaterMark = options.highWaterMark;
+      }
+
+      // with a high-water mark, sends are refused instead of queued until "drain"
+      if (
+        peer->options.udp.sendHighWaterMark > 0 &&
+        uv_udp_get_send_queue_size(handle) >= peer->options.udp.sendHighWaterMark
+      ) {
+        peer->addState(PEER_STATE_UDP_SEND_BLOCKED);
+        return cb(seq, ERR_SOCKET_DGRAM_WOULD_BLOCK("udp.send", peerId), Post{});
+      }
+
+      peer->send(bytes, size, port, address, segmentSize, [=](auto status, auto post) {
         if (status < 0) {
           auto json = JSON::Object::Entries {
             {"source", "udp.send"},
@@ -366,23 +459,259 @@ namespace SSC {
             }}
           };
 
-          return cb(seq, json, Post{});
+          cb(seq, json, Post{});
+          return emitDrainIfNeeded(peer, peerId, cb);
         }
 
         auto json = JSON::Object::Entries {
           {"source", "udp.send"},
           {"data", JSON::Object::Entries {
             {"id", std::to_string(peerId)},
-            {"status", status}
+            {"status", status},
+            {"queueSize", (int) uv_udp_get_send_queue_size(handle)},
+            {"queueCount", (int) uv_udp_get_send_queue_count(handle)}
           }}
         };
 
         cb(seq, json, Post{});
+        emitDrainIfNeeded(peer, peerId, cb);
       });
     });
   }
 
+  void Core::UDP::sendMany (
+    String seq,
+    uint64_t peerId,
+    UDP::SendManyOptions options,
+    Module::Callback cb
+  ) {
+    this->core->dispatchEventLoop([=, this] {
+      auto peer = this->core->createPeer(PEER_TYPE_UDP, peerId, options.ephemeral);
+      peer->sendMany(options.datagrams, [=](auto err, auto sent, auto failed) {
+        if (sent == 0 && failed > 0) {
+          auto json = JSON::Object::Entries {
+            {"source", "udp.sendMany"},
+            {"err", JSON::Object::Entries {
+              {"id", std::to_string(peerId)},
+              {"message", String(uv_strerror(err))}
+            }}
+          };
+
+          cb(seq, json, Post{});
+          return emitDrainIfNeeded(peer, peerId, cb);
+        }
+
+        auto json = JSON::Object::Entries {
+          {"source", "udp.sendMany"},
+          {"data", JSON::Object::Entries {
+            {"id", std::to_string(peerId)},
+            {"sent", (int) sent},
+            {"failed", (int) failed}
+          }}
+        };
+
+        cb(seq, json, Post{});
+        emitDrainIfNeeded(peer, peerId, cb);
+      });
+    });
+  }
+
+  /**
+   * Frames a batch of received datagrams into a single binary post. Each
+   * datagram is written as a big endian `uint16` port, a `uint8` address
+   * length, the address string, a big endian `uint32` size and the payload.
+   */
+  static Post getDatagramBatchPost (const Vector<Peer::UDPDatagram>& datagrams) {
+    Vector<String> addresses;
+    Vector<int> ports;
+    size_t length = 0;
+    size_t offset = 0;
+    Post post;
+
+    addresses.reserve(datagrams.size());
+    ports.reserve(datagrams.size());
+
+    for (const auto& datagram : datagrams) {
+      if (datagram.addr.ss_family == AF_INET6) {
+        auto sin6 = (struct sockaddr_in6 *) &datagram.addr;
+        addresses.push_back(addrToIPv6(sin6));
+        ports.push_back((int) ntohs(sin6->sin6_port));
+      } else {
+        auto sin = (struct sockaddr_in *) &datagram.addr;
+        addresses.push_back(addrToIPv4(sin));
+        ports.push_back((int) ntohs(sin->sin_port));
+      }
+
+      length += 2 + 1 + addresses.back().size() + 4 + datagram.size;
+    }
+
+    auto body = new char[length]{0};
+
+    for (size_t i = 0; i < datagrams.size(); ++i) {
+      const auto& datagram = datagrams[i];
+      const auto& address = addresses[i];
+      const auto port = ports[i];
+      const auto size = (uint32_t) datagram.size;
+
+      body[offset++] = (char) ((port >> 8) & 0xFF);
+      body[offset++] = (char) (port & 0xFF);
+      body[offset++] = (char) address.size();
+      memcpy(body + offset, address.data(), address.size());
+      offset += address.size();
+      body[offset++] = (char) ((size >> 24) & 0xFF);
+      body[offset++] = (char) ((size >> 16) & 0xFF);
+      body[offset++] = (char) ((size >> 8) & 0xFF);
+      body[offset++] = (char) (size & 0xFF);
+
+      if (size > 0) {
+        memcpy(body + offset, datagram.bytes, size);
+        offset += size;
+      }
+    }
+
+    auto headers = Headers {{
+      {"content-type" ,"application/octet-stream"},
+      {"content-length", (int) length}
+    }};
+
+    post.id = rand64();
+    post.body = body;
+    post.length = (int) length;
+    post.headers = std::move(headers);
+
+    return post;
+  }
+
+  void Core::UDP::setOptions (
+    const String seq,
+    uint64_t peerId,
+    UDP::SocketOptions options,
+    Module::Callback cb
+  ) {
+    this->core->dispatchEventLoop([=, this]() {
+      if (!this->core->hasPeer(peerId)) {
+        auto json = ERR_SOCKET_DGRAM_NOT_RUNNING("udp.setOptions", peerId);
+        return cb(seq, json, Post{});
+      }
+
+      auto peer = this->core->getPeer(peerId);
+
+      if (!peer->isUDP()) {
+        auto json = ERR_SOCKET_DGRAM_NOT_RUNNING("udp.setOptions", peerId);
+        return cb(seq, json, Post{});
+      }
+
+      if (peer->isClosed()) {
+        auto json = ERR_SOCKET_DGRAM_CLOSED("udp.setOptions", peerId);
+        return cb(seq, json, Post{});
+      }
+
+      if (peer->isClosing()) {
+        auto json = ERR_SOCKET_DGRAM_CLOSING("udp.setOptions", peerId);
+        return cb(seq, json, Post{});
+      }
+
+      auto handle = (uv_handle_t *) &peer->handle;
+      auto sendBufferSize = options.sendBufferSize;
+      auto recvBufferSize = options.recvBufferSize;
+      const auto& membership = options.membership;
+      String option;
+      int err = 0;
+
+      // options are applied in order until one fails
+      if (err == 0 && options.broadcast >= 0) {
+        option = "broadcast";
+        err = peer->setBroadcast(options.broadcast > 0);
+      }
+
+      if (err == 0 && options.ttl >= 0) {
+        option = "ttl";
+        err = peer->setTTL(options.ttl);
+      }
+
+      if (err == 0 && options.multicastTTL >= 0) {
+        option = "multicastTTL";
+        err = peer->setMulticastTTL(options.multicastTTL);
+      }
+
+      if (err == 0 && options.multicastLoopback >= 0) {
+        option = "multicastLoopback";
+        err = peer->setMulticastLoopback(options.multicastLoopback > 0);
+      }
+
+      if (err == 0 && options.multicastInterface.size() > 0) {
+        option = "multicastInterface";
+        err = peer->setMulticastInterface(options.multicastInterface);
+      }
+
+      if (err == 0 && membership.multicastAddress.size() > 0) {
+        option = "membership";
+
+        if (membership.sourceAddress.size() > 0) {
+          err = peer->setSourceMembership(
+            membership.multicastAddress,
+            membership.interfaceAddress,
+            membership.sourceAddress,
+            membership.join
+          );
+        } else {
+          err = peer->setMembership(
+            membership.multicastAddress,
+            membership.interfaceAddress,
+            membership.join
+          );
+        }
+      }
+
+      if (err == 0 && options.dscp >= 0) {
+        option = "dscp";
+        err = peer->setDSCP(options.dscp);
+      }
+
+      if (err == 0 && sendBufferSize > 0) {
+        option = "sendBufferSize";
+        err = uv_send_buffer_size(handle, &sendBufferSize);
+      }
+
+      if (err == 0 && recvBufferSize > 0) {
+        option = "recvBufferSize";
+        err = uv_recv_buffer_size(handle, &recvBufferSize);
+      }
+
+      if (err < 0) {
+        auto json = ERR_SOCKET_DGRAM_OPTION("udp.setOptions", peerId, option, err);
+        return cb(seq, json, Post{});
+      }
+
+      // a size of 0 reads the buffer size, which the kernel may have adjusted
+      sendBufferSize = 0;
+      recvBufferSize = 0;
+      uv_send_buffer_size(handle, &sendBufferSize);
+      uv_recv_buffer_size(handle, &recvBufferSize);
+
+      auto json = JSON::Object::Entries {
+        {"source", "udp.setOptions"},
+        {"data", JSON::Object::Entries {
+          {"id", std::to_string(peerId)},
+          {"sendBufferSize", sendBufferSize},
+          {"recvBufferSize", recvBufferSize}
+        }}
+      };
+
+      cb(seq, json, Post{});
+    });
+  }
+
   void Core::UDP::readStart (String seq, uint64_t peerId, Module::Callback cb) {
+    return this->readStart(seq, peerId, UDP::ReadStartOptions {}, cb);
+  }
+
+  void Core::UDP::readStart (
+    String seq,
+    uint64_t peerId,
+    UDP::ReadStartOptions options,
+    Module::Callback cb
+  ) {
     if (!this->core->hasPeer(peerId)) {
       auto json = ERR_SOCKET_DGRAM_NOT_RUNNING("udp.readStart", peerId);
       return cb(seq, json, Post{});
@@ -423,8 +752,10 @@ namespace SSC {
       return cb(seq, json, Post{});
     }
 
-    auto err = peer->recvstart([=](auto nread, auto buf, auto addr) {
-      if (nread == UV_EOF) {
+    peer->options.udp.gro = options.gro;
+
+    auto err = peer->recvstart([=](auto status, const auto& datagrams) {
+      if (status == UV_EOF) {
         auto json = JSON::Object::Entries {
           {"source", "udp.readStart"},
           {"data", JSON::Object::Entries {
@@ -434,30 +765,14 @@ namespace SSC {
         };
 
         cb("-1", json, Post{});
-      } else if (nread > 0) {
-        char address[17] = {0};
-        Post post;
-        int port;
-
-        parseAddress((struct sockaddr *) addr, &port, address);
-
-        auto headers = Headers {{
-          {"content-type" ,"application/octet-stream"},
-          {"content-length", nread}
-        }};
-
-        post.id = rand64();
-        post.body = buf->base;
-        post.length = (int) nread;
-        post.headers = headers.str();
-
+      } else if (status > 0) {
+        auto post = getDatagramBatchPost(datagrams);
         auto json = JSON::Object::Entries {
           {"source", "udp.readStart"},
           {"data", JSON::Object::Entries {
             {"id", std::to_string(peerId)},
-            {"port", port},
-            {"bytes", std::to_string(post.length)},
-            {"address", address}
+            {"count", (int) datagrams.size()},
+            {"bytes", std::to_string(post.length)}
           }}
         };
 
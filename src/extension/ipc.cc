@@ -236,7 +236,7 @@ bool sapi_ipc_send_bytes (
     .ttl = 0,
     .body = new char[size]{0},
     .length = size,
-    .headers = headers ? headers : ""
+    .headers = headers ? SSC::Headers(SSC::String(headers)) : SSC::Headers()
   };
 
   memcpy(post.body, bytes, size);
@@ -272,7 +272,7 @@ bool sapi_ipc_send_bytes_with_result (
     .ttl = 0,
     .body = new char[size]{0},
     .length = size,
-    .headers =headers ? headers : ""
+    .headers = headers ? SSC::Headers(SSC::String(headers)) : SSC::Headers()
   };
 
   memcpy(post.body, bytes, size);
@@ -390,7 +390,7 @@ bool sapi_ipc_invoke (
     uri = "ipc://" + uri;
   }
 
-  return ctx->router->invoke(uri, bytes, size, [ctx, callback](auto result) {
+  return ctx->router->invoke(uri, bytes, size, [ctx, callback](const auto& result) {
     callback(
       reinterpret_cast<const sapi_ipc_result_t*>(&result),
       reinterpret_cast<const sapi_ipc_router_t*>(&ctx->router)
@@ -449,16 +449,16 @@ const char* sapi_ipc_message_get_seq (const sapi_ipc_message_t* message) {
 }
 
 const char* sapi_ipc_message_get_uri (const sapi_ipc_message_t* message) {
-  if (message->uri.size() == 0) return nullptr;
-  return message->uri.c_str();
+  if (message->uri().size() == 0) return nullptr;
+  return message->uri().c_str();
 }
 
 const char* sapi_ipc_message_get (
   const sapi_ipc_message_t* message,
   const char* key
 ) {
-  if (!message || !key || !message->args.contains(key)) return nullptr;
-  auto& value = message->args.at(key);
+  if (!message || !key || !message->args().contains(key)) return nullptr;
+  auto& value = message->args().at(key);
   if (value.size() == 0) return nullptr;
   return value.c_str();
 }
@@ -709,7 +709,7 @@ const char* sapi_ipc_result_get_header (
   const char* name
 ) {
   if (result && result->headers.has(name)) {
-    return result->headers.get(name).value.string.c_str();
+    return result->headers.get(name).value.c_str();
   }
 
   return nullptr;
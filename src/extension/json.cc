@@ -51,6 +51,94 @@ sapi_json_any_t* sapi_json_raw_from (
   );
 }
 
+// copies `value` into memory owned by `ctx`
+static sapi_json_any_t* sapi_json_any_from (
+  sapi_context_t* ctx,
+  const SSC::JSON::Any& value
+) {
+  if (value.isObject()) {
+    auto object = ctx->memory.alloc<sapi_json_object_t>(ctx);
+    object->data = value.as<SSC::JSON::Object>().data;
+    return reinterpret_cast<sapi_json_any_t*>(object);
+  }
+
+  if (value.isArray()) {
+    auto array = ctx->memory.alloc<sapi_json_array_t>(ctx);
+    array->data = value.as<SSC::JSON::Array>().data;
+    return reinterpret_cast<sapi_json_any_t*>(array);
+  }
+
+  if (value.isString()) {
+    auto string = ctx->memory.alloc<sapi_json_string_t>(ctx);
+    string->data = value.as<SSC::JSON::String>().data;
+    return reinterpret_cast<sapi_json_any_t*>(string);
+  }
+
+  if (value.isNumber()) {
+    auto number = ctx->memory.alloc<sapi_json_number_t>(ctx);
+    number->data = value.as<SSC::JSON::Number>().data;
+    return reinterpret_cast<sapi_json_any_t*>(number);
+  }
+
+  if (value.isBoolean()) {
+    auto boolean = ctx->memory.alloc<sapi_json_boolean_t>(ctx);
+    boolean->data = value.as<SSC::JSON::Boolean>().data;
+    return reinterpret_cast<sapi_json_any_t*>(boolean);
+  }
+
+  if (value.isRaw()) {
+    return sapi_json_raw_from(ctx, value.as<SSC::JSON::Raw>().data.c_str());
+  }
+
+  return reinterpret_cast<sapi_json_any_t*>(
+    ctx->memory.alloc<sapi_json_null_t>(ctx)
+  );
+}
+
+sapi_json_any_t* sapi_json_parse (
+  sapi_context_t* ctx,
+  const char* source
+) {
+  if (source == nullptr) return nullptr;
+
+  SSC::JSON::Any value;
+
+  try {
+    value = SSC::JSON::parse(source, strlen(source));
+  } catch (const SSC::JSON::Error& error) {
+    sapi_context_error_set_name(ctx, error.name.c_str());
+    sapi_context_error_set_message(ctx, error.message.c_str());
+    return nullptr;
+  }
+
+  return sapi_json_any_from(ctx, value);
+}
+
+// the context of `json`, which is not at the same offset for every type
+static sapi_context_t* sapi_json_context (const sapi_json_any_t* json) {
+  switch (sapi_json_typeof(json)) {
+    case SAPI_JSON_TYPE_NULL:
+      return reinterpret_cast<const sapi_json_null_t*>(json)->context;
+    case SAPI_JSON_TYPE_OBJECT:
+      return reinterpret_cast<const sapi_json_object_t*>(json)->context;
+    case SAPI_JSON_TYPE_ARRAY:
+      return reinterpret_cast<const sapi_json_array_t*>(json)->context;
+    case SAPI_JSON_TYPE_BOOLEAN:
+      return reinterpret_cast<const sapi_json_boolean_t*>(json)->context;
+    case SAPI_JSON_TYPE_NUMBER:
+      return reinterpret_cast<const sapi_json_number_t*>(json)->context;
+    case SAPI_JSON_TYPE_STRING:
+      return reinterpret_cast<const sapi_json_string_t*>(json)->context;
+    case SAPI_JSON_TYPE_RAW:
+      return reinterpret_cast<const sapi_json_raw_t*>(json)->context;
+    case SAPI_JSON_TYPE_EMPTY:
+    case SAPI_JSON_TYPE_ANY:
+      break;
+  }
+
+  return json->context;
+}
+
 const char * sapi_json_stringify_value (const sapi_json_any_t* json) {
   SSC::String string;
   switch (sapi_json_typeof(json)) {
@@ -86,7 +174,7 @@ const char * sapi_json_stringify_value (const sapi_json_any_t* json) {
   size_t length = string.size();
 
   if (length > 0) {
-    auto bytes = json->context->memory.alloc<char>(length + 1);
+    auto bytes = sapi_json_context(json)->memory.alloc<char>(length + 1);
     if (bytes != nullptr) {
     #if defined(_WIN32)
       strncat_s(bytes, length + 1, string.c_str(), length);
@@ -137,9 +225,10 @@ sapi_json_any_t* sapi_json_object_get (
   const sapi_json_object_t* json,
   const char* key
 ) {
+  // values are stored inline in `json` and move when it changes, so the
+  // caller gets a copy owned by the context
   if (json->has(key)) {
-    auto pointer = json->data.at(key).pointer.get();
-    return reinterpret_cast<sapi_json_any_t*>(pointer);
+    return sapi_json_any_from(json->context, json->data.at(key));
   }
 
   return nullptr;
@@ -212,9 +301,9 @@ sapi_json_any_t* sapi_json_array_get (
   const sapi_json_array_t* json,
   unsigned int index
 ) {
+  // see `sapi_json_object_get()`
   if (json->has(index)) {
-    auto pointer = json->data.at(index).pointer.get();
-    return reinterpret_cast<sapi_json_any_t*>(pointer);
+    return sapi_json_any_from(json->context, json->data.at(index));
   }
 
   return nullptr;
@@ -223,6 +312,5 @@ sapi_json_any_t* sapi_json_array_get (
 sapi_json_any_t* sapi_json_array_pop (
   sapi_json_array_t* json
 ) {
-  auto pointer = json->pop().pointer.get();
-  return reinterpret_cast<sapi_json_any_t*>(pointer);
+  return sapi_json_any_from(json->context, json->pop());
 }
@@ -77,11 +77,6 @@ static String getcwd () {
   GetModuleFileNameW(NULL, filename, MAX_PATH);
   auto path = fs::path { filename }.remove_filename();
   cwd = path.string();
-  size_t last_pos = 0;
-  while ((last_pos = cwd.find('\\', last_pos)) != std::string::npos) {
-    cwd.replace(last_pos, 1, "\\\\");
-    last_pos += 2;
-  }
 #endif
 
 #ifndef _WIN32
@@ -253,9 +248,23 @@ static void initRouterTable (Router *router) {
   });
 
   /**
-   * Look up an IP address by `hostname`.
+   * Queries runtime diagnostics, like DNS lookup cache statistics.
+   */
+  router->map("diagnostics.query", [](auto message, auto router, auto reply) {
+    router->core->diagnostics.query(
+      message.seq,
+      RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+    );
+  });
+
+  /**
+   * Look up an IP address by `hostname`. Results are cached for a short
+   * time and identical lookups in flight share one request.
    * @param hostname Host name to lookup
    * @param family IP address family to resolve [default = 0 (AF_UNSPEC)]
+   * @param hints `getaddrinfo(3)` flags, like `AI_ADDRCONFIG` [default = 0]
+   * @param all Reply with every address instead of the first one [default = false]
+   * @param verbatim Keep the resolver's order instead of IPv4 first [default = true]
    * @see getaddrinfo(3)
    */
   router->map("dns.lookup", [](auto message, auto router, auto reply) {
@@ -265,12 +274,18 @@ static void initRouterTable (Router *router) {
       return reply(Result::Err { message, err });
     }
 
-    int family = 0;
-    REQUIRE_AND_GET_MESSAGE_VALUE(family, "family", std::stoi, "0");
+    Core::DNS::LookupOptions options;
+    options.hostname = message.get("hostname");
+
+    REQUIRE_AND_GET_MESSAGE_VALUE(options.family, "family", std::stoi, "0");
+    REQUIRE_AND_GET_MESSAGE_VALUE(options.hints, "hints", std::stoi, "0");
+
+    options.all = message.get("all") == "true";
+    options.verbatim = message.get("verbatim") != "false";
 
     router->core->dns.lookup(
       message.seq,
-      Core::DNS::LookupOptions { message.get("hostname"), family },
+      options,
       RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
     );
   });
@@ -744,6 +759,7 @@ static void initRouterTable (Router *router) {
   /**
    * Computes stats for an open file descriptor.
    * @param id
+   * @param binary If `true`, stats are a packed binary stat record
    * @see stat(2)
    * @see fstat(2)
    */
@@ -757,11 +773,20 @@ static void initRouterTable (Router *router) {
     uint64_t id;
     REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
 
-    router->core->fs.fstat(message.seq, id, RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply));
+    Core::FS::StatOptions options;
+    options.binary = message.get("binary") == "true";
+
+    router->core->fs.fstat(
+      message.seq,
+      id,
+      options,
+      RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+    );
   });
 
   /**
-   * Synchronize a file's in-core state with storage device
+   * Synchronize a file's in-core state with storage device. Concurrent
+   * calls for the same descriptor are resolved by a single fsync.
    * @param id
    * @see fsync(2)
    */
@@ -822,6 +847,7 @@ static void initRouterTable (Router *router) {
   /**
    * Computes stats for a symbolic link at `path`.
    * @param path
+   * @param binary If `true`, stats are a packed binary stat record
    * @see stat(2)
    * @see lstat(2)
    */
@@ -832,9 +858,13 @@ static void initRouterTable (Router *router) {
       return reply(Result::Err { message, err });
     }
 
+    Core::FS::StatOptions options;
+    options.binary = message.get("binary") == "true";
+
     router->core->fs.lstat(
       message.seq,
       message.get("path"),
+      options,
       RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
     );
   });
@@ -872,6 +902,8 @@ static void initRouterTable (Router *router) {
    * @param path
    * @param flags
    * @param mode
+   * @param writeBehind If `true`, writes are answered once buffered and
+   * adjacent ones are coalesced
    * @see open(2)
    */
   router->map("fs.open", [](auto message, auto router, auto reply) {
@@ -893,12 +925,16 @@ static void initRouterTable (Router *router) {
     REQUIRE_AND_GET_MESSAGE_VALUE(mode, "mode", std::stoi);
     REQUIRE_AND_GET_MESSAGE_VALUE(flags, "flags", std::stoi);
 
+    Core::FS::OpenOptions options;
+    options.writeBehind = message.get("writeBehind") == "true";
+
     router->core->fs.open(
       message.seq,
       id,
       message.get("path"),
       flags,
       mode,
+      options,
       RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
     );
   });
@@ -929,9 +965,12 @@ static void initRouterTable (Router *router) {
 
   /**
    * Reads `size` bytes at `offset` from the underlying file descriptor.
+   * Sequential reads are detected and served from chunks read ahead.
    * @param id
    * @param size
    * @param offset
+   * @param readAhead Chunks to read ahead of sequential reads, `0` (the
+   * default) disables, at most `Core::FS::MAX_READ_AHEAD_WINDOW`
    * @see read(2)
    */
   router->map("fs.read", [](auto message, auto router, auto reply) {
@@ -948,11 +987,61 @@ static void initRouterTable (Router *router) {
     REQUIRE_AND_GET_MESSAGE_VALUE(size, "size", std::stoi);
     REQUIRE_AND_GET_MESSAGE_VALUE(offset, "offset", std::stoi);
 
+    int64_t readAhead = 0;
+    REQUIRE_AND_GET_MESSAGE_VALUE(
+      readAhead,
+      "readAhead",
+      std::stoll,
+      std::to_string(Core::FS::DEFAULT_READ_AHEAD_WINDOW)
+    );
+
+    if (readAhead < 0) {
+      return reply(Result::Err { message, JSON::Object::Entries {
+        {"message", "Invalid 'readAhead' given in parameters"}
+      }});
+    }
+
+    Core::FS::ReadOptions options;
+    options.readAhead = (size_t) readAhead;
+
     router->core->fs.read(
       message.seq,
       id,
       size,
       offset,
+      options,
+      RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+    );
+  });
+
+  /**
+   * Reads the entire contents of a file at `path` in a single request. The
+   * file is opened, sized with `fstat`, read and closed on the threadpool
+   * and the contents are the binary result.
+   * @param path
+   * @param flags (default: O_RDONLY)
+   * @see open(2)
+   * @see read(2)
+   */
+  router->map("fs.readFile", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"path"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result::Err { message, err });
+    }
+
+    Core::FS::ReadFileOptions options;
+    REQUIRE_AND_GET_MESSAGE_VALUE(
+      options.flags,
+      "flags",
+      std::stoi,
+      std::to_string(options.flags)
+    );
+
+    router->core->fs.readFile(
+      message.seq,
+      message.get("path"),
+      options,
       RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
     );
   });
@@ -1084,6 +1173,7 @@ static void initRouterTable (Router *router) {
   /**
    * Computes stats for a file at `path`.
    * @param path
+   * @param binary If `true`, stats are a packed binary stat record
    * @see stat(2)
    */
   router->map("fs.stat", [](auto message, auto router, auto reply) {
@@ -1093,9 +1183,45 @@ static void initRouterTable (Router *router) {
       return reply(Result::Err { message, err });
     }
 
+    Core::FS::StatOptions options;
+    options.binary = message.get("binary") == "true";
+
     router->core->fs.stat(
       message.seq,
       message.get("path"),
+      options,
+      RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+    );
+  });
+
+  /**
+   * Computes stats for many files in a single request. Paths are given as
+   * a `\0` separated list in the message buffer and the result is one
+   * packed binary stat record per path, in order. Entries that could not be
+   * stated have a negative `status` field.
+   * @see stat(2)
+   */
+  router->map("fs.statMany", [](auto message, auto router, auto reply) {
+    if (message.buffer.bytes == nullptr || message.buffer.size == 0) {
+      auto err = JSON::Object::Entries {{ "message", "Missing buffer in message" }};
+      return reply(Result::Err { message, err });
+    }
+
+    auto paths = Vector<String> {};
+    auto bytes = message.buffer.bytes;
+    auto size = message.buffer.size;
+    size_t start = 0;
+
+    for (size_t i = 0; i <= size; ++i) {
+      if (i == size || bytes[i] == '\0') {
+        paths.push_back(String(bytes + start, i - start));
+        start = i + 1;
+      }
+    }
+
+    router->core->fs.statMany(
+      message.seq,
+      paths,
       RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
     );
   });
@@ -1196,6 +1322,51 @@ static void initRouterTable (Router *router) {
     );
   });
 
+  /**
+   * Writes buffer at `message.buffer.bytes` of size `message.buffers.size`
+   * as the entire contents of a file at `path` in a single request.
+   * @param path
+   * @param flags (default: O_WRONLY | O_CREAT | O_TRUNC)
+   * @param mode (default: 0o666)
+   * @param atomic If `true`, write a temporary file and rename it to `path`
+   * @see open(2)
+   * @see write(2)
+   * @see rename(2)
+   */
+  router->map("fs.writeFile", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"path"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result::Err { message, err });
+    }
+
+    Core::FS::WriteFileOptions options;
+    REQUIRE_AND_GET_MESSAGE_VALUE(
+      options.flags,
+      "flags",
+      std::stoi,
+      std::to_string(options.flags)
+    );
+
+    REQUIRE_AND_GET_MESSAGE_VALUE(
+      options.mode,
+      "mode",
+      std::stoi,
+      std::to_string(options.mode)
+    );
+
+    options.atomic = message.get("atomic") == "true";
+
+    router->core->fs.writeFile(
+      message.seq,
+      message.get("path"),
+      message.buffer.bytes,
+      message.buffer.size,
+      options,
+      RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+    );
+  });
+
 #if defined(__APPLE__)
   router->map("geolocation.getCurrentPosition", [](auto message, auto router, auto reply) {
     if (!router->locationObserver) {
@@ -2169,6 +2340,217 @@ static void initRouterTable (Router *router) {
     reply(Result::Data { message, JSON::Object {}});
   });
 
+  /**
+   * Closes a TCP socket or server handle.
+   * @param id Handle ID of underlying socket
+   */
+  router->map("tcp.close", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"id"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result::Err { message, err });
+    }
+
+    uint64_t id;
+    REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
+
+    router->core->tcp.close(message.seq, id, RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply));
+  });
+
+  /**
+   * Connects a TCP socket to a port and address.
+   * @param id Handle ID of underlying socket
+   * @param port Port to connect the TCP socket to
+   * @param address The address to connect the TCP socket to (default: 127.0.0.1)
+   * @see connect(2)
+   */
+  router->map("tcp.connect", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"id", "port"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result::Err { message, err });
+    }
+
+    Core::TCP::ConnectOptions options;
+    uint64_t id;
+    REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
+    REQUIRE_AND_GET_MESSAGE_VALUE(options.port, "port", std::stoi);
+
+    options.address = message.get("address", "127.0.0.1");
+
+    router->core->tcp.connect(
+      message.seq,
+      id,
+      options,
+      RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+    );
+  });
+
+  /**
+   * Binds a TCP server to a port and address and listens for connections.
+   * Accepted connections are emitted as `connection` events with the handle
+   * ID of the new socket, which does not read until `tcp.readStart`.
+   * @param id Handle ID of underlying server
+   * @param port Port to listen on
+   * @param address The address to listen on (default: 0.0.0.0)
+   * @param backlog Maximum length of the pending connection queue (default: 511)
+   * @param ipv6Only Disable dual-stack support for IPv6 addresses (default: false)
+   * @see listen(2)
+   */
+  router->map("tcp.listen", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"id", "port"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result::Err { message, err });
+    }
+
+    Core::TCP::ListenOptions options;
+    uint64_t id;
+    REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
+    REQUIRE_AND_GET_MESSAGE_VALUE(options.port, "port", std::stoi);
+    REQUIRE_AND_GET_MESSAGE_VALUE(options.backlog, "backlog", std::stoi, "511");
+
+    options.address = message.get("address", "0.0.0.0");
+    options.ipv6Only = message.get("ipv6Only") == "true";
+
+    router->core->tcp.listen(
+      message.seq,
+      id,
+      options,
+      RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+    );
+  });
+
+  /**
+   * Starts reading from a connected TCP socket. Data is emitted as binary
+   * `tcp.readStart` events until `EOF` or an error.
+   * @param id Handle ID of underlying socket
+   */
+  router->map("tcp.readStart", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"id"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result::Err { message, err });
+    }
+
+    uint64_t id;
+    REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
+
+    router->core->tcp.readStart(
+      message.seq,
+      id,
+      RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+    );
+  });
+
+  /**
+   * Stops reading from a connected TCP socket.
+   * @param id Handle ID of underlying socket
+   */
+  router->map("tcp.readStop", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"id"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result::Err { message, err });
+    }
+
+    uint64_t id;
+    REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
+
+    router->core->tcp.readStop(
+      message.seq,
+      id,
+      RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+    );
+  });
+
+  /**
+   * Sets options of a connected TCP socket.
+   * @param id Handle ID of underlying socket
+   * @param noDelay Disable Nagle's algorithm (`TCP_NODELAY`)
+   * @param keepAlive Send keep-alive probes (`SO_KEEPALIVE`)
+   * @param keepAliveDelay Idle seconds before the first keep-alive probe
+   * @see tcp(7)
+   */
+  router->map("tcp.setOptions", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"id"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result::Err { message, err });
+    }
+
+    Core::TCP::SocketOptions options;
+    uint64_t id;
+    REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
+    REQUIRE_AND_GET_MESSAGE_VALUE(options.keepAliveDelay, "keepAliveDelay", std::stoul, "0");
+
+    if (message.get("noDelay").size() > 0) {
+      options.noDelay = message.get("noDelay") == "true" ? 1 : 0;
+    }
+
+    if (message.get("keepAlive").size() > 0) {
+      options.keepAlive = message.get("keepAlive") == "true" ? 1 : 0;
+    }
+
+    router->core->tcp.setOptions(
+      message.seq,
+      id,
+      options,
+      RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+    );
+  });
+
+  /**
+   * Closes the write side of a connected TCP socket after pending writes
+   * are flushed.
+   * @param id Handle ID of underlying socket
+   * @see shutdown(2)
+   */
+  router->map("tcp.shutdown", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"id"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result::Err { message, err });
+    }
+
+    uint64_t id;
+    REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
+
+    router->core->tcp.shutdown(
+      message.seq,
+      id,
+      RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+    );
+  });
+
+  /**
+   * Writes the message buffer to a connected TCP socket. The reply is sent
+   * once the bytes are written or queued below the write high water mark,
+   * otherwise when the queued write completes.
+   * @param id Handle ID of underlying socket
+   */
+  router->map("tcp.write", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"id"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result::Err { message, err });
+    }
+
+    Core::TCP::WriteOptions options;
+    uint64_t id;
+    REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
+
+    options.size = message.buffer.size;
+    options.bytes = message.buffer.bytes;
+
+    router->core->tcp.write(
+      message.seq,
+      id,
+      options,
+      RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+    );
+  });
+
   /**
    * Binds an UDP socket to a specified port, and optionally a host
    * address (default: 0.0.0.0).
@@ -2176,6 +2558,7 @@ static void initRouterTable (Router *router) {
    * @param port Port to bind the UDP socket to
    * @param address The address to bind the UDP socket to (default: 0.0.0.0)
    * @param reuseAddr Reuse underlying UDP socket address (default: false)
+   * @param ipv6Only Disable dual-stack support for IPv6 addresses (default: false)
    */
   router->map("udp.bind", [](auto message, auto router, auto reply) {
     Core::UDP::BindOptions options;
@@ -2190,6 +2573,7 @@ static void initRouterTable (Router *router) {
     REQUIRE_AND_GET_MESSAGE_VALUE(options.port, "port", std::stoi);
 
     options.reuseAddr = message.get("reuseAddr") == "true";
+    options.ipv6Only = message.get("ipv6Only") == "true";
     options.address = message.get("address", "0.0.0.0");
 
     router->core->udp.bind(
@@ -2330,10 +2714,80 @@ static void initRouterTable (Router *router) {
     );
   });
 
+  /**
+   * Sets options on a bound socket. Options that are not given are left
+   * unchanged and the reply contains the resulting buffer sizes.
+   * @param id Handle ID of underlying socket
+   * @param broadcast Allow sending to broadcast addresses
+   * @param ttl Unicast time to live, between 1 and 255
+   * @param multicastTTL Multicast time to live, between 0 and 255
+   * @param multicastLoopback Receive multicast datagrams sent from this host
+   * @param multicastInterface Interface address to send multicast datagrams from
+   * @param membership Join (`add`) or leave (`drop`) the `multicastAddress` group
+   * @param multicastAddress Multicast group address for `membership`
+   * @param interfaceAddress Interface address for `membership`
+   * @param sourceAddress Source address for a source-specific `membership`
+   * @param dscp Differentiated services code point (0-63) of sent datagrams
+   * @param sendBufferSize Size of the `SO_SNDBUF` buffer
+   * @param recvBufferSize Size of the `SO_RCVBUF` buffer
+   * @see setsockopt(2)
+   * @see ip(7)
+   */
+  router->map("udp.setOptions", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"id"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result::Err { message, err });
+    }
+
+    Core::UDP::SocketOptions options;
+    uint64_t id;
+    REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
+    REQUIRE_AND_GET_MESSAGE_VALUE(options.ttl, "ttl", std::stoi, "-1");
+    REQUIRE_AND_GET_MESSAGE_VALUE(options.multicastTTL, "multicastTTL", std::stoi, "-1");
+    REQUIRE_AND_GET_MESSAGE_VALUE(options.dscp, "dscp", std::stoi, "-1");
+    REQUIRE_AND_GET_MESSAGE_VALUE(options.sendBufferSize, "sendBufferSize", std::stoi, "0");
+    REQUIRE_AND_GET_MESSAGE_VALUE(options.recvBufferSize, "recvBufferSize", std::stoi, "0");
+
+    if (message.get("broadcast").size() > 0) {
+      options.broadcast = message.get("broadcast") == "true" ? 1 : 0;
+    }
+
+    if (message.get("multicastLoopback").size() > 0) {
+      options.multicastLoopback = message.get("multicastLoopback") == "true" ? 1 : 0;
+    }
+
+    options.multicastInterface = message.get("multicastInterface");
+
+    if (message.get("membership").size() > 0) {
+      if (message.get("multicastAddress").size() == 0) {
+        auto err = JSON::Object::Entries {
+          {"message", "Expecting 'multicastAddress' in parameters with 'membership'"}
+        };
+
+        return reply(Result::Err { message, err });
+      }
+
+      options.membership.join = message.get("membership") != "drop";
+      options.membership.multicastAddress = message.get("multicastAddress");
+      options.membership.interfaceAddress = message.get("interfaceAddress");
+      options.membership.sourceAddress = message.get("sourceAddress");
+    }
+
+    router->core->udp.setOptions(
+      message.seq,
+      id,
+      options,
+      RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+    );
+  });
+
   /**
    * Initializes socket handle to start receiving data from the underlying
    * socket and route through the IPC bridge to the WebView.
    * @param id Handle ID of underlying socket
+   * @param gro Receive coalesced datagrams with UDP GRO, if supported
+   * @see udp(7)
    */
   router->map("udp.readStart", [](auto message, auto router, auto reply) {
     auto err = validateMessageParameters(message, {"id"});
@@ -2342,12 +2796,16 @@ static void initRouterTable (Router *router) {
       return reply(Result::Err { message, err });
     }
 
+    Core::UDP::ReadStartOptions options;
     uint64_t id;
     REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
 
+    options.gro = message.get("gro") == "true";
+
     router->core->udp.readStart(
       message.seq,
       id,
+      options,
       [message, reply](auto seq, auto json, auto post) {
         reply(Result { seq, message, json, post });
       }
@@ -2386,7 +2844,10 @@ static void initRouterTable (Router *router) {
    * @param size The size of the bytes to send
    * @param bytes A pointer to the bytes to send
    * @param address The address to send to (default: 0.0.0.0)
+   * @param segmentSize Send the bytes as datagrams of this size, with UDP GSO if supported (default: 0)
+   * @param highWaterMark Queued send bytes past which sends are refused until a "drain" event (default: 0, no limit)
    * @param ephemeral Indicates that the socket handle, if created is ephemeral and should eventually be destroyed
+   * @see udp(7)
    */
   router->map("udp.send", [](auto message, auto router, auto reply) {
     auto err = validateMessageParameters(message, {"id", "port"});
@@ -2399,6 +2860,8 @@ static void initRouterTable (Router *router) {
     uint64_t id;
     REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
     REQUIRE_AND_GET_MESSAGE_VALUE(options.port, "port", std::stoi);
+    REQUIRE_AND_GET_MESSAGE_VALUE(options.segmentSize, "segmentSize", std::stoull, "0");
+    REQUIRE_AND_GET_MESSAGE_VALUE(options.highWaterMark, "highWaterMark", std::stoull, "0");
 
     options.size = message.buffer.size;
     options.bytes = message.buffer.bytes;
@@ -2413,6 +2876,99 @@ static void initRouterTable (Router *router) {
     );
   });
 
+  /**
+   * Sends many datagrams on the socket in a single request and replies once
+   * with the number of datagrams sent and failed. Each destination in the
+   * message buffer is a big endian `uint16` port, a `uint8` address length
+   * and the address. Unless `shared` is set, each destination is followed by
+   * a big endian `uint32` size and its own payload. With `shared`, the
+   * buffer starts with a big endian `uint32` size and one payload that is
+   * sent to every destination.
+   * @param id Handle ID of underlying socket
+   * @param shared Send one payload to every destination
+   * @param ephemeral Indicates that the socket handle, if created is ephemeral and should eventually be destroyed
+   * @see sendmmsg(2)
+   */
+  router->map("udp.sendMany", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"id"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result::Err { message, err });
+    }
+
+    if (message.buffer.bytes == nullptr || message.buffer.size == 0) {
+      auto err = JSON::Object::Entries {{ "message", "Missing buffer in message" }};
+      return reply(Result::Err { message, err });
+    }
+
+    Core::UDP::SendManyOptions options;
+    uint64_t id;
+    REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
+
+    auto bytes = (const unsigned char *) message.buffer.bytes;
+    auto size = message.buffer.size;
+    auto shared = message.get("shared") == "true";
+    const char *payload = nullptr;
+    size_t payloadSize = 0;
+    size_t offset = 0;
+
+    auto readSize = [&]() {
+      auto value = (
+        ((size_t) bytes[offset] << 24) |
+        ((size_t) bytes[offset + 1] << 16) |
+        ((size_t) bytes[offset + 2] << 8) |
+        ((size_t) bytes[offset + 3])
+      );
+
+      offset += 4;
+      return value;
+    };
+
+    if (shared && size >= 4) {
+      payloadSize = readSize();
+      payload = (const char *) bytes + offset;
+      offset += payloadSize;
+    }
+
+    while (offset + 3 <= size) {
+      Peer::UDPSendDatagram datagram;
+      datagram.port = (bytes[offset] << 8) | bytes[offset + 1];
+      auto addressSize = (size_t) bytes[offset + 2];
+      offset += 3;
+
+      if (offset + addressSize > size) break;
+      datagram.address = String((const char *) bytes + offset, addressSize);
+      offset += addressSize;
+
+      if (shared) {
+        datagram.bytes = payload;
+        datagram.size = payloadSize;
+      } else {
+        if (offset + 4 > size) break;
+        datagram.size = readSize();
+        datagram.bytes = (const char *) bytes + offset;
+        offset += datagram.size;
+      }
+
+      if (offset > size) break;
+      options.datagrams.push_back(datagram);
+    }
+
+    if (offset != size) {
+      auto err = JSON::Object::Entries {{ "message", "Malformed datagrams in message buffer" }};
+      return reply(Result::Err { message, err });
+    }
+
+    options.ephemeral = message.get("ephemeral") == "true";
+
+    router->core->udp.sendMany(
+      message.seq,
+      id,
+      options,
+      RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+    );
+  });
+
   router->map("window.showFileSystemPicker", [](auto message, auto router, auto reply) {
     const auto allowMultiple = message.get("allowMultiple") == "true";
     const auto allowFiles = message.get("allowFiles") == "true";
@@ -2479,7 +3035,7 @@ static void registerSchemeHandler (Router *router) {
   webkit_web_context_register_uri_scheme(ctx, "ipc", [](auto request, auto ptr) {
     auto uri = String(webkit_uri_scheme_request_get_uri(request));
     auto router = reinterpret_cast<Router *>(ptr);
-    auto invoked = router->invoke(uri, [=](auto result) {
+    auto invoked = router->invoke(uri, [=](const auto& result) {
       auto json = result.str();
       auto size = result.post.body != nullptr ? result.post.length : json.size();
       auto body = result.post.body != nullptr ? result.post.body : json.c_str();
@@ -3120,15 +3676,10 @@ static void registerSchemeHandler (Router *router) {
 
     headers[@"content-length"] = [@(post.length) stringValue];
 
-    if (post.headers.size() > 0) {
-      auto lines = SSC::split(SSC::trim(post.headers), '\n');
-
-      for (auto& line : lines) {
-        auto pair = split(trim(line), ':');
-        auto key = [NSString stringWithUTF8String: trim(pair[0]).c_str()];
-        auto value = [NSString stringWithUTF8String: trim(pair[1]).c_str()];
-        headers[key] = value;
-      }
+    for (const auto& header : post.headers.entries) {
+      auto key = [NSString stringWithUTF8String: header.key.c_str()];
+      auto value = [NSString stringWithUTF8String: header.value.c_str()];
+      headers[key] = value;
     }
 
     auto response = [[NSHTTPURLResponse alloc]
@@ -3172,7 +3723,7 @@ static void registerSchemeHandler (Router *router) {
 
   [self enqueueTask: task withMessage: message];
 
-  auto invoked = self.router->invoke(message, body, bufsize, [=](Result result) {
+  auto invoked = self.router->invoke(message, body, bufsize, [=](const Result& result) {
     // @TODO Communicate task cancellation to the route, so it can cancel its work.
     if (![self waitingForTask: task]) {
       return;
@@ -3842,7 +4393,7 @@ namespace SSC::IPC {
 
     // 1. Try the given path if it's a file
     if (fs::is_regular_file(fullPath)) {
-      return Router::WebViewURLPathResolution{"/" + replace(fs::relative(fullPath, basePath).string(), "\\\\", "/")};
+      return Router::WebViewURLPathResolution{"/" + replace(fs::relative(fullPath, basePath).string(), '\\', '/')};
     }
 
     // 2. Try appending a `/` to the path and checking for an index.html
@@ -3850,12 +4401,12 @@ namespace SSC::IPC {
     if (fs::is_regular_file(indexPath)) {
       if (fullPath.string().ends_with("\\") || fullPath.string().ends_with("/")) {
         return Router::WebViewURLPathResolution{
-          .path = "/" + replace(fs::relative(indexPath, basePath).string(), "\\\\", "/"),
+          .path = "/" + replace(fs::relative(indexPath, basePath).string(), '\\', '/'),
           .redirect = false
         };
       } else {
         return Router::WebViewURLPathResolution{
-          .path = "/" + replace(fs::relative(fullPath, basePath).string(), "\\\\", "/") + "/",
+          .path = "/" + replace(fs::relative(fullPath, basePath).string(), '\\', '/') + "/",
           .redirect = true
         };
       }
@@ -3865,7 +4416,7 @@ namespace SSC::IPC {
     fs::path htmlPath = fullPath;
     htmlPath.replace_extension(".html");
     if (fs::is_regular_file(htmlPath)) {
-      return Router::WebViewURLPathResolution{"/" + replace(fs::relative(htmlPath, basePath).string(), "\\\\", "/")};
+      return Router::WebViewURLPathResolution{"/" + replace(fs::relative(htmlPath, basePath).string(), '\\', '/')};
     }
 
     // If no valid path is found, return empty string
@@ -3984,7 +4535,8 @@ namespace SSC::IPC {
 
     for (const auto& tuple : mounts) {
       if (path.starts_with(tuple.second)) {
-        const auto relative = replace(path, tuple.second, "");
+        // only the mount prefix is removed, not later occurrences of it
+        const auto relative = path.substr(tuple.second.size());
         const auto resolution = resolveURLPathForWebView(relative, tuple.first);
         if (resolution.path.size() > 0) {
           const auto resolved = Path(tuple.first) / resolution.path.substr(1);
@@ -4181,7 +4733,7 @@ namespace SSC::IPC {
   }
 
   bool Router::invoke (const String& uri, const char *bytes, size_t size) {
-    return this->invoke(uri, bytes, size, [this](auto result) {
+    return this->invoke(uri, bytes, size, [this](const auto& result) {
       this->send(result.seq, result.str(), result.post);
     });
   }
@@ -4259,7 +4811,7 @@ namespace SSC::IPC {
 
       if (ctx.async) {
         auto dispatched = this->dispatch([ctx, msg, callback, this]() mutable {
-          ctx.callback(msg, this, [msg, callback, this](const auto result) mutable {
+          ctx.callback(msg, this, [msg, callback, this](const auto& result) mutable {
             if (result.seq == "-1") {
               this->send(result.seq, result.str(), result.post);
             } else {
@@ -4276,7 +4828,7 @@ namespace SSC::IPC {
 
         return dispatched;
       } else {
-        ctx.callback(msg, this, [msg, callback, this](const auto result) mutable {
+        ctx.callback(msg, this, [msg, callback, this](const auto& result) mutable {
           if (result.seq == "-1") {
             this->send(result.seq, result.str(), result.post);
           } else {
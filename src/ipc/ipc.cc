@@ -23,17 +23,11 @@ namespace SSC {
   #endif
 }
 namespace SSC::IPC {
-  Message::Message (const Message& message) {
-    this->buffer.bytes = message.buffer.bytes;
-    this->buffer.size = message.buffer.size;
-    this->value = message.value;
-    this->index = message.index;
-    this->name = message.name;
-    this->seq = message.seq;
-    this->uri = message.uri;
-    this->args = message.args;
-    this->isHTTP = message.isHTTP;
-    this->cancel = message.cancel;
+  // decodes a query value without copying it first
+  static String decodeValue (StringView encoded) {
+    String output(encoded.size(), '\0');
+    output.resize(decodeURIComponent(output.data(), encoded.data(), encoded.size()));
+    return output;
   }
 
   Message::Message (const String& source, char *bytes, size_t size)
@@ -56,62 +50,80 @@ namespace SSC::IPC {
   {}
 
   Message::Message (const String& source, bool decodeValues) {
-    String str = source;
-    uri = str;
+    const StringView str = source;
+    auto state = std::make_shared<State>();
+    auto& args = state->args;
+
+    state->uri = source;
+    this->state = state;
 
     // bail if missing protocol prefix
-    if (str.find("ipc://") == -1) return;
+    if (str.find("ipc://") == StringView::npos) return;
 
     // bail if malformed
-    if (str.compare("ipc://") == 0) return;
-    if (str.compare("ipc://?") == 0) return;
+    if (str == "ipc://") return;
+    if (str == "ipc://?") return;
+
+    auto raw = Tokenizer(str, '?');
+    StringView path;
+    StringView query;
+    StringView rest;
 
-    String query;
-    String path;
+    raw.next(path);
 
-    auto raw = split(str, '?');
-    path = raw[0];
-    if (raw.size() > 1) query = raw[1];
+    auto parts = Tokenizer(path, '/');
+    StringView part;
+    if (parts.next(part) && parts.next(part)) name = part;
 
-    auto parts = split(path, '/');
-    if (parts.size() >= 1) name = parts[1];
+    if (!raw.next(query) || raw.next(rest)) return;
+    auto pairs = Tokenizer(query, '&');
+    StringView rawPair;
 
-    if (raw.size() != 2) return;
-    auto pairs = split(raw[1], '&');
+    while (pairs.next(rawPair)) {
+      auto pair = Tokenizer(rawPair, '=');
+      StringView key;
+      StringView encoded;
 
-    for (auto& rawPair : pairs) {
-      auto pair = split(rawPair, '=');
-      if (pair.size() <= 1) continue;
+      if (!pair.next(key) || !pair.next(encoded)) continue;
 
-      if (pair[0].compare("index") == 0) {
+      if (key == "index") {
         try {
-          index = std::stoi(pair[1].size() > 0 ? pair[1] : "0");
+          index = std::stoi(String(encoded));
         } catch (...) {
           debug("Warning: received non-integer index");
         }
       }
 
-      if (pair[0].compare("value") == 0) {
-        value = decodeURIComponent(pair[1]);
+      if (key == "value") {
+        value = decodeValue(encoded);
       }
 
-      if (pair[0].compare("seq") == 0) {
-        seq = decodeURIComponent(pair[1]);
+      if (key == "seq") {
+        seq = decodeValue(encoded);
       }
 
       if (decodeValues) {
-        args[pair[0]] = decodeURIComponent(pair[1]);
+        args[String(key)] = decodeValue(encoded);
       } else {
-        args[pair[0]] = pair[1];
+        args[String(key)] = encoded;
       }
     }
   }
 
+  const String& Message::uri () const {
+    static const auto empty = String("");
+    return this->state != nullptr ? this->state->uri : empty;
+  }
+
+  const Map& Message::args () const {
+    static const auto empty = Map{};
+    return this->state != nullptr ? this->state->args : empty;
+  }
+
   bool Message::has (const String& key) const {
-    return (
-      this->args.find(key) != this->args.end() &&
-      this->args.at(key).size() > 0
-    );
+    const auto& args = this->args();
+    const auto entry = args.find(key);
+    return entry != args.end() && entry->second.size() > 0;
   }
 
   String Message::get (const String& key) const {
@@ -119,7 +131,9 @@ namespace SSC::IPC {
   }
 
   String Message::get (const String& key, const String &fallback) const {
-    return args.count(key) ? decodeURIComponent(args.at(key)) : fallback;
+    const auto& args = this->args();
+    const auto entry = args.find(key);
+    return entry != args.end() ? decodeURIComponent(entry->second) : fallback;
   }
 
   Result::Result (
@@ -137,7 +151,7 @@ namespace SSC::IPC {
     const Message::Seq& seq,
     const Message& message,
     JSON::Any value
-  ) : Result(seq, message, value, Post{}) {
+  ) : Result(seq, message, std::move(value), Post{}) {
   }
 
   Result::Result (
@@ -146,15 +160,15 @@ namespace SSC::IPC {
     JSON::Any value,
     Post post
   ) : Result(seq, message) {
-    this->post = post;
-    this->headers = Headers(post.headers);
+    this->headers = post.headers;
+    this->post = std::move(post);
 
     if (this->post.workerId.size() == 0) {
       this->post.workerId = this->message.get("runtime-worker-id");
     }
 
     if (value.type != JSON::Type::Any) {
-      this->value = value;
+      this->value = std::move(value);
     }
   }
 
@@ -163,16 +177,14 @@ namespace SSC::IPC {
     this->value = value;
   }
 
-  Result::Result (const Err error): Result(error.message.seq, error.message) {
-    this->err = error.value;
-    this->source = error.message.name;
+  Result::Result (Err error): Result(error.message.seq, error.message) {
+    this->err = std::move(error.value);
   }
 
-  Result::Result (const Data data): Result(data.message.seq, data.message) {
-    this->data = data.value;
-    this->post = data.post;
-    this->source = data.message.name;
-    this->headers = Headers(data.post.headers);
+  Result::Result (Data data): Result(data.message.seq, data.message) {
+    this->data = std::move(data.value);
+    this->headers = data.post.headers;
+    this->post = std::move(data.post);
   }
 
   JSON::Any Result::json () const {
@@ -223,26 +235,24 @@ namespace SSC::IPC {
   Result::Err::Err (
     const Message& message,
     JSON::Any value
-  ) {
-    this->seq = message.seq;
-    this->message = message;
-    this->value = value;
-  }
+  ) : message(message),
+      seq(message.seq),
+      value(std::move(value))
+  {}
 
   Result::Data::Data (
     const Message& message,
     JSON::Any value
-  ) : Data(message, value, Post{}) {
+  ) : Data(message, std::move(value), Post{}) {
   }
 
   Result::Data::Data (
     const Message& message,
     JSON::Any value,
     Post post
-  ) {
-    this->seq = message.seq;
-    this->message = message;
-    this->value = value;
-    this->post = post;
-  }
+  ) : message(message),
+      seq(message.seq),
+      value(std::move(value)),
+      post(std::move(post))
+  {}
 }
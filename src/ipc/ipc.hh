@@ -144,27 +144,38 @@ namespace SSC::IPC {
   class Message {
     public:
       using Seq = String;
+
+      // parsed from the URI once and shared by every copy of a message
+      struct State {
+        String uri = "";
+        Map args;
+      };
+
       MessageBuffer buffer;
       String value = "";
       String name = "";
-      String uri = "";
       int index = -1;
       Seq seq = "";
-      Map args;
       bool isHTTP = false;
+      std::shared_ptr<const State> state;
       std::shared_ptr<MessageCancellation> cancel;
 
       Message () = default;
-      Message (const Message& message);
+      Message (const Message& message) = default;
+      Message (Message&& message) = default;
       Message (const String& source, bool decodeValues);
       Message (const String& source);
       Message (const String& source, bool decodeValues, char *bytes, size_t size);
       Message (const String& source, char *bytes, size_t size);
+      Message& operator = (const Message& message) = default;
+      Message& operator = (Message&& message) = default;
+      const String& uri () const;
+      const Map& args () const;
       bool has (const String& key) const;
       String get (const String& key) const;
       String get (const String& key, const String& fallback) const;
-      String str () const { return this->uri; }
-      const char * c_str () const { return this->uri.c_str(); }
+      String str () const { return this->uri(); }
+      const char * c_str () const { return this->uri().c_str(); }
   };
 
   class Result {
@@ -202,12 +213,15 @@ namespace SSC::IPC {
 
       Result () = default;
       Result (const Result&) = default;
+      Result (Result&&) = default;
       Result (const JSON::Any);
-      Result (const Err error);
-      Result (const Data data);
+      Result (Err error);
+      Result (Data data);
       Result (const Message::Seq&, const Message&);
       Result (const Message::Seq&, const Message&, JSON::Any);
       Result (const Message::Seq&, const Message&, JSON::Any, Post);
+      Result& operator = (const Result&) = default;
+      Result& operator = (Result&&) = default;
       String str () const;
       JSON::Any json () const;
   };
@@ -217,7 +231,7 @@ namespace SSC::IPC {
       using EvaluateJavaScriptCallback = std::function<void(const String)>;
       using DispatchCallback = std::function<void()>;
       using ReplyCallback = std::function<void(const Result&)>;
-      using ResultCallback = std::function<void(Result)>;
+      using ResultCallback = std::function<void(const Result&)>;
       using MessageCallback = std::function<void(const Message&, Router*, ReplyCallback)>;
       using BufferMap = std::map<String, MessageBuffer>;
 
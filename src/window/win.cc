@@ -958,7 +958,7 @@ namespace SSC {
                             }
                           }
 
-                          handled = w->bridge->route(uri, body_ptr, body_length, [&, args, deferral, env, body_ptr](auto result) {
+                          handled = w->bridge->route(uri, body_ptr, body_length, [&, args, deferral, env, body_ptr](const auto& result) {
                             String headers;
                             char* body;
                             size_t length;
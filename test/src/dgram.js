@@ -251,6 +251,95 @@ test('udp send callback', async (t) => {
   t.ok(result, 'send callback called')
 })
 
+test('udp send queue accounting', async (t) => {
+  const address = '127.0.0.1'
+  const client = dgram.createSocket({ type: 'udp4', sendHighWaterMark: 64 * 1024 })
+
+  t.equal(client.getSendQueueSize(), 0, 'send queue is empty before sending')
+  t.equal(client.getSendQueueCount(), 0, 'no sends are queued before sending')
+
+  const err = await new Promise(resolve => {
+    client.send(Buffer.from('Some bytes'), 41238, address, resolve)
+  })
+
+  t.ok(!err, 'send below the high-water mark succeeds')
+  t.equal(typeof client.getSendQueueSize(), 'number', 'send queue size is reported after sending')
+  t.equal(typeof client.getSendQueueCount(), 'number', 'send queue count is reported after sending')
+
+  await util.promisify(client.close.bind(client))()
+})
+
+// sends a burst past a 1 byte high-water mark, after a first send that binds
+// `client`, and waits for 'drain'
+async function testSendHighWaterMark (t, client, ...args) {
+  const payload = Buffer.alloc(1024)
+  const first = await new Promise(resolve => client.send(payload, ...args, resolve))
+  t.ok(!first, 'first send succeeds')
+
+  const drained = new Promise(resolve => client.once('drain', () => resolve(true)))
+  const errors = await Promise.all(Array.from({ length: 64 }, () => {
+    return new Promise(resolve => client.send(payload, ...args, resolve))
+  }))
+
+  t.ok(
+    errors.some(err => err?.code === 'ERR_SOCKET_DGRAM_WOULD_BLOCK'),
+    'sends past the high-water mark fail with ERR_SOCKET_DGRAM_WOULD_BLOCK'
+  )
+
+  const timeout = new Promise(resolve => setTimeout(resolve, 2000, false))
+  t.ok(await Promise.race([drained, timeout]), "'drain' is emitted once the queue falls")
+}
+
+test('udp send past the high-water mark (unbound)', async (t) => {
+  const server = dgram.createSocket('udp4')
+  await new Promise(resolve => server.bind(0, '127.0.0.1', resolve))
+
+  const client = dgram.createSocket({ type: 'udp4', sendHighWaterMark: 1 })
+  await testSendHighWaterMark(t, client, server.address().port, '127.0.0.1')
+
+  await util.promisify(client.close.bind(client))()
+  await util.promisify(server.close.bind(server))()
+})
+
+test('udp send past the high-water mark (connected)', async (t) => {
+  const server = dgram.createSocket('udp4')
+  await new Promise(resolve => server.bind(0, '127.0.0.1', resolve))
+
+  const client = dgram.createSocket({ type: 'udp4', sendHighWaterMark: 1 })
+  await new Promise(resolve => client.connect(server.address().port, '127.0.0.1', resolve))
+  await testSendHighWaterMark(t, client)
+
+  await util.promisify(client.close.bind(client))()
+  await util.promisify(server.close.bind(server))()
+})
+
+test('udp socket options', async (t) => {
+  const socket = dgram.createSocket('udp4')
+
+  t.throws(
+    () => socket.setBroadcast(true),
+    // eslint-disable-next-line prefer-regex-literals
+    RegExp('Not running'),
+    'socket.setBroadcast() throws before the socket is bound'
+  )
+
+  await new Promise(resolve => socket.bind(0, '0.0.0.0', resolve))
+
+  socket.setBroadcast(true)
+  t.equal(socket.setTTL(64), 64, 'socket.setTTL() returns the TTL')
+  t.equal(socket.setMulticastTTL(2), 2, 'socket.setMulticastTTL() returns the TTL')
+  t.equal(socket.setMulticastLoopback(true), true, 'socket.setMulticastLoopback() returns the flag')
+  t.equal(socket.setDSCP(46), 46, 'socket.setDSCP() returns the code point')
+  t.throws(() => socket.setTTL(0), RegExp('ttl'), 'socket.setTTL() throws for an invalid TTL')
+  t.throws(() => socket.setDSCP(64), RegExp('dscp'), 'socket.setDSCP() throws for an invalid code point')
+
+  socket.addMembership('239.255.0.1')
+  socket.dropMembership('239.255.0.1')
+  t.pass('socket joins and leaves a multicast group')
+
+  await util.promisify(socket.close.bind(socket))()
+})
+
 test('udp createSocket AbortSignal', async (t) => {
   const controller = new AbortController()
   const { signal } = controller
@@ -323,6 +412,177 @@ test('client ~> server (~512 messages)', async (t) => {
   ])
 })
 
+test('udp burst of messages (batched receive)', async (t) => {
+  if (process.env.SSC_ANDROID_CI) return
+
+  const address = '127.0.0.1'
+  const messages = Array.from(Array(32), (_, i) => Buffer.from(`message ${i}`))
+  const server = dgram.createSocket('udp4')
+  const client = dgram.createSocket('udp4')
+  const port = 30002
+  const received = new Set()
+
+  await new Promise((resolve) => {
+    const timeout = setTimeout(() => {
+      t.fail(`Not all messages received (${messages.length - received.size} missing)`)
+      resolve()
+    }, 1024)
+
+    server.bind(port, address, () => {
+      server.on('message', (message, rinfo) => {
+        t.equal(rinfo.address, address, 'rinfo.address is correct')
+        t.equal(rinfo.family, 'IPv4', 'rinfo.family is correct')
+        received.add(message.toString())
+
+        if (received.size === messages.length) {
+          clearTimeout(timeout)
+          t.ok(true, `all ${messages.length} messages received`)
+          resolve()
+        }
+      })
+
+      client.connect(port, address, (err) => {
+        if (err) return t.ifError(err)
+        for (const message of messages) {
+          client.send(message)
+        }
+      })
+    })
+  })
+
+  await Promise.all([
+    util.promisify(server.close.bind(server))(),
+    util.promisify(client.close.bind(client))()
+  ])
+})
+
+test('udp sendMany to many destinations', async (t) => {
+  if (process.env.SSC_ANDROID_CI) return
+
+  const address = '127.0.0.1'
+  const servers = [30003, 30004, 30005].map(() => dgram.createSocket('udp4'))
+  const client = dgram.createSocket('udp4')
+  const received = []
+
+  await Promise.all(servers.map((server, i) => new Promise((resolve) => {
+    server.bind(30003 + i, address, resolve)
+  })))
+
+  const messages = Promise.all(servers.map((server) => new Promise((resolve) => {
+    server.once('message', (message) => {
+      received.push(message.toString())
+      resolve()
+    })
+  })))
+
+  const result = await new Promise((resolve) => {
+    client.sendMany('hello', servers.map((_, i) => ({ port: 30003 + i, address })), (err, data) => {
+      if (err) t.ifError(err)
+      resolve(data)
+    })
+  })
+
+  t.equal(result?.sent, servers.length, 'sendMany reports all datagrams sent')
+  t.equal(result?.failed, 0, 'sendMany reports no failed datagrams')
+
+  await Promise.race([messages, new Promise((resolve) => setTimeout(resolve, 1024))])
+  t.deepEqual(received, ['hello', 'hello', 'hello'], 'each destination received the payload')
+
+  const pairs = await new Promise((resolve) => {
+    const datagrams = servers.map((_, i) => ({
+      buffer: Buffer.from(`message ${i}`),
+      port: 30003 + i,
+      address
+    }))
+
+    client.sendMany(datagrams, (err, data) => {
+      if (err) t.ifError(err)
+      resolve(data)
+    })
+  })
+
+  t.equal(pairs?.sent, servers.length, 'sendMany reports all (buffer, destination) pairs sent')
+
+  await Promise.all([
+    ...servers.map((server) => util.promisify(server.close.bind(server))()),
+    util.promisify(client.close.bind(client))()
+  ])
+})
+
+test('udp6 send and dual-stack receive', async (t) => {
+  if (process.env.SSC_ANDROID_CI) return
+
+  const server = dgram.createSocket('udp6')
+  const client6 = dgram.createSocket('udp6')
+  const client4 = dgram.createSocket('udp4')
+  const port = 30006
+
+  await new Promise((resolve) => server.bind(port, '::', resolve))
+  t.equal(server.address().family, 'IPv6', 'server is bound to an IPv6 address')
+
+  const receive = () => new Promise((resolve) => {
+    const timeout = setTimeout(() => resolve({}), 1024)
+    server.once('message', (message, rinfo) => {
+      clearTimeout(timeout)
+      resolve({ message, rinfo })
+    })
+  })
+
+  let received = receive()
+  client6.send(Buffer.from('hello ipv6'), port, '::1')
+  let { message, rinfo } = await received
+
+  t.equal(message?.toString(), 'hello ipv6', 'IPv6 message received')
+  t.equal(rinfo?.address, '::1', 'rinfo.address is the IPv6 loopback')
+  t.equal(rinfo?.family, 'IPv6', 'rinfo.family is IPv6')
+
+  received = receive()
+  client4.send(Buffer.from('hello ipv4'), port, '127.0.0.1')
+  ;({ message, rinfo } = await received)
+
+  t.equal(message?.toString(), 'hello ipv4', 'IPv4 message received on dual-stack socket')
+  t.equal(rinfo?.address, '127.0.0.1', 'rinfo.address is unmapped to IPv4')
+  t.equal(rinfo?.family, 'IPv4', 'rinfo.family is IPv4')
+
+  await Promise.all([
+    util.promisify(server.close.bind(server))(),
+    util.promisify(client6.close.bind(client6))(),
+    util.promisify(client4.close.bind(client4))()
+  ])
+})
+
+test('udp segmented send and coalesced receive', async (t) => {
+  if (process.env.SSC_ANDROID_CI) return
+
+  const server = dgram.createSocket({ type: 'udp4', gro: true })
+  const client = dgram.createSocket({ type: 'udp4', segmentSize: 1000 })
+  const port = 30007
+  const sizes = []
+
+  await new Promise((resolve) => server.bind(port, '127.0.0.1', resolve))
+
+  const messages = new Promise((resolve) => {
+    const timeout = setTimeout(resolve, 1024)
+    server.on('message', (message) => {
+      sizes.push(message.length)
+      if (sizes.length === 3) {
+        clearTimeout(timeout)
+        resolve()
+      }
+    })
+  })
+
+  client.send(Buffer.alloc(2500, 1), port, '127.0.0.1')
+  await messages
+
+  t.deepEqual(sizes, [1000, 1000, 500], 'buffer is received as segments of segmentSize')
+
+  await Promise.all([
+    util.promisify(server.close.bind(server))(),
+    util.promisify(client.close.bind(client))()
+  ])
+})
+
 test('connect + disconnect', async (t) => {
   await new Promise((resolve) => {
     const address = '127.0.0.1'
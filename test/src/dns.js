@@ -1,4 +1,5 @@
 import { test } from 'socket:test'
+import diagnostics from 'socket:diagnostics'
 import process from 'socket:process'
 import dns from 'socket:dns'
 import os from 'socket:os'
@@ -57,6 +58,44 @@ test('dns.lookup', async t => {
   ])
 })
 
+test('dns.lookup all', async t => {
+  const expected = await new Promise(resolve => {
+    dns.lookup('localhost', { all: true }, (err, addresses) => {
+      if (err) return t.fail(err)
+      t.ok(Array.isArray(addresses), 'returns an array of addresses')
+      t.ok(addresses.length > 0, 'returns at least one address')
+      t.ok(addresses.every(({ address, family }) => (
+        (family === 4 && IPV4_REGEX.test(address)) ||
+        (family === 6 && IPV6_REGEX.test(address))
+      )), 'each address has a valid address and family')
+      resolve(addresses)
+    })
+  })
+
+  const addresses = await dns.promises.lookup('localhost', { family: 0, all: true, verbatim: false })
+  const families = addresses.map(({ family }) => family)
+  const sorted = (addresses) => addresses.map(({ address }) => address).sort()
+
+  t.ok(Array.isArray(addresses), 'promises.lookup returns an array of addresses')
+  t.deepEqual(sorted(addresses), sorted(expected), 'family 0 returns addresses of both families')
+
+  if (families.includes(4) && families.includes(6)) {
+    t.ok(families.lastIndexOf(4) < families.indexOf(6), 'IPv4 addresses are first without verbatim')
+  } else {
+    t.comment('skipping verbatim order, localhost resolves to a single family')
+  }
+})
+
+test('dns.lookup cache', async t => {
+  const before = await diagnostics.query()
+  await dns.promises.lookup('localhost', 4)
+  await dns.promises.lookup('localhost', 4)
+  const after = await diagnostics.query()
+
+  t.ok(after.dns.cache.hits > before.dns.cache.hits, 'repeated lookup is served from the cache')
+  t.ok(after.dns.cache.size > 0, 'cache has entries')
+})
+
 const BAD_HOSTNAME = 'thisisnotahostname'
 
 test('dns.lookup bad hostname', async t => {
@@ -125,6 +125,130 @@ test('fs.promises.stat', async (t) => {
 })
 
 if (os.platform() !== 'android') {
+  test('fs.promises.statMany', async (t) => {
+    const stats = await fs.statMany([
+      FIXTURES + 'file.txt',
+      FIXTURES + 'directory',
+      FIXTURES + 'does-not-exist'
+    ])
+
+    t.equal(stats.length, 3, 'a result is returned for each path')
+    t.equal(stats[0].isFile(), true, 'stats are for a file')
+    t.equal(stats[1].isDirectory(), true, 'stats are for a directory')
+    t.equal(stats[2], null, 'stats are null for a missing path')
+
+    const expected = await fs.stat(FIXTURES + 'file.txt')
+    t.equal(stats[0].size, expected.size, 'size matches fs.promises.stat')
+    t.equal(stats[0].mtimeMs, expected.mtimeMs, 'mtimeMs matches fs.promises.stat')
+  })
+
+  test('FileHandle (writeBehind)', async (t) => {
+    const file = FIXTURES + 'write-behind.txt'
+    const handle = await FileHandle.open(file, 'w+', 0o666, { writeBehind: true })
+    const lines = Array.from({ length: 32 }, (_, i) => `line ${i}\n`)
+
+    let position = 0
+    const writes = lines.map((line) => {
+      const buffer = Buffer.from(line)
+      const write = handle.write(buffer, 0, buffer.length, position)
+      position += buffer.length
+      return write
+    })
+
+    const results = await Promise.all(writes)
+    t.ok(
+      results.every((result, i) => result.bytesWritten === lines[i].length),
+      'each write reports its own bytes written'
+    )
+
+    await Promise.all([handle.sync(), handle.sync(), handle.sync()])
+    t.pass('concurrent syncs resolve')
+
+    for (const line of lines) {
+      const buffer = Buffer.from(line)
+      await handle.write(buffer, 0, buffer.length, position)
+      position += buffer.length
+    }
+
+    const { buffer, bytesRead } = await handle.read(Buffer.alloc(position), 0, position, 0)
+    t.equal(bytesRead, position, 'awaited writes are read back through the handle')
+    t.equal(buffer.toString(), lines.join('').repeat(2), 'buffered writes are read in order')
+
+    await handle.close()
+    const contents = await fs.readFile(file)
+    t.equal(contents.toString(), lines.join('').repeat(2), 'coalesced writes land in order')
+    await fs.unlink(file)
+  })
+
+  test('FileHandle.read (readAhead)', async (t) => {
+    const file = FIXTURES + 'read-ahead.bin'
+    const chunkSize = 4096
+    const data = Buffer.alloc(chunkSize * 16)
+
+    for (let i = 0; i < data.length; ++i) {
+      data[i] = (i * 31 + (i >> 12)) & 0xff
+    }
+
+    await fs.writeFile(file, data)
+
+    const handle = await FileHandle.open(file, 'r')
+    const chunks = []
+
+    // sequential reads are served from chunks read ahead after the first two
+    for (let position = 0; position < data.length; position += chunkSize) {
+      const buffer = Buffer.alloc(chunkSize)
+      const { bytesRead } = await handle.read(buffer, 0, chunkSize, position, { readAhead: 4 })
+      chunks.push(buffer.slice(0, bytesRead))
+    }
+
+    const { bytesRead } = await handle.read(Buffer.alloc(chunkSize), 0, chunkSize, data.length, { readAhead: 4 })
+
+    t.ok(Buffer.concat(chunks).equals(data), 'sequential reads return the file contents')
+    t.equal(bytesRead, 0, 'reading past the end returns no bytes')
+
+    // a reader following a growing file sees data written after the end
+    const extra = Buffer.alloc(chunkSize, 0x2a)
+    const writer = await FileHandle.open(file, 'r+')
+    await writer.write(extra, 0, extra.length, data.length)
+    await writer.close()
+
+    const buffer = Buffer.alloc(chunkSize)
+    const grown = await handle.read(buffer, 0, chunkSize, data.length, { readAhead: 4 })
+    await handle.close()
+
+    t.equal(grown.bytesRead, chunkSize, 'reading after the file grows returns the new bytes')
+    t.ok(buffer.equals(extra), 'new bytes are not served from a stale chunk')
+  })
+
+  test('FileHandle.read (readAhead clamp)', async (t) => {
+    const file = FIXTURES + 'read-ahead.bin'
+    const data = await fs.readFile(file)
+    const handle = await FileHandle.open(file, 'r')
+    const chunkSize = 1024
+    const chunks = []
+
+    try {
+      await handle.read(Buffer.alloc(chunkSize), 0, chunkSize, 0, { readAhead: -1 })
+      t.fail('a negative readAhead is rejected')
+    } catch (err) {
+      t.ok(/readAhead/.test(err.message), 'a negative readAhead is rejected')
+    }
+
+    // the window is clamped to a few chunks instead of `Number.MAX_SAFE_INTEGER`
+    for (let position = 0; position < data.length; position += chunkSize) {
+      const buffer = Buffer.alloc(chunkSize)
+      const { bytesRead } = await handle.read(buffer, 0, chunkSize, position, {
+        readAhead: Number.MAX_SAFE_INTEGER
+      })
+
+      chunks.push(buffer.slice(0, bytesRead))
+    }
+
+    await handle.close()
+    t.ok(Buffer.concat(chunks).equals(data), 'reads with a large readAhead return the file contents')
+    await fs.unlink(file)
+  })
+
   test('fs.promises.writeFile', async (t) => {
     const file = FIXTURES + 'write-file.txt'
     const data = 'test 123\n'
@@ -132,4 +256,18 @@ if (os.platform() !== 'android') {
     const contents = await fs.readFile(file)
     t.equal(contents.toString(), data, 'file contents are correct')
   })
+
+  test('fs.promises.writeFile (atomic)', async (t) => {
+    const file = FIXTURES + 'write-file-atomic.txt'
+    await fs.writeFile(file, 'first\n', { atomic: true })
+    await fs.writeFile(file, 'second\n', { atomic: true })
+    const contents = await fs.readFile(file, 'utf8')
+    t.equal(contents, 'second\n', 'file is replaced with the new contents')
+
+    const entries = await fs.readdir(FIXTURES)
+    t.ok(
+      !entries.some((entry) => entry.startsWith('write-file-atomic.txt.tmp-')),
+      'no temporary files are left behind'
+    )
+  })
 }
@@ -6,6 +6,7 @@ import './os.js'
 import './process.js'
 import './path.js'
 import './dgram.js'
+import './net.js'
 import './dns.js'
 import './crypto.js'
 import './util.js'
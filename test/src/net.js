@@ -0,0 +1,93 @@
+import { test } from 'socket:test'
+import process from 'socket:process'
+import Buffer from 'socket:buffer'
+import net from 'socket:net'
+
+test('net exports', (t) => {
+  t.ok(net, 'net is available')
+  t.equal(typeof net.createServer, 'function', 'net.createServer is a function')
+  t.equal(typeof net.connect, 'function', 'net.connect is a function')
+  t.equal(net.createConnection, net.connect, 'net.createConnection is an alias of net.connect')
+  t.equal(net.isIP('::1'), 6, 'net.isIP detects IPv6')
+  t.equal(net.isIP('127.0.0.1'), 4, 'net.isIP detects IPv4')
+})
+
+test('net server and socket echo', async (t) => {
+  if (process.env.SSC_ANDROID_CI) return
+
+  const server = net.createServer((socket) => {
+    socket.pipe(socket)
+  })
+
+  await new Promise((resolve) => server.listen(0, '127.0.0.1', resolve))
+
+  const { port, address } = server.address()
+  t.ok(port > 0, 'server is listening on an ephemeral port')
+  t.equal(address, '127.0.0.1', 'server address is correct')
+
+  const socket = net.connect(port, '127.0.0.1')
+  await new Promise((resolve) => socket.once('connect', resolve))
+
+  t.equal(socket.remotePort, port, 'socket.remotePort is correct')
+  t.equal(socket.readyState, 'open', 'socket is open')
+
+  const payload = Buffer.alloc(256 * 1024, 'x')
+  const chunks = []
+
+  socket.on('data', (chunk) => chunks.push(chunk))
+  socket.write(payload.subarray(0, 1024))
+  socket.end(payload.subarray(1024))
+
+  await new Promise((resolve) => socket.once('close', resolve))
+
+  const echoed = Buffer.concat(chunks)
+  t.equal(echoed.length, payload.length, 'all bytes were echoed back')
+  t.ok(echoed.equals(payload), 'echoed bytes are correct')
+  t.equal(socket.bytesWritten, payload.length, 'socket.bytesWritten is correct')
+
+  await new Promise((resolve) => server.close(resolve))
+  t.equal(server.listening, false, 'server is closed')
+})
+
+test('net connect error', async (t) => {
+  if (process.env.SSC_ANDROID_CI) return
+
+  const server = net.createServer()
+  await new Promise((resolve) => server.listen(0, '127.0.0.1', resolve))
+  const { port } = server.address()
+  await new Promise((resolve) => server.close(resolve))
+
+  const socket = net.connect(port, '127.0.0.1')
+  const err = await new Promise((resolve) => socket.once('error', resolve))
+  t.equal(err?.code, 'ECONNREFUSED', 'connecting to a closed port fails with ECONNREFUSED')
+})
+
+test('net socket options and timeout', async (t) => {
+  if (process.env.SSC_ANDROID_CI) return
+
+  const server = net.createServer({ noDelay: true, keepAlive: true }, (socket) => {
+    socket.pipe(socket)
+  })
+
+  await new Promise((resolve) => server.listen(0, '127.0.0.1', resolve))
+
+  const socket = net.connect(server.address().port, '127.0.0.1')
+  t.equal(socket.setNoDelay(), socket, 'setNoDelay() before connecting returns the socket')
+  await new Promise((resolve) => socket.once('connect', resolve))
+
+  t.equal(socket.setKeepAlive(true, 30 * 1000), socket, 'setKeepAlive() returns the socket')
+  t.throws(() => socket.setTimeout(-1), /timeout/, 'setTimeout() rejects a negative timeout')
+
+  const started = Date.now()
+  const timedOut = new Promise((resolve) => socket.setTimeout(50, resolve))
+  const timeout = new Promise((resolve) => setTimeout(resolve, 2000, false))
+
+  t.ok(await Promise.race([timedOut.then(() => true), timeout]), "'timeout' is emitted when idle")
+  t.ok(Date.now() - started >= 50, "'timeout' is emitted after the idle time")
+  t.equal(socket.destroyed, false, "'timeout' does not close the socket")
+
+  socket.setTimeout(0)
+  socket.end()
+  await new Promise((resolve) => socket.once('close', resolve))
+  await new Promise((resolve) => server.close(resolve))
+})
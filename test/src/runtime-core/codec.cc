@@ -1,7 +1,211 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
 #include "tests.hh"
 #include "src/core/codec.hh"
+#include "src/core/env.hh"
 
 namespace SSC::Tests {
+  static constexpr char LEGACY_DEC2HEX[16 + 1] = "0123456789ABCDEF";
+
+  static int legacyHexToDecimal (unsigned char character) {
+    if (character >= '0' && character <= '9') return character - '0';
+    if (character >= 'A' && character <= 'F') return character - 'A' + 10;
+    if (character >= 'a' && character <= 'f') return character - 'a' + 10;
+    return -1;
+  }
+
+  // `encodeURIComponent()` as it was before it scanned runs of safe bytes
+  static String legacyEncodeURIComponent (const String& input) {
+    String output;
+
+    for (const auto character : input) {
+      const auto byte = (unsigned char) character;
+
+      if (std::isalnum(byte) && byte < 0x80) {
+        output.push_back(character);
+      } else {
+        output.push_back('%');
+        output.push_back(LEGACY_DEC2HEX[byte >> 4]);
+        output.push_back(LEGACY_DEC2HEX[byte & 0x0F]);
+      }
+    }
+
+    return output;
+  }
+
+  // `decodeURIComponent()` as it was before it scanned runs of plain bytes
+  static String legacyDecodeURIComponent (const String& input) {
+    const auto string = replace(input, "\\+", " ");
+    const auto length = string.size();
+    String output;
+    size_t i = 0;
+
+    while (i + 2 < length) {
+      if (string[i] == '%') {
+        const auto hi = legacyHexToDecimal(string[i + 1]);
+        const auto lo = legacyHexToDecimal(string[i + 2]);
+
+        if (hi != -1 && lo != -1) {
+          output.push_back((char) ((hi << 4) + lo));
+          i += 3;
+          continue;
+        }
+      }
+
+      output.push_back(string[i++]);
+    }
+
+    while (i < length) {
+      output.push_back(string[i++]);
+    }
+
+    return output;
+  }
+
+  // `encodeHexString()` as it was before it encoded 16 bytes at a time
+  static String legacyEncodeHexString (const String& input) {
+    String output;
+    output.reserve(2 * input.size());
+
+    for (unsigned char character : input) {
+      output.push_back(LEGACY_DEC2HEX[character >> 4]);
+      output.push_back(LEGACY_DEC2HEX[character & 15]);
+    }
+
+    return output;
+  }
+
+  // `decodeHexString()` as it was before it decoded 32 characters at a time
+  static String legacyDecodeHexString (const String& input) {
+    String output;
+    output.reserve(input.size() / 2);
+
+    for (size_t i = 0; i + 1 < input.size(); i += 2) {
+      const int hi = legacyHexToDecimal(input[i]);
+      const int lo = legacyHexToDecimal(input[i + 1]);
+      output.push_back(hi << 4 | lo);
+    }
+
+    return output;
+  }
+
+  // `decodeUTF8()` as it was before it copied runs of ASCII bytes
+  static size_t legacyDecodeUTF8 (char *output, const char *input, size_t length) {
+    unsigned char cp = 0;
+    unsigned char lower = 0x80;
+    unsigned char upper = 0xBF;
+    int x = 0;
+    int y = 0;
+    size_t size = 0;
+
+    for (size_t i = 0; i < length; ++i) {
+      auto b = (unsigned char) input[i];
+
+      if (b == 0) {
+        output[size++] = 0;
+        continue;
+      }
+
+      if (x == 0) {
+        if (b <= 0x7F) {
+          output[size++] = b;
+          continue;
+        }
+
+        if (b < 0xC2 || b > 0xF4) {
+          break;
+        }
+
+        if (b <= 0xDF) {
+          x = 1;
+          cp = b - 0xC0;
+        } else if (b <= 0xEF) {
+          if (b == 0xE0) lower = 0xA0;
+          else if (b == 0xED) upper = 0x9F;
+          x = 2;
+          cp = b - 0xE0;
+        } else {
+          if (b == 0xF0) lower = 0x90;
+          else if (b == 0xF4) upper = 0x8F;
+          x = 3;
+          cp = b - 0xF0;
+        }
+
+        cp = cp * pow(64, x);
+        continue;
+      }
+
+      if (b < lower || b > upper) {
+        lower = 0x80;
+        upper = 0xBF;
+        cp = 0;
+        x = 0;
+        y = 0;
+        i--;
+        continue;
+      }
+
+      lower = 0x80;
+      upper = 0xBF;
+      y++;
+      cp += (b - 0x80) * pow(64, x - y);
+
+      if (y != x) {
+        continue;
+      }
+
+      output[size++] = cp;
+      cp = 0;
+      x = 0;
+      y = 0;
+    }
+
+    return size;
+  }
+
+  // random input of ASCII text and code points that fit in a byte, with
+  // stray continuation bytes, truncated sequences and invalid bytes
+  static String getRandomUTF8 (std::mt19937& random) {
+    static const String alphabet = "abcdefghij ABCDEF 0123 \x00\x7f\xc2\xc3\xc3\x80\xa9\xbf\xff";
+    auto length = std::uniform_int_distribution<size_t>(0, 120)(random);
+    auto pick = std::uniform_int_distribution<size_t>(0, alphabet.size() - 1);
+    String output;
+
+    for (size_t i = 0; i < length; ++i) {
+      output.push_back(alphabet[pick(random)]);
+    }
+
+    return output;
+  }
+
+  static String getRandomBytes (std::mt19937& random, size_t length) {
+    auto byte = std::uniform_int_distribution<int>(0, 255);
+    String output;
+
+    for (size_t i = 0; i < length; ++i) {
+      output.push_back((char) byte(random));
+    }
+
+    return output;
+  }
+
+  // random input that is mostly characters with a meaning in URI components
+  static String getRandomURIComponent (std::mt19937& random) {
+    static const String alphabet = "%%%+++0123456789abcdefABCDEFxyzXYZ \x00\x7f\x80\xc3\xa9\xff.-_~";
+    auto length = std::uniform_int_distribution<size_t>(0, 80)(random);
+    auto pick = std::uniform_int_distribution<size_t>(0, alphabet.size() - 1);
+    String output;
+
+    for (size_t i = 0; i < length; ++i) {
+      output.push_back(alphabet[pick(random)]);
+    }
+
+    return output;
+  }
+
   void codec (Harness& t) {
     t.test("SSC::encodeURIComponent", [](auto t) {
       const auto encoded = SSC::encodeURIComponent(
@@ -31,6 +235,75 @@ namespace SSC::Tests {
       );
     });
 
+    t.test("SSC::decodeURIComponent in place", [](auto t) {
+      char buffer[] = "a+b%20c%2x%4";
+      const auto size = SSC::decodeURIComponent(buffer, buffer, sizeof(buffer) - 1);
+
+      t.equals(String(buffer, size), "a b c%2x%4", "decodes into the input buffer");
+
+      String output(32, '\0');
+      const auto input = String("%E2%9C%93 ok");
+      output.resize(SSC::decodeURIComponent(output.data(), input.data(), input.size()));
+      t.equals(output, "\xe2\x9c\x93 ok", "decodes into a caller buffer");
+    });
+
+    t.test("SSC::encodeURIComponent and SSC::decodeURIComponent fuzz", [](auto t) {
+      static constexpr int iterations = 20000;
+      std::mt19937 random(0x5ee7);
+      int encoded = 0;
+      int decoded = 0;
+      int roundtrips = 0;
+      int inplace = 0;
+
+      for (int i = 0; i < iterations; ++i) {
+        const auto input = getRandomURIComponent(random);
+        auto buffer = input;
+        buffer.resize(SSC::decodeURIComponent(buffer.data(), buffer.data(), buffer.size()));
+
+        encoded += SSC::encodeURIComponent(input) == legacyEncodeURIComponent(input);
+        decoded += SSC::decodeURIComponent(input) == legacyDecodeURIComponent(input);
+        roundtrips += SSC::decodeURIComponent(SSC::encodeURIComponent(input)) == input;
+        inplace += buffer == legacyDecodeURIComponent(input);
+      }
+
+      t.equals((int64_t) encoded, (int64_t) iterations, "encoding matches the previous implementation");
+      t.equals((int64_t) decoded, (int64_t) iterations, "decoding matches the previous implementation");
+      t.equals((int64_t) roundtrips, (int64_t) iterations, "decoding reverses encoding");
+      t.equals((int64_t) inplace, (int64_t) iterations, "decoding in place matches");
+    });
+
+    t.test("SSC::encodeURIComponent and SSC::decodeURIComponent benchmark", [](auto t) {
+      static constexpr int iterations = 200;
+      String value;
+
+      // an IPC value: mostly plain text with some escaped characters
+      for (int i = 0; i < 4096; ++i) {
+        value += "{\"name\":\"file-" + std::to_string(i) + "\",\"size\":" + std::to_string(i * 31) + "}";
+      }
+
+      const auto encoded = SSC::encodeURIComponent(value);
+      size_t size = 0;
+
+      auto measure = [&](auto fn) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+          size += fn().size();
+        }
+
+        auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return std::to_string(value.size() * iterations / seconds / 1e6) + " MB/s";
+      };
+
+      auto legacyEncode = measure([&]() { return legacyEncodeURIComponent(value); });
+      auto encode = measure([&]() { return SSC::encodeURIComponent(value); });
+      auto legacyDecode = measure([&]() { return legacyDecodeURIComponent(encoded); });
+      auto decode = measure([&]() { return SSC::decodeURIComponent(encoded); });
+
+      t.assert(size > 0, "values are encoded and decoded");
+      t.comment("encodeURIComponent() before: " + legacyEncode + ", now: " + encode);
+      t.comment("decodeURIComponent() before: " + legacyDecode + ", now: " + decode);
+    });
+
     t.test("SSC::encodeHexString", [](auto t) {
       t.equals(
         SSC::encodeHexString("hello world"),
@@ -71,8 +344,160 @@ namespace SSC::Tests {
       );
     });
 
+    t.test("SSC::encodeHexString and SSC::decodeHexString fuzz", [](auto t) {
+      static constexpr int iterations = 5000;
+      std::mt19937 random(0x4e7);
+      int encoded = 0;
+      int decoded = 0;
+      int lowercase = 0;
+
+      for (int i = 0; i < iterations; ++i) {
+        const auto length = std::uniform_int_distribution<size_t>(0, 100)(random);
+        const auto input = getRandomBytes(random, length);
+        const auto hex = SSC::encodeHexString(input);
+        auto lower = hex;
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+
+        encoded += hex == legacyEncodeHexString(input);
+        decoded += SSC::decodeHexString(hex) == input;
+        lowercase += SSC::decodeHexString(lower) == input;
+      }
+
+      t.equals((int64_t) encoded, (int64_t) iterations, "encoding matches the previous implementation");
+      t.equals((int64_t) decoded, (int64_t) iterations, "decoding reverses encoding");
+      t.equals((int64_t) lowercase, (int64_t) iterations, "lowercase hex decodes as before");
+      t.equals(SSC::decodeHexString("2346F"), "#F", "ignores a trailing odd character");
+    });
+
+    t.test("SSC::encodeBase64 and SSC::decodeBase64", [](auto t) {
+      // test vectors from RFC 4648, section 10
+      t.equals(SSC::encodeBase64(""), "", "encodes ''");
+      t.equals(SSC::encodeBase64("f"), "Zg==", "encodes 'f'");
+      t.equals(SSC::encodeBase64("fo"), "Zm8=", "encodes 'fo'");
+      t.equals(SSC::encodeBase64("foo"), "Zm9v", "encodes 'foo'");
+      t.equals(SSC::encodeBase64("foob"), "Zm9vYg==", "encodes 'foob'");
+      t.equals(SSC::encodeBase64("fooba"), "Zm9vYmE=", "encodes 'fooba'");
+      t.equals(SSC::encodeBase64("foobar"), "Zm9vYmFy", "encodes 'foobar'");
+      t.equals(SSC::encodeBase64("\xfb\xff"), "+/8=", "encodes '+' and '/'");
+
+      t.equals(SSC::decodeBase64(""), "", "decodes ''");
+      t.equals(SSC::decodeBase64("Zg=="), "f", "decodes 'Zg=='");
+      t.equals(SSC::decodeBase64("Zm8="), "fo", "decodes 'Zm8='");
+      t.equals(SSC::decodeBase64("Zm9v"), "foo", "decodes 'Zm9v'");
+      t.equals(SSC::decodeBase64("Zm9vYg=="), "foob", "decodes 'Zm9vYg=='");
+      t.equals(SSC::decodeBase64("Zm9vYmE="), "fooba", "decodes 'Zm9vYmE='");
+      t.equals(SSC::decodeBase64("Zm9vYmFy"), "foobar", "decodes 'Zm9vYmFy'");
+      t.equals(SSC::decodeBase64("Zm9vYg"), "foob", "decodes without padding");
+      t.equals(SSC::decodeBase64("Zm9v!Zm9v"), "foo", "stops at a character outside of the alphabet");
+
+      std::mt19937 random(0xba5e);
+      int roundtrips = 0;
+
+      for (size_t length = 0; length < 200; ++length) {
+        const auto input = getRandomBytes(random, length);
+        roundtrips += SSC::decodeBase64(SSC::encodeBase64(input)) == input;
+      }
+
+      t.equals((int64_t) roundtrips, (int64_t) 200, "decoding reverses encoding");
+    });
+
     t.test("SSC::decodeUTF8", [](auto t) {
-      t.comment("skip: TODO(@jwerle)");
+      auto decode = [](const String& input) {
+        String output(input.size(), '\0');
+        output.resize(SSC::decodeUTF8(output.data(), input.data(), input.size()));
+        return output;
+      };
+
+      const auto text = String("an ASCII string that is longer than a 32 byte block");
+
+      t.equals(decode(""), "", "decodes ''");
+      t.equals(decode(text), text, "copies ASCII as it is");
+      t.equals(decode(text + "\xc3\xa9" + text), text + "\xe9" + text, "decodes code points after ASCII runs");
+      t.equals(decode("\xc2\x80\xc3\xbf"), "\x80\xff", "decodes 2 byte code points to bytes");
+      t.equals(decode(String("a\0b", 3)), String("a\0b", 3), "copies null bytes");
+      t.equals(decode("\xc3" "a"), "a", "drops truncated sequences");
+      t.equals(decode("ab\xff" "cd"), "ab", "stops at an invalid byte");
+      t.equals(decode("ab\x80" "cd"), "ab", "stops at a stray continuation byte");
+    });
+
+    t.test("SSC::decodeUTF8 fuzz", [](auto t) {
+      static constexpr int iterations = 20000;
+      std::mt19937 random(0x07f8);
+      int decoded = 0;
+
+      for (int i = 0; i < iterations; ++i) {
+        const auto input = getRandomUTF8(random);
+        String expected(input.size(), '\0');
+        String output(input.size(), '\0');
+
+        expected.resize(legacyDecodeUTF8(expected.data(), input.data(), input.size()));
+        output.resize(SSC::decodeUTF8(output.data(), input.data(), input.size()));
+        decoded += output == expected;
+      }
+
+      t.equals((int64_t) decoded, (int64_t) iterations, "decoding matches the previous implementation");
+    });
+
+    // configure with `SSC_CODEC_BENCHMARK_SIZES`, payload sizes in bytes,
+    // for example "64,4096,262144,4194304,67108864" to include large payloads
+    t.test("SSC codec kernels benchmark", [](auto t) {
+      const auto sizes = getBenchmarkSizes("SSC_CODEC_BENCHMARK_SIZES", "64,4096,262144");
+      // each payload size is measured over about as many bytes as the largest one
+      const auto total = std::max<size_t>(
+        4 * 1024 * 1024,
+        sizes.size() > 0 ? *std::max_element(sizes.begin(), sizes.end()) : 0
+      );
+      std::mt19937 random(0xc0dec);
+      size_t checksum = 0;
+
+      for (const auto size : sizes) {
+        const auto iterations = std::max<size_t>(1, total / std::max<size_t>(1, size));
+        const auto binary = getRandomBytes(random, size);
+        const auto hex = SSC::encodeHexString(binary);
+        const auto base64 = SSC::encodeBase64(binary);
+        // bytes as the code points of a string, mostly ASCII
+        String utf8;
+
+        for (size_t i = 0; i < size; ++i) {
+          const auto byte = (unsigned char) (i % 61 == 60 ? 0xE9 : 'a' + i % 26);
+
+          if (byte < 0x80) {
+            utf8.push_back(byte);
+          } else {
+            utf8.push_back((char) (0xC0 | byte >> 6));
+            utf8.push_back((char) (0x80 | (byte & 0x3F)));
+          }
+        }
+
+        String output(utf8.size(), '\0');
+
+        auto measure = [&](auto fn) {
+          auto start = std::chrono::steady_clock::now();
+          for (size_t i = 0; i < iterations; ++i) {
+            checksum += fn();
+          }
+
+          auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+          return std::to_string((int64_t) (size * iterations / seconds / 1e6)) + " MB/s";
+        };
+
+        auto legacyEncodeHex = measure([&]() { return legacyEncodeHexString(binary).size(); });
+        auto encodeHex = measure([&]() { return SSC::encodeHexString(binary).size(); });
+        auto legacyDecodeHex = measure([&]() { return legacyDecodeHexString(hex).size(); });
+        auto decodeHex = measure([&]() { return SSC::decodeHexString(hex).size(); });
+        auto legacyUTF8 = measure([&]() { return legacyDecodeUTF8(output.data(), utf8.data(), utf8.size()); });
+        auto utf8Decode = measure([&]() { return SSC::decodeUTF8(output.data(), utf8.data(), utf8.size()); });
+        auto encodeBase64 = measure([&]() { return SSC::encodeBase64(binary).size(); });
+        auto decodeBase64 = measure([&]() { return SSC::decodeBase64(base64).size(); });
+
+        t.comment(std::to_string(size) + " bytes:");
+        t.comment("  encodeHexString() before: " + legacyEncodeHex + ", now: " + encodeHex);
+        t.comment("  decodeHexString() before: " + legacyDecodeHex + ", now: " + decodeHex);
+        t.comment("  decodeUTF8() before: " + legacyUTF8 + ", now: " + utf8Decode);
+        t.comment("  encodeBase64(): " + encodeBase64 + ", decodeBase64(): " + decodeBase64);
+      }
+
+      t.assert(sizes.size() == 0 || checksum > 0, "payloads are encoded and decoded");
     });
 
     t.test("SSC::toBytes", [](auto t) {
@@ -0,0 +1,59 @@
+#include "tests.hh"
+
+namespace SSC::Tests {
+  void fs (Harness& t) {
+    t.test("SSC::Core::FS::DescriptorTable", [](auto t) {
+      using DescriptorTable = SSC::Core::FS::DescriptorTable;
+      using Descriptor = SSC::Core::FS::Descriptor;
+
+      DescriptorTable table;
+      auto a = new Descriptor(nullptr, 1);
+      auto b = new Descriptor(nullptr, 2);
+      auto c = new Descriptor(nullptr, 3);
+
+      table.insert(a);
+      table.insert(b);
+      table.insert(c);
+
+      t.equals(table.size(), (size_t) 3, "table.size() == 3");
+      t.assert(table.get(1) == a, "table.get(1) == a");
+      t.assert(table.get(2) == b, "table.get(2) == b");
+      t.assert(table.get(3) == c, "table.get(3) == c");
+      t.assert(table.get(4) == nullptr, "table.get(4) == nullptr");
+      t.assert(table.has(2), "table.has(2)");
+
+      t.assert(table.getWeakHandles().size() == 0, "no weak handles before marking stale");
+
+      table.setRetained(b, true);
+      table.markAllStale();
+      t.assert(table.isStale(a), "table.isStale(a)");
+      t.assert(table.isRetained(b), "table.isRetained(b)");
+
+      auto handles = table.getWeakHandles();
+      t.equals(handles.size(), (size_t) 2, "stale and unretained descriptors are weak");
+      t.assert(table.get(handles[0]) == a, "first weak handle resolves to a");
+      t.assert(table.get(handles[1]) == c, "second weak handle resolves to c");
+
+      t.assert(table.remove(1) == a, "table.remove(1) == a");
+      t.assert(table.get(1) == nullptr, "table.get(1) == nullptr after remove");
+      t.assert(table.get(handles[0]) == nullptr, "handle to a freed slot does not resolve");
+
+      auto d = new Descriptor(nullptr, 4);
+      table.insert(d);
+      t.equals((size_t) d->slot, (size_t) a->slot, "freed slot is reused");
+      t.assert(table.get(handles[0]) == nullptr, "handle to a reused slot does not resolve");
+      t.assert(!table.isStale(d), "a descriptor in a reused slot is not stale");
+
+      t.equals(table.getWeakHandles().size(), (size_t) 1, "only c is weak");
+
+      size_t count = 0;
+      table.forEach([&count](auto desc) { count++; });
+      t.equals(count, (size_t) 3, "table.forEach() visits live descriptors");
+
+      delete a;
+      delete b;
+      delete c;
+      delete d;
+    });
+  }
+}
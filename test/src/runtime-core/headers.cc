@@ -0,0 +1,124 @@
+#include <chrono>
+
+#include "tests.hh"
+#include "src/ipc/ipc.hh"
+
+namespace SSC::Tests {
+  void headers (Harness& t) {
+    t.test("SSC::Headers", [](auto t) {
+      auto headers = Headers {{
+        {"Content-Type", " application/json "},
+        {"content-length", 1024},
+        {"X-Custom", "a: b"}
+      }};
+
+      t.equals(headers.size(), (size_t) 3, "has every entry");
+      t.assert(headers.has("content-type"), "matches interned names in any case");
+      t.assert(headers.has("CONTENT-LENGTH"), "matches interned names in upper case");
+      t.assert(headers.has("x-custom"), "matches other names in any case");
+      t.assert(!headers.has("x-missing"), "does not match missing names");
+      t.assert(!headers.has("content-location"), "does not match other interned names");
+      t.equals(headers.get("CONTENT-TYPE").value.str(), "application/json", "trims string values");
+      t.equals(headers.get("X-CUSTOM").value.str(), "a: b", "keeps values with a colon");
+      t.equals(headers.get("x-missing").key, "", "returns an empty header for missing names");
+
+      headers.set("Content-Type", "text/plain");
+      headers.set("x-custom", "c");
+
+      t.equals(headers.size(), (size_t) 3, "replaces values of existing names");
+      t.equals(headers.get("content-type").value.str(), "text/plain", "replaces interned values");
+      t.equals(headers.get("X-Custom").value.str(), "c", "replaces other values");
+      t.equals(
+        headers.str(),
+        "Content-Type: text/plain\ncontent-length: 1024\nX-Custom: c",
+        "serializes entries in order"
+      );
+    });
+
+    t.test("SSC::Headers::Value", [](auto t) {
+      t.assert(Headers::Value(1024).isNumber(), "integers are numbers");
+      t.assert(Headers::Value((uint64_t) 1 << 40).isNumber(), "unsigned integers are numbers");
+      t.assert(Headers::Value(1.5).isNumber(), "doubles are numbers");
+      t.assert(!Headers::Value("1024").isNumber(), "strings are not numbers");
+      t.equals(Headers::Value(1024).number(), 1024.0, "keeps integers");
+      t.equals(Headers::Value("1024").number(), 1024.0, "parses numeric strings");
+      t.equals(Headers::Value(1024).str(), "1024", "renders integers");
+      t.equals(Headers::Value(-7).str(), std::to_string(-7), "renders negative integers");
+      t.equals(Headers::Value(1.5).str(), std::to_string(1.5), "renders doubles");
+      t.equals(Headers::Value(true).str(), "true", "renders booleans");
+      t.equals(String(Headers::Value(42).c_str()), "42", "renders C strings");
+
+      auto value = Headers::Value(1);
+      value.set(String("text"));
+      t.equals(value.str(), "text", "sets other values");
+      t.assert(!value.isNumber(), "sets other types");
+    });
+
+    t.test("SSC::Headers(const String&)", [](auto t) {
+      auto headers = Headers("Content-Type: text/html\n\n  X-Id : 42 \nDate: 10:00\ninvalid\n");
+
+      t.equals(headers.size(), (size_t) 2, "parses entries with one key and value");
+      t.equals(headers.get("content-type").value.str(), "text/html", "parses values");
+      t.equals(headers.get("x-id").value.str(), "42", "trims keys and values");
+      t.equals(Headers(headers.str()).str(), headers.str(), "parses serialized headers");
+    });
+
+    t.test("SSC::IPC::Result headers", [](auto t) {
+      auto post = Post {};
+      post.headers = Headers {{
+        {"content-type", "application/octet-stream"},
+        {"content-length", 2048}
+      }};
+
+      const auto message = IPC::Message("ipc://test?seq=1");
+      const auto result = IPC::Result(message.seq, message, JSON::null, post);
+      const auto& length = result.headers.get("Content-Length").value;
+
+      t.equals(result.headers.size(), (size_t) 2, "takes the headers of the post");
+      t.assert(length.isNumber(), "keeps numbers from the post");
+      t.equals(length.number(), 2048.0, "keeps number values from the post");
+    });
+
+    t.test("SSC::Headers benchmark", [](auto t) {
+      static constexpr int iterations = 20000;
+      size_t size = 0;
+
+      auto measure = [&](auto fn) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+          size += fn();
+        }
+
+        auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+        return std::to_string(elapsed.count() / iterations) + " us";
+      };
+
+      // a post as `fs.read` makes it, then read back as a result does
+      auto roundtrip = measure([]() {
+        auto headers = Headers {{
+          {"content-type", "application/octet-stream"},
+          {"content-length", 65536}
+        }};
+
+        auto serialized = headers.str();
+        return Headers(serialized).get("content-length").value.str().size();
+      });
+
+      auto copied = measure([]() {
+        auto headers = Headers {{
+          {"content-type", "application/octet-stream"},
+          {"content-length", 65536}
+        }};
+
+        auto post = Post {};
+        post.headers = std::move(headers);
+        auto copy = post.headers;
+        return copy.get("content-length").value.str().size();
+      });
+
+      t.assert(size > 0, "headers are read");
+      t.comment("headers through a string: " + roundtrip);
+      t.comment("headers kept in the post: " + copied);
+    });
+  }
+}
@@ -0,0 +1,150 @@
+#include <cstdlib>
+#include <new>
+
+#include "tests.hh"
+#include "src/ipc/ipc.hh"
+
+namespace SSC::Tests {
+  // allocations are only counted on the thread that is counting them
+  static thread_local bool countingAllocations = false;
+  static thread_local size_t allocations = 0;
+
+  template <typename Function> static size_t countAllocations (Function fn) {
+    allocations = 0;
+    countingAllocations = true;
+    fn();
+    countingAllocations = false;
+    return allocations;
+  }
+
+  // replies are handled on the calling thread, the event loop of the core is
+  // never started
+  static IPC::Router* getRouter () {
+    static auto bridge = new IPC::Bridge(new Core());
+    bridge->router.dispatchFunction = [](auto callback) { callback(); };
+    return &bridge->router;
+  }
+
+  // replies to `test.read` as `fs.read` does for a read of `size` bytes
+  static void onRead (
+    const IPC::Message& message,
+    IPC::Router* router,
+    IPC::Router::ReplyCallback reply
+  ) {
+    auto size = std::stoi(message.get("size"));
+    auto post = Post {};
+
+    post.id = rand64();
+    post.body = new char[size]{0}; // freed by the router after the reply
+    post.length = size;
+    post.headers = Headers {{
+      {"content-type", "application/octet-stream"},
+      {"content-length", size}
+    }};
+
+    reply(IPC::Result::Data { message, nullptr, std::move(post) });
+  }
+}
+
+// Counts the allocations of this extension. The linker flags in socket.ini
+// bind the extension to these instead of the ones loaded with the runtime.
+void* operator new (size_t size) {
+  if (SSC::Tests::countingAllocations) {
+    SSC::Tests::allocations++;
+  }
+
+  if (auto pointer = std::malloc(size > 0 ? size : 1)) {
+    return pointer;
+  }
+
+  throw std::bad_alloc();
+}
+
+void operator delete (void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete (void* pointer, size_t size) noexcept {
+  std::free(pointer);
+}
+
+namespace SSC::Tests {
+  void ipc (Harness& t) {
+    t.test("SSC::IPC::Message", [](auto t) {
+      const auto uri = String("ipc://fs.read?id=1234&seq=R42&size=65536&value=hello%20world");
+      const auto message = IPC::Message(uri, true);
+
+      t.equals(message.name, "fs.read", "parses the name");
+      t.equals(message.seq, "R42", "parses the sequence");
+      t.equals(message.value, "hello world", "decodes the value");
+      t.equals(message.get("size"), "65536", "parses arguments");
+      t.equals(message.uri(), uri, "keeps the URI");
+      t.assert(message.has("id"), "has arguments");
+      t.assert(!message.has("missing"), "does not have missing arguments");
+      t.equals(IPC::Message().uri(), "", "empty messages have no URI");
+      t.equals(IPC::Message().args().size(), (size_t) 0, "empty messages have no arguments");
+
+      auto copy = message;
+      t.assert(copy.state == message.state, "copies share parsed state");
+
+      auto moved = std::move(copy);
+      t.equals(moved.get("id"), "1234", "moves parsed state");
+    });
+
+    t.test("SSC::IPC round trip allocations", [](auto t) {
+    #if !defined(__linux__) && !defined(__ANDROID__)
+      // socket.ini only binds `operator new` to this extension on linux and
+      // android, elsewhere the counted allocations are not this extension's
+      t.comment("skip: allocations are only counted on linux and android");
+      return;
+    #endif
+
+      // calls to `operator new` itself are never elided
+      auto counted = countAllocations([]() {
+        ::operator delete(::operator new(16));
+      });
+
+      if (!t.equals(counted, (size_t) 1, "allocations are counted")) {
+        return;
+      }
+
+      const auto message = IPC::Message("ipc://test.read?id=1234&seq=R42&size=65536", true);
+      IPC::Message copy;
+      size_t size = 0;
+
+      const auto copies = countAllocations([&]() {
+        for (int i = 0; i < 100; ++i) {
+          copy = message;
+          auto moved = std::move(copy);
+          size += moved.seq.size();
+        }
+      });
+
+      t.equals(copies, (size_t) 0, "copying and moving a message does not allocate");
+
+      auto router = getRouter();
+      auto invoke = [&]() {
+        return router->invoke(message.uri(), [&size](const auto& result) {
+          size += result.post.length;
+        });
+      };
+
+      router->map("test.read", onRead);
+      // the first message to a route adds its listener entries
+      t.assert(invoke(), "routes a message");
+
+      size = 0;
+      const auto replies = countAllocations([&]() {
+        for (int i = 0; i < 100; ++i) {
+          invoke();
+        }
+      });
+
+      router->unmap("test.read");
+
+      t.equals(size, (size_t) 100 * 65536, "every message is replied to");
+      t.assert(replies <= 100 * 24, "a round trip allocates a bounded number of times");
+      t.comment("allocations for a round trip: " + std::to_string(replies / 100.0));
+    });
+  }
+}
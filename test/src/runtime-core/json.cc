@@ -1,9 +1,142 @@
+#include <chrono>
+#include <clocale>
+#include <regex>
+
 #include "tests.hh"
 
 namespace SSC::Tests {
+  // `str()` as it was before `JSON::Writer`, for benchmarks
+  static String legacyStr (const JSON::Any& value) {
+    if (value.type == JSON::Type::Object) {
+      std::stringstream stream;
+      const auto& entries = value.as<JSON::Object>().data;
+      auto count = entries.size();
+      stream << String("{");
+
+      for (const auto& tuple : entries) {
+        auto key = std::regex_replace(tuple.first, std::regex("\""), "\\\"");
+        stream << String("\"") << key << String("\":") << legacyStr(tuple.second);
+
+        if (--count > 0) {
+          stream << String(",");
+        }
+      }
+
+      stream << String("}");
+      return stream.str();
+    }
+
+    if (value.type == JSON::Type::Array) {
+      std::stringstream stream;
+      const auto& entries = value.as<JSON::Array>().data;
+      auto count = entries.size();
+      stream << String("[");
+
+      for (const auto& entry : entries) {
+        stream << legacyStr(entry);
+
+        if (--count > 0) {
+          stream << String(",");
+        }
+      }
+
+      stream << String("]");
+      return stream.str();
+    }
+
+    if (value.type == JSON::Type::String) {
+      const auto& data = value.as<JSON::String>().data;
+      auto escaped = std::regex_replace(data, std::regex("\""), "\\\"");
+      return "\"" + std::regex_replace(escaped, std::regex("\n"), "\\n") + "\"";
+    }
+
+    if (value.type == JSON::Type::Number) {
+      auto number = value.as<JSON::Number>().data;
+
+      if (number == 0) {
+        return "0";
+      }
+
+      auto output = std::to_string(number);
+      auto decimal = output.find(".");
+      auto i = output.size() - 1;
+
+      while (output[i] == '0' && i >= decimal) {
+        i--;
+      }
+
+      return output.substr(0, i);
+    }
+
+    return value.str();
+  }
+
+  // an `fs.readdir` reply for a directory of `count` entries
+  static JSON::Any getReaddirReply (int count) {
+    JSON::Array::Entries entries;
+
+    for (int i = 0; i < count; ++i) {
+      entries.push_back(JSON::Object::Entries {
+        {"name", "file-" + std::to_string(i) + ".txt"},
+        {"type", i % 3}
+      });
+    }
+
+    return JSON::Object::Entries {
+      {"source", "fs.readdir"},
+      {"data", entries}
+    };
+  }
+
+  // records the events of a document, stopping at `stop` if it is set
+  class EventLog : public JSON::Visitor {
+    public:
+      Vector<String> events;
+      String stop;
+
+      bool record (const String& event) {
+        this->events.push_back(event);
+        return event != this->stop;
+      }
+
+      bool onNull () override { return this->record("null"); }
+      bool onBoolean (bool value) override { return this->record(value ? "true" : "false"); }
+      bool onNumber (double value) override { return this->record(JSON::Number(value).str()); }
+      bool onString (std::string_view value) override { return this->record("\"" + String(value) + "\""); }
+      bool onKey (std::string_view key) override { return this->record(String(key) + ":"); }
+      bool onObjectStart () override { return this->record("{"); }
+      bool onObjectEnd () override { return this->record("}"); }
+      bool onArrayStart () override { return this->record("["); }
+      bool onArrayEnd () override { return this->record("]"); }
+  };
+
   void json (Harness& t) {
     t.test("SSC::JSON::Any", [](auto t) {
-      t.comment("TODO");
+      JSON::Any number = 42;
+      JSON::Any string = "short";
+      JSON::Any object = JSON::Object::Entries {{"key", "value"}};
+
+      t.assert(number.isNumber(), "numbers are numbers");
+      t.equals(number.as<JSON::Number>().data, 42.0, "numbers are stored inline");
+      t.assert(number.pointer() != nullptr, "inline values have an address");
+      t.equals(string.as<JSON::String>().data, String("short"), "strings are stored inline");
+      t.assert(JSON::Any().isNull(), "default value is null");
+
+      auto copy = object;
+      copy.as<JSON::Object>()["other"] = true;
+      t.equals(object.str(), "{\"key\":\"value\",\"other\":true}", "copies share objects");
+
+      auto moved = std::move(copy);
+      t.equals(moved.str(), object.str(), "moves keep the value");
+
+      auto thrown = false;
+      try {
+        number.as<JSON::String>();
+      } catch (const JSON::Error& error) {
+        thrown = error.name == "BadCastError";
+      }
+
+      t.assert(thrown, "casting to another type throws");
     });
 
     t.test("SSC::JSON::Raw", [](auto t) {
@@ -15,11 +148,40 @@ namespace SSC::Tests {
     });
 
     t.test("SSC::JSON::Object", [](auto t) {
-      t.comment("TODO");
+      auto entries = JSON::Object::Entries {
+        {"b", 2},
+        {"a", 1},
+        {"c", nullptr}
+      };
+
+      t.equals(entries.size(), (size_t) 3, "entries from an initializer list");
+      t.equals(entries.begin()->first, String("a"), "entries are sorted by key");
+      t.assert(entries.find("b") != entries.end(), "finds keys");
+      t.assert(entries.find("d") == entries.end(), "missing keys are not found");
+
+      auto duplicates = JSON::Object::Entries {{"a", 1}, {"a", 2}};
+      t.equals(duplicates.size(), (size_t) 1, "duplicate keys are kept once");
+      t.equals(JSON::Object(duplicates).str(), "{\"a\":1}", "the first of duplicate keys wins");
+
+      entries["d"] = "appended";
+      entries["aa"] = "inserted";
+      entries.insert_or_assign("a", 3);
+      t.equals(JSON::Object(entries).str(), "{\"a\":3,\"aa\":\"inserted\",\"b\":2,\"c\":null,\"d\":\"appended\"}", "keeps keys in order");
+      t.equals(entries.erase("aa"), (size_t) 1, "erases keys");
+
+      auto object = JSON::Object(std::map<String, String> {{"y", "2"}, {"x", "1"}});
+      t.assert(object.has("x"), "objects from maps");
+      t.equals(object.get("y").as<JSON::String>().data, String("2"), "gets values");
+      t.assert(object["z"].isNull(), "missing values are null");
     });
 
     t.test("SSC::JSON::Array", [](auto t) {
-      t.comment("TODO");
+      auto array = JSON::Array(JSON::Array::Entries { 1, "two" });
+      array.push(true);
+      t.equals(array.str(), "[1,\"two\",true]", "pushes values");
+      t.equals(array.pop().str(), "true", "pops the last value");
+      t.equals(array.size(), (size_t) 2, "pop removes the value");
+      t.assert(array.get(5).isNull(), "missing values are null");
     });
 
     t.test("SSC::JSON::Boolean", [](auto t) {
@@ -27,11 +189,295 @@ namespace SSC::Tests {
     });
 
     t.test("SSC::JSON::Number", [](auto t) {
-      t.comment("TODO");
+      t.equals(JSON::Number(0).str(), "0", "zero");
+      t.equals(JSON::Number(42).str(), "42", "integer");
+      t.equals(JSON::Number(-7).str(), "-7", "negative integer");
+      t.equals(JSON::Number(1.5).str(), "1.5", "fraction");
+      t.equals(JSON::Number(0.1).str(), "0.1", "shortest fraction");
+      t.equals(JSON::Number(9007199254740991.0).str(), "9007199254740991", "largest exact integer");
+      t.equals(JSON::Number(std::nan("")).str(), "null", "NaN is null");
+      t.equals(JSON::Number(INFINITY).str(), "null", "infinity is null");
+
+      // numbers are written and read with a '.' whatever the locale
+      auto locale = String(setlocale(LC_NUMERIC, nullptr));
+      if (setlocale(LC_NUMERIC, "de_DE.UTF-8") != nullptr) {
+        t.equals(JSON::Number(0.25).str(), "0.25", "fraction in a ',' locale");
+        t.equals(JSON::parse("0.25").as<JSON::Number>().data, 0.25, "parses a fraction in a ',' locale");
+        setlocale(LC_NUMERIC, locale.c_str());
+      } else {
+        t.comment("skip: the de_DE.UTF-8 locale is not installed");
+      }
     });
 
     t.test("SSC::JSON::String", [](auto t) {
-      t.comment("TODO");
+      t.equals(JSON::String("hello").str(), "\"hello\"", "plain string");
+      t.equals(JSON::String("a\"b").str(), "\"a\\\"b\"", "quote is escaped");
+      t.equals(JSON::String("a\\b").str(), "\"a\\\\b\"", "backslash is escaped");
+      t.equals(JSON::String("\n\r\t\b\f").str(), "\"\\n\\r\\t\\b\\f\"", "short escapes");
+      t.equals(JSON::String(String("\x01\x1f", 2)).str(), "\"\\u0001\\u001f\"", "control characters");
+      t.equals(JSON::String(String("a\0b", 3)).str(), "\"a\\u0000b\"", "null character");
+      t.equals(JSON::String("caf\xc3\xa9").str(), "\"caf\xc3\xa9\"", "UTF-8 is unchanged");
+    });
+
+    t.test("SSC::JSON::Writer", [](auto t) {
+      JSON::Writer writer(256);
+      auto value = JSON::Any(JSON::Object::Entries {
+        {"array", JSON::Array::Entries { 1, "two", true, nullptr }},
+        {"key\n", JSON::Object::Entries {{"nested", 2.5}}},
+        {"raw", JSON::Raw("{\"a\":1}")}
+      });
+
+      writer.write(value);
+      t.equals(
+        writer.str(),
+        "{\"array\":[1,\"two\",true,null],\"key\\n\":{\"nested\":2.5},\"raw\":{\"a\":1}}",
+        "writes nested values"
+      );
+
+      auto capacity = writer.output.capacity();
+      writer.reset();
+      t.equals(writer.str(), "", "reset clears the output");
+      t.equals(writer.output.capacity(), capacity, "reset keeps the buffer");
+
+      writer.write(JSON::Array());
+      writer.output.push_back(',');
+      writer.write(JSON::Object());
+      t.equals(writer.str(), "[],{}", "appends to the output");
+      t.equals(value.str(), JSON::Any(value).str(), "str() uses the writer");
+    });
+
+    t.test("SSC::JSON::Writer benchmark", [](auto t) {
+      static constexpr int iterations = 200;
+      auto reply = getReaddirReply(1000);
+      JSON::Writer writer;
+      size_t size = 0;
+
+      t.equals(reply.str(), legacyStr(reply), "output matches str() before the writer");
+
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < iterations; ++i) {
+        size += legacyStr(reply).size();
+      }
+
+      auto legacy = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      start = std::chrono::steady_clock::now();
+      for (int i = 0; i < iterations; ++i) {
+        size += reply.str().size();
+      }
+
+      auto current = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      start = std::chrono::steady_clock::now();
+      for (int i = 0; i < iterations; ++i) {
+        writer.reset();
+        writer.write(reply);
+        size += writer.str().size();
+      }
+
+      auto reused = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      t.assert(size > 0, "replies are serialized");
+      t.comment(
+        "fs.readdir reply of 1000 entries x " + std::to_string(iterations) + ": " +
+        "str() before the writer " + std::to_string(legacy * 1000) + " ms, " +
+        "str() " + std::to_string(current * 1000) + " ms, " +
+        "reused writer " + std::to_string(reused * 1000) + " ms"
+      );
+    });
+
+    t.test("SSC::JSON::Any benchmark", [](auto t) {
+      static constexpr int iterations = 200;
+      size_t count = 0;
+
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < iterations; ++i) {
+        count += getReaddirReply(1000).as<JSON::Object>().size();
+      }
+
+      auto built = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      auto reply = getReaddirReply(1000);
+      start = std::chrono::steady_clock::now();
+      for (int i = 0; i < iterations; ++i) {
+        auto copy = reply;
+        count += copy.as<JSON::Object>().size();
+      }
+
+      auto copied = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      t.assert(count > 0, "replies are built");
+      t.comment(
+        "fs.readdir reply of 1000 entries x " + std::to_string(iterations) + ": " +
+        "built in " + std::to_string(built * 1000) + " ms, " +
+        "copied in " + std::to_string(copied * 1000) + " ms, " +
+        std::to_string(sizeof(JSON::Any)) + " bytes per value"
+      );
+    });
+
+    t.test("SSC::JSON::parse", [](auto t) {
+      auto source = String(
+        " {\"array\": [1, -2.5e3, true, false, null], "
+        "\"nested\": {\"empty\": {}, \"list\": []}, "
+        "\"string\": \"a\\\"b\\\\c\\n\\u00e9\\ud83d\\ude00\"} "
+      );
+
+      auto value = JSON::parse(source);
+      t.equals(
+        value.str(),
+        "{\"array\":[1,-2500,true,false,null],\"nested\":{\"empty\":{},\"list\":[]},"
+        "\"string\":\"a\\\"b\\\\c\\n\xc3\xa9\xf0\x9f\x98\x80\"}",
+        "parses nested values"
+      );
+
+      auto reply = getReaddirReply(100);
+      t.equals(JSON::parse(reply.str()).str(), reply.str(), "round trips a reply");
+      t.equals(JSON::parse("0.1").as<JSON::Number>().data, 0.1, "parses fractions");
+      t.equals(JSON::parse("1e2").as<JSON::Number>().data, 100.0, "parses exponents");
+      t.equals(JSON::parse("-0").as<JSON::Number>().data, 0.0, "parses negative zero");
+      t.equals(JSON::parse("9007199254740993").str(), "9007199254740992", "large integers are doubles");
+      t.assert(JSON::parse("1e400").as<JSON::Number>().data == INFINITY, "overflows to infinity");
+      t.assert(JSON::parse("-1e400").as<JSON::Number>().data == -INFINITY, "overflows to negative infinity");
+      t.equals(JSON::parse("1e-400").as<JSON::Number>().data, 0.0, "underflows to zero");
+      t.equals(JSON::parse("\"\"").as<JSON::String>().data, String(""), "parses empty strings");
+
+      auto invalid = Vector<String> {
+        "", "{", "[1,]", "{\"a\" 1}", "{a: 1}", "01", "1.", "1e", "-", ".5",
+        "tru", "nul", "1 2", "\"abc", "\"\\x\"", "\"\\u12\"", String("\"a\nb\""),
+        "[1 2]", "{\"a\":1,}"
+      };
+
+      for (const auto& input : invalid) {
+        auto thrown = false;
+
+        try {
+          JSON::parse(input);
+        } catch (const JSON::Error& error) {
+          thrown = error.name == "SyntaxError";
+        }
+
+        t.assert(thrown, "throws a SyntaxError for " + JSON::String(input).str());
+      }
+
+      auto depth = JSON::MAX_PARSE_DEPTH;
+      auto deep = String(depth, '[') + String(depth, ']');
+      t.assert(JSON::parse(deep).isArray(), "parses the maximum depth");
+
+      auto thrown = false;
+      try {
+        JSON::parse("[" + deep + "]");
+      } catch (const JSON::Error& error) {
+        thrown = true;
+      }
+
+      t.assert(thrown, "throws past the maximum depth");
+    });
+
+    t.test("SSC::JSON::parse with a visitor", [](auto t) {
+      auto source = String("{\"a\":[1,\"x\\ty\",null],\"b\":{\"c\":true}}");
+      EventLog log;
+
+      t.assert(JSON::parse(source, log), "visits the whole document");
+      t.equals(
+        join(log.events, " "),
+        String("{ a: [ 1 \"x\ty\" null ] b: { c: true } }"),
+        "reports events in document order"
+      );
+
+      EventLog stopped;
+      stopped.stop = "null";
+      t.assert(!JSON::parse(source, stopped), "returns false when stopped");
+      t.equals(join(stopped.events, " "), String("{ a: [ 1 \"x\ty\" null"), "stops early");
+    });
+
+    t.test("SSC::JSON::pick", [](auto t) {
+      auto source = String("{\"source\":\"fs.stat\",\"data\":{\"size\":42},\"tail\":");
+
+      t.equals(JSON::pick(source, "source").str(), "\"fs.stat\"", "picks a string");
+      t.equals(JSON::pick(source, "data").str(), "{\"size\":42}", "picks an object");
+      t.assert(JSON::pick("{\"a\":1}", "b").isNull(), "missing keys are null");
+
+      auto thrown = false;
+      try {
+        JSON::pick(source, "missing");
+      } catch (const JSON::Error& error) {
+        thrown = true;
+      }
+
+      t.assert(thrown, "only the document before the key is read");
+    });
+
+    t.test("sapi_json_object_get", [](auto t) {
+      auto context = sapi_context_create(nullptr, true);
+      auto object = sapi_json_object_create(context);
+      auto array = sapi_json_array_create(context);
+
+      sapi_json_object_set(object, "b", sapi_json_number_create(context, 2));
+      sapi_json_array_push(array, sapi_json_string_create(context, "first"));
+
+      auto number = sapi_json_object_get(object, "b");
+      auto string = sapi_json_array_get(array, 0);
+
+      // shifts the entries of `object` and reallocates the entries of `array`
+      for (int i = 0; i < 64; ++i) {
+        auto key = "a" + std::to_string(i);
+        sapi_json_object_set(object, key.c_str(), sapi_json_number_create(context, i));
+        sapi_json_array_push(array, sapi_json_number_create(context, i));
+      }
+
+      sapi_json_object_set(object, "b", sapi_json_number_create(context, 3));
+
+      t.equals(sapi_json_stringify(number), "2", "values are kept after inserting into an object");
+      t.equals(sapi_json_stringify(string), "\"first\"", "values are kept after pushing to an array");
+      t.equals(sapi_json_stringify(sapi_json_object_get(object, "b")), "3", "gets the current value");
+      t.assert(sapi_json_object_get(object, "missing") == nullptr, "missing keys are NULL");
+      t.assert(sapi_json_array_get(array, 65) == nullptr, "missing indices are NULL");
+
+      sapi_context_release(context);
+    });
+
+    t.test("sapi_json_parse", [](auto t) {
+      auto context = sapi_context_create(nullptr, true);
+      auto value = sapi_json_parse(context, "{\"a\": [1, \"b\", null], \"c\": 1e400}");
+
+      t.assert(value != nullptr, "parses a document");
+      t.assert(sapi_json_typeof(value) == SAPI_JSON_TYPE_OBJECT, "parses an object");
+      t.equals(sapi_json_stringify(value), "{\"a\":[1,\"b\",null],\"c\":null}", "round trips");
+      t.assert(sapi_json_parse(context, nullptr) == nullptr, "NULL sources are NULL");
+      t.assert(sapi_json_parse(context, "{\"a\":") == nullptr, "invalid sources are NULL");
+      t.equals(sapi_context_error_get_name(context), "SyntaxError", "sets a SyntaxError");
+      t.assert(strlen(sapi_context_error_get_message(context)) > 0, "sets an error message");
+
+      sapi_context_release(context);
+    });
+
+    t.test("SSC::JSON::parse benchmark", [](auto t) {
+      static constexpr int iterations = 200;
+      auto source = getReaddirReply(1000).str();
+      size_t count = 0;
+
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < iterations; ++i) {
+        count += JSON::parse(source).as<JSON::Object>().data.size();
+      }
+
+      auto parsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      start = std::chrono::steady_clock::now();
+      for (int i = 0; i < iterations; ++i) {
+        count += JSON::pick(source, "source").type == JSON::Type::String;
+      }
+
+      auto picked = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      t.assert(count > 0, "replies are parsed");
+      t.comment(
+        "fs.readdir reply of " + std::to_string(source.size()) + " bytes x " +
+        std::to_string(iterations) + ": " +
+        "parse() " + std::to_string(parsed * 1000) + " ms " +
+        "(" + std::to_string(source.size() * iterations / parsed / 1e6) + " MB/s), " +
+        "pick() " + std::to_string(picked * 1000) + " ms"
+      );
     });
   }
 }
@@ -7,11 +7,16 @@ static bool initialize (sapi_context_t* context, const void *data) {
     t.run(SSC::Tests::codec);
     t.run(SSC::Tests::config);
     t.run(SSC::Tests::env);
+    t.run(SSC::Tests::fs);
+    t.run(SSC::Tests::headers);
     t.run(SSC::Tests::ini);
+    t.run(SSC::Tests::ipc);
     t.run(SSC::Tests::json);
     t.run(SSC::Tests::platform);
     t.run(SSC::Tests::preload);
+    t.run(SSC::Tests::random);
     t.run(SSC::Tests::string);
+    t.run(SSC::Tests::udp);
     t.run(SSC::Tests::version);
   });
 }
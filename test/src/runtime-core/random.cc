@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+
+#include "tests.hh"
+
+#define IMAX_BITS(m) ((m)/((m) % 255+1) / 255 % 255 * 8 + 7-86 / ((m) % 255+12))
+#define RAND_MAX_WIDTH IMAX_BITS(RAND_MAX)
+
+namespace SSC::Tests {
+  // `rand64()` as it was before each thread had its own generator
+  static uint64_t legacyRand64 () {
+    static bool init = false;
+    uint64_t r = 0;
+
+    if (!init) {
+      init = true;
+      srand(time(0));
+    }
+
+    for (int i = 0; i < 64; i += RAND_MAX_WIDTH) {
+      r <<= RAND_MAX_WIDTH;
+      r ^= (unsigned) ::rand();
+    }
+
+    return r;
+  }
+
+  // ids made by `threads` threads at once, each making `count` of them
+  template <typename Function>
+  static Vector<uint64_t> generate (int threads, int count, Function fn, double& seconds) {
+    Vector<uint64_t> ids(threads * count);
+    Vector<Thread> workers;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < threads; ++i) {
+      workers.emplace_back([&ids, count, fn, i]() {
+        for (int j = 0; j < count; ++j) {
+          ids[i * count + j] = fn();
+        }
+      });
+    }
+
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return ids;
+  }
+
+  static size_t countDuplicates (Vector<uint64_t> ids) {
+    std::sort(ids.begin(), ids.end());
+    return ids.size() - (std::unique(ids.begin(), ids.end()) - ids.begin());
+  }
+
+  void random (Harness& t) {
+    t.test("SSC::rand64()", [](auto t) {
+      static constexpr int count = 100000;
+      double seconds = 0;
+      const auto ids = generate(1, count, rand64, seconds);
+      size_t highBits = 0;
+
+      for (const auto id : ids) {
+        highBits += id >> 63;
+      }
+
+      t.assert(std::find(ids.begin(), ids.end(), 0) == ids.end(), "ids are never 0");
+      t.equals(countDuplicates(ids), (size_t) 0, "ids are unique");
+      t.assert(highBits > count * 0.45 && highBits < count * 0.55, "ids use all 64 bits");
+    });
+
+    t.test("SSC::rand64() across threads", [](auto t) {
+      static constexpr int threads = 8;
+      static constexpr int count = 50000;
+      double seconds = 0;
+      const auto ids = generate(threads, count, rand64, seconds);
+
+      t.equals(countDuplicates(ids), (size_t) 0, "threads do not share a sequence");
+    });
+
+    t.test("SSC::rand64() contention benchmark", [](auto t) {
+      static constexpr int threads = 8;
+      static constexpr int count = 200000;
+      double legacySeconds = 0;
+      double seconds = 0;
+
+      generate(threads, count, legacyRand64, legacySeconds);
+      const auto ids = generate(threads, count, rand64, seconds);
+      const auto total = (double) threads * count;
+
+      t.assert(ids.size() == total, "ids are generated");
+      t.comment(
+        "8 threads, rand64() before: " + std::to_string(total / legacySeconds / 1e6) + " M ids/s" +
+        ", now: " + std::to_string(total / seconds / 1e6) + " M ids/s"
+      );
+    });
+  }
+}
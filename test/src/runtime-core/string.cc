@@ -1,17 +1,92 @@
+#include <chrono>
+#include <regex>
+
 #include "tests.hh"
 
 namespace SSC::Tests {
+  // `tmpl()` as it was before it stopped using regular expressions
+  static String legacyTmpl (const String& source, const Map& variables) {
+    String output = source;
+
+    for (const auto& tuple : variables) {
+      auto key = String("[{]+(" + tuple.first + ")[}]+");
+      output = std::regex_replace(output, std::regex(key), tuple.second);
+    }
+
+    return output;
+  }
+
+  // the average time of `iterations` calls of `fn` in microseconds
+  template <typename Function> static double measure (int iterations, Function fn) {
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; ++i) {
+      fn();
+    }
+
+    auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+    return elapsed.count() / iterations;
+  }
+
   void string (Harness& t) {
     t.test("SSC::replace()", [](auto t) {
-      t.comment("TODO");
+      t.equals(replace("a+b+c", "\\+", " "), "a b c", "escaped punctuation is literal");
+      t.equals(replace("a.b.c", "\\.", "/"), "a/b/c", "escaped dots are literal");
+      t.equals(replace("C:\\a\\b", "\\\\", "/"), "C:/a/b", "escaped backslashes are literal");
+      t.equals(replace("ctrl+a", "ctrl", "control"), "control+a", "plain text is literal");
+      t.equals(replace("a1b22c", "[0-9]+", "-"), "a-b-c", "patterns are regular expressions");
+      t.equals(replace("abc", "b", "[$&]"), "a[b]c", "replacements can refer to the match");
+      t.equals(replace("a.b", ".", "x"), "xxx", "unescaped dots match any character");
+      t.equals(replace("a+b", std::regex("\\+"), "-"), "a-b", "compiled patterns");
+      t.equals(replace("a\\b\\c", '\\', '/'), "a/b/c", "replaces characters");
+      t.equals(replaceAll("a.b.c", ".", "::"), "a::b::c", "replaces text");
+      t.equals(replaceAll("aaa", "aa", "b"), "ba", "replaces text without overlap");
+      t.equals(replaceAll("abc", "", "x"), "abc", "empty text is not replaced");
+      t.equals(replaceAll("abc", "d", "x"), "abc", "missing text is not replaced");
     });
 
     t.test("SSC::tmpl()", [](auto t) {
-      t.comment("TODO");
+      auto variables = Map {{"name", "socket"}, {"version", "1.0"}};
+      auto source = String("{name}@{{version}} {{{name}}} {missing} {{name} {{ name}}");
+
+      t.equals(tmpl(source, variables), "socket@1.0 socket {missing} socket {{ name}}", "replaces variables");
+      t.equals(tmpl(source, variables), legacyTmpl(source, variables), "matches regular expression output");
+      t.equals(tmpl("no variables", variables), "no variables", "plain text is unchanged");
     });
 
     t.test("SSC::trim()", [](auto t) {
-      t.comment("TODO");
+      t.equals(trim(" \t a b \r\n"), "a b", "trims whitespace");
+      t.equals(trim("   "), "", "trims only whitespace");
+    });
+
+    t.test("SSC::trimView()", [](auto t) {
+      const auto source = String(" \t a b \r\n");
+      const auto view = trimView(source);
+
+      t.equals(String(view), "a b", "trims whitespace");
+      t.assert(view.data() == source.data() + 3, "points into the source");
+      t.equals(String(trimView("   ")), "", "trims only whitespace");
+      t.equals(String(trimView("")), "", "trims empty views");
+    });
+
+    t.test("SSC::Tokenizer", [](auto t) {
+      const auto source = String("||a|bc||d|");
+      auto tokenizer = Tokenizer(source, '|');
+      Vector<String> parts;
+      StringView part;
+      bool views = true;
+
+      while (tokenizer.next(part)) {
+        views = views && part.data() >= source.data() && part.data() < source.data() + source.size();
+        parts.emplace_back(part);
+      }
+
+      t.equals(join(parts, ','), "a,bc,d", "yields the non-empty parts");
+      t.assert(views, "parts point into the source");
+      t.assert(!tokenizer.next(part), "stays done");
+      t.assert(!Tokenizer("", '|').next(part), "yields nothing for empty input");
+      t.assert(!Tokenizer("|||", '|').next(part), "yields nothing for only separators");
+      t.equals(join(split(source, '|'), ','), "a,bc,d", "split() yields the same parts");
     });
 
     t.test("SSC::convertStringToWString()", [](auto t) {
@@ -50,5 +125,86 @@ namespace SSC::Tests {
     t.test("SSC::parseStringList()", [](auto t) {
       t.comment("TODO");
     });
+
+    t.test("SSC string primitives benchmark", [](auto t) {
+      static constexpr int iterations = 2000;
+      auto path = String("C:\\Users\\socket\\AppData\\Local\\app\\index.html");
+      auto query = String("name=hello+world+from+socket&value=a+b+c+d+e+f");
+      auto variables = Map {{"name", "socket"}, {"version", "1.0"}, {"platform", "linux"}};
+      auto source = String("{{name}} {{version}} for {{platform}}, see {{name}}.html");
+      size_t size = 0;
+
+      auto regex = measure(iterations, [&]() {
+        size += std::regex_replace(query, std::regex("\\+"), " ").size();
+      });
+
+      auto pattern = measure(iterations, [&]() {
+        size += replace(query, "\\+", " ").size();
+      });
+
+      auto character = measure(iterations, [&]() {
+        size += replace(path, '\\', '/').size();
+      });
+
+      auto text = measure(iterations, [&]() {
+        size += replaceAll(path, "\\", "/").size();
+      });
+
+      auto cached = measure(iterations, [&]() {
+        size += replace(query, "[a-z]+=", "").size();
+      });
+
+      auto legacy = measure(iterations, [&]() {
+        size += legacyTmpl(source, variables).size();
+      });
+
+      auto templated = measure(iterations, [&]() {
+        size += tmpl(source, variables).size();
+      });
+
+      auto splitted = measure(iterations, [&]() {
+        size += split(query, '&').size() + split(path, "\\").size();
+      });
+
+      auto trimmed = measure(iterations, [&]() {
+        size += trim("  \t" + query + "\r\n ").size();
+      });
+
+      auto headers = String("Content-Type: application/json\nContent-Length: 1024\nX-Request-Id: 42\n");
+
+      auto splitHeaders = measure(iterations, [&]() {
+        for (const auto& entry : split(headers, '\n')) {
+          const auto tuple = split(entry, ':');
+          size += trim(tuple.front()).size() + trim(tuple.back()).size();
+        }
+      });
+
+      auto tokenizedHeaders = measure(iterations, [&]() {
+        auto lines = Tokenizer(headers, '\n');
+        StringView entry;
+
+        while (lines.next(entry)) {
+          auto tuple = Tokenizer(entry, ':');
+          StringView key;
+          StringView value;
+          tuple.next(key);
+          tuple.next(value);
+          size += trimView(key).size() + trimView(value).size();
+        }
+      });
+
+      t.assert(size > 0, "strings are transformed");
+      t.comment("replace() with a new regex: " + std::to_string(regex) + " us");
+      t.comment("replace() with a plain text pattern: " + std::to_string(pattern) + " us");
+      t.comment("replace() with a cached regex: " + std::to_string(cached) + " us");
+      t.comment("replace() of a character: " + std::to_string(character) + " us");
+      t.comment("replaceAll(): " + std::to_string(text) + " us");
+      t.comment("tmpl() with regular expressions: " + std::to_string(legacy) + " us");
+      t.comment("tmpl(): " + std::to_string(templated) + " us");
+      t.comment("split(): " + std::to_string(splitted) + " us");
+      t.comment("trim(): " + std::to_string(trimmed) + " us");
+      t.comment("header lines with split() and trim(): " + std::to_string(splitHeaders) + " us");
+      t.comment("header lines with Tokenizer and trimView(): " + std::to_string(tokenizedHeaders) + " us");
+    });
   }
 }
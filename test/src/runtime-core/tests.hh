@@ -68,15 +68,33 @@ namespace SSC::Tests {
       void wait ();
   };
 
+  // comma separated sizes from the environment variable `name`, or `fallback`
+  inline Vector<size_t> getBenchmarkSizes (const String& name, const String& fallback) {
+    Vector<size_t> sizes;
+
+    for (const auto& value : split(Env::get(name, fallback), ',')) {
+      try {
+        sizes.push_back(std::stoull(value));
+      } catch (...) {}
+    }
+
+    return sizes;
+  }
+
   // tests
   void codec (Harness&);
   void config (Harness&);
   void env (Harness&);
+  void fs (Harness&);
+  void headers (Harness&);
   void ini (Harness&);
+  void ipc (Harness&);
   void json (Harness&);
   void platform (Harness&);
   void preload (Harness&);
+  void random (Harness&);
   void string (Harness&);
+  void udp (Harness&);
   void version (Harness&);
 }
 
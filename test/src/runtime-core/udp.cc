@@ -0,0 +1,608 @@
+#include <algorithm>
+#include <chrono>
+
+#include "tests.hh"
+#include "src/ipc/ipc.hh"
+
+namespace SSC::Tests {
+  // the event loop of this core is never started, tests drive it directly
+  static Core* getCore () {
+    static auto core = new Core();
+    return core;
+  }
+
+  static void runEventLoopUntil (std::function<bool()> done, int timeout = 1000) {
+    auto loop = getCore()->getEventLoop();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+    while (!done() && std::chrono::steady_clock::now() < deadline) {
+      uv_run(loop, UV_RUN_NOWAIT);
+    }
+  }
+
+  static void closePeer (Peer* peer) {
+    auto closed = std::make_shared<bool>(false);
+    peer->close([closed]() { *closed = true; });
+    runEventLoopUntil([closed]() { return *closed; });
+  }
+
+  // replies and "-1" events are handled on the calling thread, which also
+  // drives the event loop of the test core
+  static IPC::Bridge* getBridge () {
+    static auto bridge = new IPC::Bridge(getCore());
+    bridge->router.dispatchFunction = [](auto callback) { callback(); };
+    return bridge;
+  }
+
+  struct SegmentBenchmark {
+    int64_t sent = 0;
+    int64_t failed = 0;
+    int64_t datagrams = 0;
+    int64_t received = 0;
+    // seconds from the first send until the last datagram was received
+    double elapsed = 0;
+    std::chrono::steady_clock::time_point start;
+  };
+
+  // sends `count` buffers of `segments` datagrams to a receiving peer over
+  // loopback, with or without UDP segmentation and receive offload
+  static SegmentBenchmark benchmarkSegments (bool offload) {
+    static constexpr size_t segmentSize = 1400;
+    static constexpr size_t segments = 40;
+    static constexpr int count = 2000;
+
+    auto receiver = getCore()->createPeer(PEER_TYPE_UDP, rand64());
+    auto sender = getCore()->createPeer(PEER_TYPE_UDP, rand64());
+    auto result = std::make_shared<SegmentBenchmark>();
+    auto bytes = new char[segmentSize * segments]{0};
+
+    receiver->options.udp.gro = offload;
+    receiver->bind("127.0.0.1", 0);
+    receiver->recvstart([result](auto status, const auto& datagrams) {
+      for (const auto& datagram : datagrams) {
+        result->datagrams++;
+        result->received += datagram.size;
+      }
+
+      auto now = std::chrono::steady_clock::now();
+      result->elapsed = std::chrono::duration<double>(now - result->start).count();
+    });
+
+    if (!offload) {
+      sender->flags = (peer_flag_t) (sender->flags | PEER_FLAG_UDP_GSO_UNSUPPORTED);
+    }
+
+    auto port = receiver->getLocalPeerInfo()->port;
+    result->start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < count; ++i) {
+      sender->send(bytes, segmentSize * segments, port, "127.0.0.1", segmentSize, [result](auto status, auto post) {
+        if (status < 0) {
+          result->failed++;
+        } else {
+          result->sent++;
+        }
+      });
+
+      uv_run(getCore()->getEventLoop(), UV_RUN_NOWAIT);
+    }
+
+    runEventLoopUntil([result]() { return result->sent + result->failed == count; });
+    runEventLoopUntil([result]() { return result->datagrams == count * (int64_t) segments; }, 250);
+
+    closePeer(sender);
+    closePeer(receiver);
+    delete [] bytes;
+
+    return *result;
+  }
+
+  static String formatSegmentBenchmark (const String& label, const SegmentBenchmark& result) {
+    auto gbits = result.elapsed > 0 ? (result.received * 8.0) / result.elapsed / 1e9 : 0;
+    return (
+      label + ": received " + std::to_string(result.datagrams) + " datagrams (" +
+      std::to_string(result.received) + " bytes) in " +
+      std::to_string(result.elapsed * 1000) + " ms (" + std::to_string(gbits) + " Gbit/s)"
+    );
+  }
+
+  struct LoopbackBenchmarkOptions {
+    size_t packetSize = 64;
+    size_t peers = 1;
+    // total number of datagrams, sent round-robin by every peer
+    size_t packets = 10000;
+    // send and receive through the IPC router instead of `Core::UDP`
+    bool bridge = false;
+  };
+
+  struct LoopbackBenchmark {
+    int64_t sent = 0;
+    int64_t failed = 0;
+    int64_t received = 0;
+    int64_t bytes = 0;
+    // seconds from the first send until the last datagram was received
+    double elapsed = 0;
+    // one-way latency of each received datagram in microseconds
+    Vector<double> latencies;
+    std::chrono::steady_clock::time_point start;
+  };
+
+  static int64_t getBenchmarkTimestamp () {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+  }
+
+  // reads the send timestamp at the start of each datagram in a batch post
+  // framed by `udp.readStart`
+  static void readLoopbackBatch (LoopbackBenchmark* result, const char* body, size_t length) {
+    auto now = getBenchmarkTimestamp();
+    auto bytes = (const unsigned char *) body;
+    size_t offset = 0;
+
+    while (body != nullptr && offset + 3 <= length) {
+      offset += 2;
+      offset += 1 + bytes[offset];
+
+      if (offset + 4 > length) {
+        break;
+      }
+
+      size_t size = (
+        ((size_t) bytes[offset] << 24) |
+        ((size_t) bytes[offset + 1] << 16) |
+        ((size_t) bytes[offset + 2] << 8) |
+        ((size_t) bytes[offset + 3])
+      );
+
+      offset += 4;
+
+      if (offset + size > length) {
+        break;
+      }
+
+      if (size >= sizeof(int64_t)) {
+        int64_t timestamp = 0;
+        memcpy(&timestamp, body + offset, sizeof(timestamp));
+        result->latencies.push_back((now - timestamp) / 1000.0);
+      }
+
+      result->received++;
+      result->bytes += size;
+      offset += size;
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - result->start;
+    result->elapsed = std::chrono::duration<double>(elapsed).count();
+  }
+
+  // bridge events are scripts for the webview, the post they refer to
+  // holds the datagrams
+  static void readLoopbackScript (LoopbackBenchmark* result, const String& script) {
+    static const String prefix = "const id = `";
+    auto start = script.find(prefix);
+
+    if (script.find("udp.readStart") == String::npos || start == String::npos) {
+      return;
+    }
+
+    start += prefix.size();
+    auto id = std::stoull(script.substr(start, script.find('`', start) - start));
+    auto core = getCore();
+
+    if (core->hasPost(id)) {
+      auto post = core->getPost(id);
+      readLoopbackBatch(result, post.body, post.length);
+      core->removePost(id);
+    }
+  }
+
+  /**
+   * Sends `packets` datagrams of `packetSize` bytes over loopback from
+   * `peers` senders to as many receivers, each stamped with the time it was
+   * given to `Core::UDP::send()` or the `udp.send` route.
+   */
+  static LoopbackBenchmark benchmarkLoopback (const LoopbackBenchmarkOptions& options) {
+    auto core = getCore();
+    auto loop = core->getEventLoop();
+    auto bridge = options.bridge ? getBridge() : nullptr;
+    auto result = std::make_shared<LoopbackBenchmark>();
+    auto replies = std::make_shared<size_t>(0);
+    auto size = std::max(options.packetSize, sizeof(int64_t));
+    auto bytes = new char[size * options.packets]{0};
+    Vector<uint64_t> receivers;
+    Vector<uint64_t> senders;
+    Vector<int> ports;
+
+    auto onreply = [replies](auto seq, auto json, auto post) {
+      *replies += 1;
+    };
+
+    auto onreceive = [result, replies](auto seq, auto json, auto post) {
+      if (seq != "-1") {
+        *replies += 1;
+      } else if (post.body != nullptr) {
+        readLoopbackBatch(result.get(), post.body, post.length);
+        delete [] post.body;
+      }
+    };
+
+    auto onresult = [replies](auto result) {
+      *replies += 1;
+    };
+
+    if (bridge != nullptr) {
+      bridge->router.evaluateJavaScriptFunction = [result](auto script) {
+        readLoopbackScript(result.get(), script);
+      };
+    }
+
+    for (size_t i = 0; i < options.peers; ++i) {
+      auto receiverId = rand64();
+      auto id = std::to_string(receiverId);
+
+      if (bridge != nullptr) {
+        bridge->router.invoke("ipc://udp.bind?seq=1&id=" + id + "&address=127.0.0.1&port=0", onresult);
+      } else {
+        core->udp.bind("1", receiverId, Core::UDP::BindOptions { "127.0.0.1", 0 }, onreply);
+      }
+
+      receivers.push_back(receiverId);
+      senders.push_back(rand64());
+    }
+
+    runEventLoopUntil([replies, options]() { return *replies == options.peers; });
+
+    // receiving starts on bound peers only
+    for (auto receiverId : receivers) {
+      if (bridge != nullptr) {
+        bridge->router.invoke("ipc://udp.readStart?seq=2&id=" + std::to_string(receiverId), onresult);
+      } else {
+        core->udp.readStart("2", receiverId, onreceive);
+      }
+    }
+
+    runEventLoopUntil([replies, options]() { return *replies == options.peers * 2; });
+
+    for (auto receiverId : receivers) {
+      ports.push_back(core->hasPeer(receiverId) ? core->getPeer(receiverId)->getLocalPeerInfo()->port : 0);
+    }
+
+    result->start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < options.packets; ++i) {
+      auto index = i % options.peers;
+      auto payload = bytes + i * size;
+      auto timestamp = getBenchmarkTimestamp();
+      memcpy(payload, &timestamp, sizeof(timestamp));
+
+      if (bridge != nullptr) {
+        auto uri = (
+          "ipc://udp.send?seq=3&id=" + std::to_string(senders[index]) +
+          "&address=127.0.0.1&port=" + std::to_string(ports[index])
+        );
+
+        bridge->router.invoke(uri, payload, size, [result](auto reply) {
+          // a webview would be given the serialized reply
+          if (reply.str().find("\"err\"") != String::npos) {
+            result->failed++;
+          } else {
+            result->sent++;
+          }
+        });
+      } else {
+        Core::UDP::SendOptions send;
+        send.address = "127.0.0.1";
+        send.port = ports[index];
+        send.bytes = payload;
+        send.size = size;
+
+        core->udp.send("3", senders[index], send, [result](auto seq, auto json, auto post) {
+          if (json.str().find("\"err\"") != String::npos) {
+            result->failed++;
+          } else {
+            result->sent++;
+          }
+        });
+      }
+
+      // let the receivers drain their sockets so loopback drops stay low
+      if (i % 64 == 63) {
+        uv_run(loop, UV_RUN_NOWAIT);
+      }
+    }
+
+    auto packets = (int64_t) options.packets;
+    runEventLoopUntil([result, packets]() { return result->sent + result->failed == packets; }, 5000);
+    runEventLoopUntil([result]() { return result->received == result->sent; }, 250);
+
+    for (auto id : senders) {
+      if (core->hasPeer(id)) {
+        closePeer(core->getPeer(id));
+      }
+    }
+
+    for (auto id : receivers) {
+      if (core->hasPeer(id)) {
+        closePeer(core->getPeer(id));
+      }
+    }
+
+    if (bridge != nullptr) {
+      bridge->router.evaluateJavaScriptFunction = nullptr;
+    }
+
+    delete [] bytes;
+    return *result;
+  }
+
+  static String formatLoopbackBenchmark (
+    const LoopbackBenchmarkOptions& options,
+    LoopbackBenchmark result
+  ) {
+    auto& latencies = result.latencies;
+    auto percentile = [&latencies](double p) {
+      if (latencies.size() == 0) {
+        return 0.0;
+      }
+
+      auto index = std::min(latencies.size() - 1, (size_t) (p * latencies.size()));
+      return latencies[index];
+    };
+
+    std::sort(latencies.begin(), latencies.end());
+
+    auto seconds = result.elapsed > 0 ? result.elapsed : 1;
+    return (
+      String(options.bridge ? "bridge" : "core") + " " +
+      std::to_string(options.packetSize) + " bytes x " +
+      std::to_string(options.peers) + " peers: " +
+      std::to_string((int64_t) (result.received / seconds)) + " packets/s, " +
+      std::to_string(result.bytes / seconds / (1024 * 1024)) + " MB/s, latency p50 " +
+      std::to_string(percentile(0.5)) + " us, p99 " +
+      std::to_string(percentile(0.99)) + " us, p999 " +
+      std::to_string(percentile(0.999)) + " us (" +
+      std::to_string(result.received) + "/" + std::to_string(result.sent) + " received)"
+    );
+  }
+
+  void udp (Harness& t) {
+    t.test("SSC::Peer::getDestinationAddress()", [](auto t) {
+      auto peer = getCore()->createPeer(PEER_TYPE_UDP, rand64());
+      struct sockaddr_storage addr;
+
+      t.equals(peer->getDestinationAddress("127.0.0.1", 3000, &addr), (int64_t) 0, "parses IPv4 destination");
+      t.equals((int64_t) addr.ss_family, (int64_t) AF_INET, "destination is IPv4");
+      t.equals((int64_t) ntohs(((struct sockaddr_in *) &addr)->sin_port), (int64_t) 3000, "destination port is 3000");
+      t.equals(peer->destinations.size(), (size_t) 1, "destination is cached");
+
+      t.equals(peer->getDestinationAddress("127.0.0.1", 3000, &addr), (int64_t) 0, "reads cached destination");
+      t.equals((int64_t) ntohs(((struct sockaddr_in *) &addr)->sin_port), (int64_t) 3000, "cached destination port is 3000");
+      t.equals(peer->destinations.size(), (size_t) 1, "cached destination is reused");
+
+      t.equals(peer->getDestinationAddress("::1", 3000, &addr), (int64_t) 0, "parses IPv6 destination");
+      t.equals((int64_t) addr.ss_family, (int64_t) AF_INET6, "destination is IPv6");
+      t.equals(peer->destinations.size(), (size_t) 2, "destinations are keyed by address and port");
+
+      t.assert(peer->getDestinationAddress("not an address", 3000, &addr) < 0, "invalid destination fails");
+      t.equals(peer->destinations.size(), (size_t) 2, "invalid destination is not cached");
+
+      t.equals(peer->bind("127.0.0.1", 0), (int64_t) 0, "binds to 127.0.0.1");
+      t.equals(peer->destinations.size(), (size_t) 0, "binding resets the cache");
+
+      closePeer(peer);
+    });
+
+    t.test("SSC::Peer::send() small packet throughput", [](auto t) {
+      static constexpr int count = 10000;
+      static constexpr int size = 64;
+
+      auto receiver = getCore()->createPeer(PEER_TYPE_UDP, rand64());
+      auto sender = getCore()->createPeer(PEER_TYPE_UDP, rand64());
+      auto received = std::make_shared<int>(0);
+      auto sent = std::make_shared<int>(0);
+      auto failed = std::make_shared<int>(0);
+      char bytes[size] = {0};
+
+      t.equals(receiver->bind("127.0.0.1", 0), (int64_t) 0, "receiver binds to 127.0.0.1");
+
+      auto port = receiver->getLocalPeerInfo()->port;
+      receiver->recvstart([received](auto status, const auto& datagrams) {
+        if (status > 0) {
+          *received += (int) datagrams.size();
+        }
+      });
+
+      auto start = std::chrono::steady_clock::now();
+
+      for (int i = 0; i < count; ++i) {
+        sender->send(bytes, size, port, "127.0.0.1", [sent, failed](auto status, auto post) {
+          if (status < 0) {
+            *failed += 1;
+          } else {
+            *sent += 1;
+          }
+        });
+
+        // let the receiver drain its socket so loopback drops stay low
+        if (i % 256 == 0) {
+          uv_run(getCore()->getEventLoop(), UV_RUN_NOWAIT);
+        }
+      }
+
+      runEventLoopUntil([sent, failed]() { return *sent + *failed == count; });
+
+      auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      runEventLoopUntil([received]() { return *received == count; }, 250);
+
+      t.equals((int64_t) *sent, (int64_t) count, "every datagram is sent");
+      t.equals((int64_t) *failed, (int64_t) 0, "no datagram fails");
+      t.assert(*received > 0, "datagrams are received");
+      t.equals(sender->destinations.size(), (size_t) 1, "destination is parsed once");
+      t.assert(sender->sendRequests.size() <= Peer::UDP_SEND_REQUEST_POOL_SIZE, "send request pool is bounded");
+
+      t.comment(
+        "sent " + std::to_string(count) + " datagrams of " + std::to_string(size) +
+        " bytes in " + std::to_string(elapsed * 1000) + " ms (" +
+        std::to_string((int64_t) (count / elapsed)) + " datagrams/s, " +
+        std::to_string(*received) + " received)"
+      );
+
+      closePeer(sender);
+      closePeer(receiver);
+    });
+
+    t.test("SSC::Core::UDP::send() high-water mark", [](auto t) {
+      auto core = getCore();
+      auto peerId = rand64();
+      auto peer = core->createPeer(PEER_TYPE_UDP, peerId);
+      auto replies = std::make_shared<Vector<String>>();
+      auto events = std::make_shared<Vector<String>>();
+      char bytes[16] = {0};
+
+      auto cb = [replies, events](auto seq, auto json, auto post) {
+        if (seq == "-1") {
+          events->push_back(json.str());
+        } else {
+          replies->push_back(json.str());
+        }
+      };
+
+      Core::UDP::SendOptions options;
+      options.address = "127.0.0.1";
+      options.port = 41239;
+      options.bytes = bytes;
+      options.size = sizeof(bytes);
+
+      auto countBlocked = [](const Vector<String>& replies) {
+        return (size_t) std::count_if(replies.begin(), replies.end(), [](const auto& reply) {
+          return reply.find("ERR_SOCKET_DGRAM_WOULD_BLOCK") != String::npos;
+        });
+      };
+
+      // sends in one loop iteration are all queued without a high-water mark
+      t.equals(peer->options.udp.sendHighWaterMark, (size_t) 0, "there is no high-water mark by default");
+
+      for (int i = 0; i < 64; ++i) {
+        core->udp.send(std::to_string(i), peerId, options, cb);
+      }
+
+      runEventLoopUntil([replies]() { return replies->size() == 64; });
+
+      t.equals(replies->size(), (size_t) 64, "sends reply");
+      t.equals(countBlocked(*replies), (size_t) 0, "no send would block");
+      t.equals(events->size(), (size_t) 0, "drain is not emitted");
+
+      // every send after the first is above a high-water mark of 1 byte
+      replies->clear();
+      options.highWaterMark = 1;
+
+      for (int i = 0; i < 64; ++i) {
+        core->udp.send(std::to_string(i), peerId, options, cb);
+      }
+
+      runEventLoopUntil([replies, events, peer]() {
+        return (
+          replies->size() == 64 &&
+          events->size() > 0 &&
+          !peer->hasState(PEER_STATE_UDP_SEND_BLOCKED)
+        );
+      });
+
+      auto blocked = countBlocked(*replies);
+      t.equals(replies->size(), (size_t) 64, "sends reply again");
+      t.assert(blocked > 0 && blocked < 64, "sends past the high-water mark would block");
+      t.assert(events->size() > 0 && events->back().find("drain") != String::npos, "drain is emitted");
+      t.assert(!peer->hasState(PEER_STATE_UDP_SEND_BLOCKED), "peer no longer waits for drain");
+
+      closePeer(peer);
+    });
+
+    t.test("SSC::Core::UDP::setOptions()", [](auto t) {
+      auto core = getCore();
+      auto peerId = rand64();
+      auto peer = core->createPeer(PEER_TYPE_UDP, peerId);
+      auto replies = std::make_shared<Vector<String>>();
+
+      auto cb = [replies](auto seq, auto json, auto post) {
+        replies->push_back(json.str());
+      };
+
+      t.equals(peer->bind("127.0.0.1", 0), (int64_t) 0, "binds to 127.0.0.1");
+
+      Core::UDP::SocketOptions options;
+      options.broadcast = 1;
+      options.ttl = 64;
+      options.multicastTTL = 2;
+      options.multicastLoopback = 1;
+      options.dscp = 46;
+      options.sendBufferSize = 64 * 1024;
+      core->udp.setOptions("1", peerId, options, cb);
+      runEventLoopUntil([replies]() { return replies->size() == 1; });
+
+      t.equals(replies->size(), (size_t) 1, "setOptions replies");
+      t.assert(replies->size() == 1 && replies->at(0).find("\"err\"") == String::npos, "options are set");
+      t.assert(replies->size() == 1 && replies->at(0).find("sendBufferSize") != String::npos, "reply has the buffer sizes");
+
+    #if !defined(_WIN32)
+      uv_os_fd_t fd;
+      int tos = 0;
+      socklen_t length = sizeof(tos);
+      uv_fileno((uv_handle_t *) &peer->handle, &fd);
+      getsockopt(fd, IPPROTO_IP, IP_TOS, &tos, &length);
+      t.equals((int64_t) tos, (int64_t) (46 << 2), "datagrams are marked with the code point");
+    #endif
+
+      Core::UDP::SocketOptions invalid;
+      invalid.ttl = 0;
+      core->udp.setOptions("2", peerId, invalid, cb);
+      runEventLoopUntil([replies]() { return replies->size() == 2; });
+
+      t.equals(replies->size(), (size_t) 2, "setOptions replies again");
+      t.assert(replies->size() == 2 && replies->at(1).find("\"option\":\"ttl\"") != String::npos, "invalid ttl is reported");
+
+      closePeer(peer);
+    });
+
+    t.test("SSC::Peer::send() segmentation offload loopback throughput", [](auto t) {
+      auto offload = benchmarkSegments(true);
+      auto fallback = benchmarkSegments(false);
+
+      t.equals(offload.failed, (int64_t) 0, "no segmented send fails with offload");
+      t.equals(fallback.failed, (int64_t) 0, "no segmented send fails without offload");
+      t.assert(offload.datagrams > 0, "segments are received with offload");
+      t.assert(fallback.datagrams > 0, "segments are received without offload");
+      t.equals(offload.received, offload.datagrams * 1400, "coalesced reads are split into segments");
+
+      t.comment(formatSegmentBenchmark("GSO/GRO", offload));
+      t.comment(formatSegmentBenchmark("per datagram", fallback));
+    });
+
+    // configure with `SSC_UDP_BENCHMARK_PACKET_SIZES`, `SSC_UDP_BENCHMARK_PEERS`
+    // and `SSC_UDP_BENCHMARK_PACKETS`
+    t.test("SSC::Core::UDP loopback throughput and latency", [](auto t) {
+      auto sizes = getBenchmarkSizes("SSC_UDP_BENCHMARK_PACKET_SIZES", "64,512,1400");
+      auto peers = getBenchmarkSizes("SSC_UDP_BENCHMARK_PEERS", "1,4");
+      auto packets = getBenchmarkSizes("SSC_UDP_BENCHMARK_PACKETS", "10000");
+
+      for (auto bridge : { false, true }) {
+        for (auto packetSize : sizes) {
+          for (auto count : peers) {
+            LoopbackBenchmarkOptions options;
+            options.packetSize = packetSize;
+            options.peers = std::max(count, (size_t) 1);
+            options.packets = packets.size() > 0 ? packets[0] : options.packets;
+            options.bridge = bridge;
+
+            auto result = benchmarkLoopback(options);
+            auto label = formatLoopbackBenchmark(options, result);
+
+            t.equals(result.failed, (int64_t) 0, "no send fails: " + label);
+            t.assert(result.received > 0, "datagrams are received: " + label);
+            t.comment(label);
+          }
+        }
+      }
+    });
+  }
+}